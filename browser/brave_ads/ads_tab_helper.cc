@@ -6,9 +6,12 @@
 #include "brave/browser/brave_ads/ads_tab_helper.h"
 
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "base/hash/hash.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
 #include "brave/browser/brave_ads/ads_service_factory.h"
 #include "chrome/browser/profiles/profile.h"
 #include "components/dom_distiller/content/browser/distiller_javascript_utils.h"
@@ -28,6 +31,14 @@
 
 namespace brave_ads {
 
+namespace {
+
+// Text classification hashes at most the first MiB of text, so there is no
+// point in copying more than that out of the renderer.
+constexpr int kMaximumTextLength = 1 << 20;
+
+}  // namespace
+
 AdsTabHelper::AdsTabHelper(content::WebContents* web_contents)
     : WebContentsObserver(web_contents),
       tab_id_(sessions::SessionTabHelper::IdForTab(web_contents)),
@@ -66,13 +77,24 @@ void AdsTabHelper::RunIsolatedJavaScript(
     content::RenderFrameHost* render_frame_host) {
   DCHECK(render_frame_host);
 
+  // Serializing the page is expensive for large documents, don't do it for
+  // nothing.
+  if (!ads_service_ || !ads_service_->IsEnabled()) {
+    return;
+  }
+
+  page_content_requests_++;
+
   dom_distiller::RunIsolatedJavaScript(
       render_frame_host, "new XMLSerializer().serializeToString(document)",
       base::BindOnce(&AdsTabHelper::OnJavaScriptHtmlResult,
                      weak_factory_.GetWeakPtr()));
 
+  const std::string text_script =
+      base::StrCat({"document?.body?.innerText?.substring(0, ",
+                    base::NumberToString(kMaximumTextLength), ")"});
   dom_distiller::RunIsolatedJavaScript(
-      render_frame_host, "document?.body?.innerText",
+      render_frame_host, text_script,
       base::BindOnce(&AdsTabHelper::OnJavaScriptTextResult,
                      weak_factory_.GetWeakPtr()));
 }
@@ -52,6 +52,11 @@ class AdsTabHelper : public content::WebContentsObserver,
   AdsTabHelper(const AdsTabHelper&) = delete;
   AdsTabHelper& operator=(const AdsTabHelper&) = delete;
 
+  // Number of times the page HTML and text were requested from the renderer.
+  int page_content_requests_for_testing() const {
+    return page_content_requests_;
+  }
+
  private:
   friend class content::WebContentsUserData<AdsTabHelper>;
 
@@ -93,6 +98,7 @@ class AdsTabHelper : public content::WebContentsObserver,
   bool should_process_ = false;
   uint32_t html_hash_ = 0;
   uint32_t text_hash_ = 0;
+  int page_content_requests_ = 0;
 
   base::WeakPtrFactory<AdsTabHelper> weak_factory_;
   WEB_CONTENTS_USER_DATA_KEY_DECL();
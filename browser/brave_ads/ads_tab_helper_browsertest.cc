@@ -0,0 +1,69 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/brave_ads/ads_tab_helper.h"
+
+#include "base/path_service.h"
+#include "bat/ads/pref_names.h"
+#include "brave/common/brave_paths.h"
+#include "chrome/browser/profiles/profile.h"
+#include "chrome/browser/ui/browser.h"
+#include "chrome/browser/ui/tabs/tab_strip_model.h"
+#include "chrome/test/base/in_process_browser_test.h"
+#include "chrome/test/base/ui_test_utils.h"
+#include "components/prefs/pref_service.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/test/browser_test.h"
+#include "content/public/test/browser_test_utils.h"
+#include "net/dns/mock_host_resolver.h"
+
+// npm run test -- brave_browser_tests --filter=AdsTabHelperTest*
+
+class AdsTabHelperTest : public InProcessBrowserTest {
+ public:
+  AdsTabHelperTest() = default;
+
+  void SetUpOnMainThread() override {
+    InProcessBrowserTest::SetUpOnMainThread();
+    host_resolver()->AddRule("*", "127.0.0.1");
+
+    brave::RegisterPathProvider();
+    base::FilePath test_data_dir;
+    base::PathService::Get(brave::DIR_TEST_DATA, &test_data_dir);
+    embedded_test_server()->ServeFilesFromDirectory(test_data_dir);
+    ASSERT_TRUE(embedded_test_server()->Start());
+  }
+
+  // Navigates to a page and returns the number of times its content was
+  // requested from the renderer.
+  int NavigateAndGetPageContentRequests() {
+    const GURL url = embedded_test_server()->GetURL("a.com", "/simple.html");
+    EXPECT_TRUE(ui_test_utils::NavigateToURL(browser(), url));
+    content::WebContents* contents =
+        browser()->tab_strip_model()->GetActiveWebContents();
+    EXPECT_TRUE(content::WaitForLoadStop(contents));
+
+    brave_ads::AdsTabHelper* ads_tab_helper =
+        brave_ads::AdsTabHelper::FromWebContents(contents);
+    EXPECT_TRUE(ads_tab_helper);
+    return ads_tab_helper ? ads_tab_helper->page_content_requests_for_testing()
+                          : 0;
+  }
+
+  PrefService* GetPrefs() { return browser()->profile()->GetPrefs(); }
+};
+
+IN_PROC_BROWSER_TEST_F(AdsTabHelperTest,
+                       DoNotRequestPageContentIfAdsAreDisabled) {
+  GetPrefs()->SetBoolean(ads::prefs::kEnabled, false);
+
+  EXPECT_EQ(NavigateAndGetPageContentRequests(), 0);
+}
+
+IN_PROC_BROWSER_TEST_F(AdsTabHelperTest, RequestPageContentIfAdsAreEnabled) {
+  GetPrefs()->SetBoolean(ads::prefs::kEnabled, true);
+
+  EXPECT_EQ(NavigateAndGetPageContentRequests(), 1);
+}
@@ -76,3 +76,14 @@ void BraveBrowserMainExtraParts::PreMainMessageLoopRun() {
   brave::BraveUptimeTracker::CreateInstance(g_browser_process->local_state());
 #endif  // !defined(OS_ANDROID)
 }
+
+void BraveBrowserMainExtraParts::PostMainMessageLoopRun() {
+  // Local state is committed to disk right after this.
+#if BUILDFLAG(BRAVE_P3A_ENABLED)
+  g_brave_browser_process->brave_p3a_service()->PersistLogs();
+#endif  // BUILDFLAG(BRAVE_P3A_ENABLED)
+
+#if !defined(OS_ANDROID)
+  brave::BraveUptimeTracker::FlushInstance();
+#endif  // !defined(OS_ANDROID)
+}
@@ -66,9 +66,9 @@ KeyedService* BraveNewsControllerFactory::BuildServiceInstanceFor(
   auto* ads_service = brave_ads::AdsServiceFactory::GetForProfile(profile);
   auto* history_service = HistoryServiceFactory::GetForProfile(
       profile, ServiceAccessType::EXPLICIT_ACCESS);
-  return new BraveNewsController(profile->GetPrefs(), ads_service,
-                                 history_service,
-                                 profile->GetURLLoaderFactory());
+  return new BraveNewsController(
+      profile->GetPrefs(), ads_service, history_service,
+      profile->GetURLLoaderFactory(), profile->GetPath());
 }
 
 content::BrowserContext* BraveNewsControllerFactory::GetBrowserContextToUse(
@@ -0,0 +1,220 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/path_service.h"
+#include "base/run_loop.h"
+#include "base/synchronization/lock.h"
+#include "base/test/scoped_feature_list.h"
+#include "base/values.h"
+#include "brave/browser/brave_wallet/rpc_controller_factory.h"
+#include "brave/common/brave_paths.h"
+#include "brave/components/brave_wallet/browser/eth_json_rpc_controller.h"
+#include "brave/components/brave_wallet/common/features.h"
+#include "chrome/browser/profiles/profile.h"
+#include "chrome/browser/ui/browser.h"
+#include "chrome/browser/ui/tabs/tab_strip_model.h"
+#include "chrome/test/base/in_process_browser_test.h"
+#include "chrome/test/base/ui_test_utils.h"
+#include "components/network_session_configurator/common/network_switches.h"
+#include "content/public/test/browser_test.h"
+#include "content/public/test/browser_test_utils.h"
+#include "net/dns/mock_host_resolver.h"
+#include "net/test/embedded_test_server/embedded_test_server.h"
+#include "net/test/embedded_test_server/http_request.h"
+#include "net/test/embedded_test_server/http_response.h"
+
+namespace {
+
+const char kEmbeddedTestServerDirectory[] = "brave-wallet";
+
+// Two read-only requests made in the same task, which the renderer sends to
+// the browser together. Both use id 7 to check that the page's ids are
+// restored on the responses.
+const char kScriptSendReadOnlyRequests[] = R"(
+    function sendAsync(method, params) {
+      return new Promise((resolve, reject) => {
+        window.ethereum.sendAsync(
+            {jsonrpc: '2.0', id: 7, method: method, params: params},
+            (error, response) => {
+              if (error)
+                reject(error);
+              else
+                resolve(response.id + ':' + response.result);
+            });
+      });
+    }
+    function waitForProvider() {
+      if (!window.ethereum)
+        return;
+      clearInterval(timer);
+      Promise.all([
+        sendAsync('eth_blockNumber', []),
+        sendAsync('eth_getBalance',
+                  ['0x084DCb94038af1715963F149079cE011C4B22961', 'latest']),
+      ]).then(results => {
+        window.domAutomationController.send(results.join(','));
+      }).catch(error => {
+        window.domAutomationController.send('error');
+      });
+    }
+    var timer = setInterval(waitForProvider, 100);)";
+
+std::string GetResultForMethod(const std::string& method) {
+  if (method == "eth_blockNumber")
+    return "0x10";
+  if (method == "eth_getBalance")
+    return "0x20";
+  return "0x0";
+}
+
+base::Value GetResponseForRequest(const base::Value& request) {
+  base::Value response(base::Value::Type::DICTIONARY);
+  response.SetStringKey("jsonrpc", "2.0");
+  const base::Value* id = request.FindKey("id");
+  response.SetKey("id", id ? id->Clone() : base::Value());
+  const std::string* method = request.FindStringKey("method");
+  response.SetStringKey("result", GetResultForMethod(method ? *method : ""));
+  return response;
+}
+
+}  // namespace
+
+class BraveWalletProviderTest : public InProcessBrowserTest {
+ public:
+  BraveWalletProviderTest() {
+    feature_list_.InitAndEnableFeature(
+        brave_wallet::features::kNativeBraveWalletFeature);
+  }
+
+  void SetUpOnMainThread() override {
+    InProcessBrowserTest::SetUpOnMainThread();
+    host_resolver()->AddRule("*", "127.0.0.1");
+
+    brave::RegisterPathProvider();
+    base::FilePath test_data_dir;
+    base::PathService::Get(brave::DIR_TEST_DATA, &test_data_dir);
+    test_data_dir = test_data_dir.AppendASCII(kEmbeddedTestServerDirectory);
+    https_server_for_files_.SetSSLConfig(net::EmbeddedTestServer::CERT_OK);
+    https_server_for_files_.ServeFilesFromDirectory(test_data_dir);
+    ASSERT_TRUE(https_server_for_files_.Start());
+
+    https_server_for_rpc_.SetSSLConfig(net::EmbeddedTestServer::CERT_OK);
+    https_server_for_rpc_.RegisterRequestHandler(base::BindRepeating(
+        &BraveWalletProviderTest::HandleRequest, base::Unretained(this)));
+    ASSERT_TRUE(https_server_for_rpc_.Start());
+    brave_wallet::RpcControllerFactory::GetControllerForContext(
+        browser()->profile())
+        ->SetCustomNetworkForTesting("0x539", https_server_for_rpc_.base_url());
+    base::RunLoop().RunUntilIdle();
+  }
+
+  void SetUpCommandLine(base::CommandLine* command_line) override {
+    // HTTPS server only serves a valid cert for localhost, so this is needed
+    // to load pages from other hosts without an error.
+    command_line->AppendSwitch(switches::kIgnoreCertificateErrors);
+  }
+
+  // Answers single requests, and batches unless set_batch_supported(false)
+  // was called.
+  std::unique_ptr<net::test_server::HttpResponse> HandleRequest(
+      const net::test_server::HttpRequest& request) {
+    absl::optional<base::Value> payload =
+        base::JSONReader::Read(request.content);
+    if (!payload)
+      return nullptr;
+
+    base::Value response;
+    if (payload->is_list()) {
+      base::AutoLock lock(lock_);
+      batch_sizes_.push_back(payload->GetList().size());
+      const auto method_header = request.headers.find("X-Eth-Method");
+      batch_methods_.push_back(method_header != request.headers.end()
+                                   ? method_header->second
+                                   : std::string());
+      if (batch_supported_) {
+        response = base::Value(base::Value::Type::LIST);
+        for (const auto& item : payload->GetList())
+          response.Append(GetResponseForRequest(item));
+      } else {
+        response = base::Value(base::Value::Type::DICTIONARY);
+        response.SetStringKey("jsonrpc", "2.0");
+        response.SetKey("id", base::Value());
+        base::Value error(base::Value::Type::DICTIONARY);
+        error.SetIntKey("code", -32600);
+        error.SetStringKey("message", "Batch requests are not supported");
+        response.SetKey("error", std::move(error));
+      }
+    } else {
+      response = GetResponseForRequest(*payload);
+    }
+
+    std::string content;
+    base::JSONWriter::Write(response, &content);
+    auto http_response =
+        std::make_unique<net::test_server::BasicHttpResponse>();
+    http_response->set_code(net::HTTP_OK);
+    http_response->set_content_type("application/json");
+    http_response->set_content(content);
+    return http_response;
+  }
+
+  std::string SendReadOnlyRequests() {
+    GURL url = https_server_for_files_.GetURL(
+        "a.com", "/brave_wallet_event_emitter.html");
+    EXPECT_TRUE(ui_test_utils::NavigateToURL(browser(), url));
+    content::WebContents* contents =
+        browser()->tab_strip_model()->GetActiveWebContents();
+    EXPECT_TRUE(WaitForLoadStop(contents));
+    return EvalJs(contents, kScriptSendReadOnlyRequests,
+                  content::EXECUTE_SCRIPT_USE_MANUAL_REPLY)
+        .ExtractString();
+  }
+
+  std::vector<size_t> batch_sizes() {
+    base::AutoLock lock(lock_);
+    return batch_sizes_;
+  }
+
+  std::vector<std::string> batch_methods() {
+    base::AutoLock lock(lock_);
+    return batch_methods_;
+  }
+
+  void set_batch_supported(bool batch_supported) {
+    base::AutoLock lock(lock_);
+    batch_supported_ = batch_supported;
+  }
+
+ private:
+  base::Lock lock_;
+  std::vector<size_t> batch_sizes_;
+  std::vector<std::string> batch_methods_;
+  bool batch_supported_ = true;
+  net::EmbeddedTestServer https_server_for_files_{
+      net::test_server::EmbeddedTestServer::TYPE_HTTPS};
+  net::EmbeddedTestServer https_server_for_rpc_{
+      net::test_server::EmbeddedTestServer::TYPE_HTTPS};
+  base::test::ScopedFeatureList feature_list_;
+};
+
+IN_PROC_BROWSER_TEST_F(BraveWalletProviderTest, PipelinesReadOnlyRequests) {
+  EXPECT_EQ(SendReadOnlyRequests(), "7:0x10,7:0x20");
+  EXPECT_EQ(batch_sizes(), std::vector<size_t>({2}));
+  // Like for single requests, the endpoint is told which method is called.
+  EXPECT_EQ(batch_methods(), std::vector<std::string>({"eth_blockNumber"}));
+}
+
+IN_PROC_BROWSER_TEST_F(BraveWalletProviderTest, FallsBackWithoutBatchSupport) {
+  set_batch_supported(false);
+  EXPECT_EQ(SendReadOnlyRequests(), "7:0x10,7:0x20");
+  EXPECT_EQ(batch_sizes(), std::vector<size_t>({2}));
+}
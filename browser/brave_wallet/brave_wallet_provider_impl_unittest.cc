@@ -261,6 +261,9 @@ class BraveWalletProviderImplUnitTest : public testing::Test {
   }
   KeyringController* keyring_controller() { return keyring_controller_; }
   BraveWalletProviderImpl* provider() { return provider_.get(); }
+  network::TestURLLoaderFactory* url_loader_factory() {
+    return &url_loader_factory_;
+  }
   std::string from(size_t from_index = 0) {
     return keyring_controller()->default_keyring_->GetAddress(from_index);
   }
@@ -541,6 +544,54 @@ TEST_F(BraveWalletProviderImplUnitTest, EmptyDelegate) {
                     ProviderErrors::kInternalError);
 }
 
+TEST_F(BraveWalletProviderImplUnitTest, RequestBatch) {
+  // Responses come back out of order with the browser assigned ids.
+  size_t requests = 0;
+  url_loader_factory()->SetInterceptor(base::BindLambdaForTesting(
+      [&](const network::ResourceRequest& request) {
+        ++requests;
+        url_loader_factory()->ClearResponses();
+        url_loader_factory()->AddResponse(
+            request.url.spec(),
+            R"([{"jsonrpc":"2.0","id":1,"result":"0x2"},)"
+            R"({"jsonrpc":"2.0","id":0,"result":"0x1"}])");
+      }));
+
+  std::vector<mojom::ProviderResponsePtr> responses;
+  provider()->RequestBatch(
+      {R"({"id":"a","jsonrpc":"2.0","method":"eth_blockNumber","params":[]})",
+       R"({"id":7,"jsonrpc":"2.0","method":"eth_chainId","params":[]})"},
+      base::BindLambdaForTesting(
+          [&](std::vector<mojom::ProviderResponsePtr> result) {
+            responses = std::move(result);
+          }));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(requests, 1u);
+  ASSERT_EQ(responses.size(), 2u);
+  EXPECT_EQ(responses[0]->http_code, 200);
+  EXPECT_EQ(responses[0]->response,
+            R"({"id":"a","jsonrpc":"2.0","result":"0x1"})");
+  EXPECT_EQ(responses[1]->response,
+            R"({"id":7,"jsonrpc":"2.0","result":"0x2"})");
+
+  // Endpoints without batch support get the requests one by one.
+  SetInterceptor(R"({"jsonrpc":"2.0","id":"a","result":"0x1"})");
+  responses.clear();
+  provider()->RequestBatch(
+      {R"({"id":"a","jsonrpc":"2.0","method":"eth_blockNumber","params":[]})",
+       R"({"id":"a","jsonrpc":"2.0","method":"eth_blockNumber","params":[]})"},
+      base::BindLambdaForTesting(
+          [&](std::vector<mojom::ProviderResponsePtr> result) {
+            responses = std::move(result);
+          }));
+  base::RunLoop().RunUntilIdle();
+  ASSERT_EQ(responses.size(), 2u);
+  EXPECT_EQ(responses[0]->response,
+            R"({"jsonrpc":"2.0","id":"a","result":"0x1"})");
+  EXPECT_EQ(responses[1]->response,
+            R"({"jsonrpc":"2.0","id":"a","result":"0x1"})");
+}
+
 TEST_F(BraveWalletProviderImplUnitTest, OnAddEthereumChain) {
   GURL url("https://brave.com");
   Navigate(url);
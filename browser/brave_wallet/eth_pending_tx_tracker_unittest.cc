@@ -169,32 +169,40 @@ TEST_F(EthPendingTxTrackerUnitTest, UpdatePendingTransactions) {
   meta.status = mojom::TransactionStatus::Submitted;
   tx_state_manager.AddOrUpdateTx(meta);
 
+  // 001 and 004 are checked with a single batch request, 003 is dropped
+  // because its nonce is taken.
+  size_t requests = 0;
+  const std::string receipt_result =
+      "{\"transactionHash\":"
+      "\"0xb903239f8543d04b5dc1ba6579132b143087c68db1b2168786408fcbce5682"
+      "38\","
+      "\"transactionIndex\":  \"0x1\","
+      "\"blockNumber\": \"0xb\","
+      "\"blockHash\": "
+      "\"0xc6ef2fc5426d6ad6fd9e2a26abeab0aa2411b7ab17f30a99d3cb96aed1d105"
+      "5b\","
+      "\"cumulativeGasUsed\": \"0x33bc\","
+      "\"gasUsed\": \"0x4dc\","
+      "\"contractAddress\": "
+      "\"0xb60e8dd61c5d32be8058bb8eb970870f07233155\","
+      "\"logs\": [],"
+      "\"logsBloom\": \"0x00...0\","
+      "\"status\": \"0x1\"}";
   test_url_loader_factory()->SetInterceptor(
       base::BindLambdaForTesting([&](const network::ResourceRequest& request) {
+        ++requests;
         test_url_loader_factory()->AddResponse(
             request.url.spec(),
-            "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":{"
-            "\"transactionHash\":"
-            "\"0xb903239f8543d04b5dc1ba6579132b143087c68db1b2168786408fcbce5682"
-            "38\","
-            "\"transactionIndex\":  \"0x1\","
-            "\"blockNumber\": \"0xb\","
-            "\"blockHash\": "
-            "\"0xc6ef2fc5426d6ad6fd9e2a26abeab0aa2411b7ab17f30a99d3cb96aed1d105"
-            "5b\","
-            "\"cumulativeGasUsed\": \"0x33bc\","
-            "\"gasUsed\": \"0x4dc\","
-            "\"contractAddress\": "
-            "\"0xb60e8dd61c5d32be8058bb8eb970870f07233155\","
-            "\"logs\": [],"
-            "\"logsBloom\": \"0x00...0\","
-            "\"status\": \"0x1\"}}");
+            "[{\"jsonrpc\":\"2.0\",\"id\":0,\"result\":" + receipt_result +
+                "},{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":" +
+                receipt_result + "}]");
       }));
 
   size_t num_pending;
   EXPECT_TRUE(pending_tx_tracker.UpdatePendingTransactions(&num_pending));
   EXPECT_EQ(3UL, num_pending);
   WaitForResponse();
+  EXPECT_EQ(requests, 1u);
   auto meta_from_state = tx_state_manager.GetTx("001");
   ASSERT_NE(meta_from_state, nullptr);
   EXPECT_EQ(meta_from_state->status, mojom::TransactionStatus::Confirmed);
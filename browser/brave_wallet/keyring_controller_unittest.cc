@@ -618,7 +618,7 @@ TEST_F(KeyringControllerUnitTest, UnlockResumesDefaultKeyring) {
     controller.Unlock(
         "brave", base::BindOnce(&KeyringControllerUnitTest::GetBooleanCallback,
                                 base::Unretained(this)));
-    base::RunLoop().RunUntilIdle();
+    task_environment_.RunUntilIdle();
     ASSERT_EQ(true, bool_value());
     ASSERT_FALSE(controller.IsLocked());
 
@@ -635,15 +635,122 @@ TEST_F(KeyringControllerUnitTest, UnlockResumesDefaultKeyring) {
         "brave123",
         base::BindOnce(&KeyringControllerUnitTest::GetBooleanCallback,
                        base::Unretained(this)));
+    task_environment_.RunUntilIdle();
     ASSERT_TRUE(controller.IsLocked());
     // empty password
     controller.Unlock(
         "", base::BindOnce(&KeyringControllerUnitTest::GetBooleanCallback,
                            base::Unretained(this)));
+    task_environment_.RunUntilIdle();
     ASSERT_TRUE(controller.IsLocked());
   }
 }
 
+TEST_F(KeyringControllerUnitTest, UnlockCoalescing) {
+  KeyringController controller(GetPrefs());
+  controller.CreateWallet("brave", base::DoNothing());
+  base::RunLoop().RunUntilIdle();
+  controller.Lock();
+  ASSERT_TRUE(controller.IsLocked());
+
+  // Attempts with the same password share one derivation
+  int succeeded = 0;
+  auto count_success = base::BindLambdaForTesting([&](bool success) {
+    EXPECT_TRUE(success);
+    ++succeeded;
+  });
+  controller.Unlock("brave", count_success);
+  controller.Unlock("brave", count_success);
+  EXPECT_TRUE(controller.pending_unlock_);
+  EXPECT_EQ(controller.pending_unlock_->callbacks.size(), 2u);
+  EXPECT_TRUE(controller.IsLocked());
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(succeeded, 2);
+  EXPECT_FALSE(controller.pending_unlock_);
+  EXPECT_FALSE(controller.IsLocked());
+
+  // Already unlocked with the same password, encryptor is reused
+  bool callback_called = false;
+  controller.Unlock("brave", base::BindLambdaForTesting([&](bool success) {
+                      EXPECT_TRUE(success);
+                      callback_called = true;
+                    }));
+  EXPECT_TRUE(callback_called);
+  EXPECT_FALSE(controller.pending_unlock_);
+
+  // A different password cancels the attempt in flight
+  controller.Lock();
+  bool cancelled_result = true;
+  bool unlock_result = false;
+  controller.Unlock("wrong", base::BindLambdaForTesting([&](bool success) {
+                      cancelled_result = success;
+                    }));
+  controller.Unlock("brave", base::BindLambdaForTesting([&](bool success) {
+                      unlock_result = success;
+                    }));
+  EXPECT_FALSE(cancelled_result);
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(unlock_result);
+  EXPECT_FALSE(controller.IsLocked());
+
+  // Lock cancels the attempt in flight
+  controller.Lock();
+  unlock_result = true;
+  controller.Unlock("brave", base::BindLambdaForTesting([&](bool success) {
+                      unlock_result = success;
+                    }));
+  controller.Lock();
+  EXPECT_FALSE(unlock_result);
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(unlock_result);
+  EXPECT_TRUE(controller.IsLocked());
+}
+
+TEST_F(KeyringControllerUnitTest, CreateOrRestoreCancelsPendingUnlock) {
+  KeyringController controller(GetPrefs());
+  controller.CreateWallet("brave", base::DoNothing());
+  base::RunLoop().RunUntilIdle();
+
+  // Restoring replaces the encryptor the unlock in flight would install
+  controller.Lock();
+  bool unlock_result = true;
+  controller.Unlock("brave", base::BindLambdaForTesting([&](bool success) {
+                      unlock_result = success;
+                    }));
+  EXPECT_TRUE(controller.pending_unlock_);
+  bool restored = false;
+  controller.RestoreWallet(kMnemonic1, "brave1", false,
+                           base::BindLambdaForTesting(
+                               [&](bool success) { restored = success; }));
+  EXPECT_TRUE(restored);
+  EXPECT_FALSE(unlock_result);
+  EXPECT_FALSE(controller.pending_unlock_);
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(unlock_result);
+  EXPECT_FALSE(controller.IsLocked());
+  EXPECT_EQ(controller.GetMnemonicForDefaultKeyringImpl(), kMnemonic1);
+
+  // Same for creating a new wallet
+  controller.Lock();
+  unlock_result = true;
+  controller.Unlock("brave1", base::BindLambdaForTesting([&](bool success) {
+                      unlock_result = success;
+                    }));
+  std::string mnemonic;
+  controller.CreateWallet("brave2",
+                          base::BindLambdaForTesting(
+                              [&](const std::string& result) {
+                                mnemonic = result;
+                              }));
+  EXPECT_FALSE(unlock_result);
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(unlock_result);
+  EXPECT_FALSE(controller.IsLocked());
+  EXPECT_FALSE(mnemonic.empty());
+  EXPECT_NE(mnemonic, kMnemonic1);
+  EXPECT_EQ(controller.GetMnemonicForDefaultKeyringImpl(), mnemonic);
+}
+
 TEST_F(KeyringControllerUnitTest, GetMnemonicForDefaultKeyring) {
   KeyringController controller(GetPrefs());
   ASSERT_TRUE(controller.CreateEncryptorForKeyring("brave", "default"));
@@ -672,6 +779,7 @@ TEST_F(KeyringControllerUnitTest, GetMnemonicForDefaultKeyring) {
   controller.Unlock(
       "brave123", base::BindOnce(&KeyringControllerUnitTest::GetBooleanCallback,
                                  base::Unretained(this)));
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(controller.IsLocked());
   controller.GetMnemonicForDefaultKeyring(base::BindOnce(
       &KeyringControllerUnitTest::GetStringCallback, base::Unretained(this)));
@@ -681,6 +789,7 @@ TEST_F(KeyringControllerUnitTest, GetMnemonicForDefaultKeyring) {
   controller.Unlock(
       "brave", base::BindOnce(&KeyringControllerUnitTest::GetBooleanCallback,
                               base::Unretained(this)));
+  task_environment_.RunUntilIdle();
   EXPECT_FALSE(controller.IsLocked());
   controller.GetMnemonicForDefaultKeyring(base::BindOnce(
       &KeyringControllerUnitTest::GetStringCallback, base::Unretained(this)));
@@ -765,11 +874,13 @@ TEST_F(KeyringControllerUnitTest, LockAndUnlock) {
     controller.Unlock(
         "abc", base::BindOnce(&KeyringControllerUnitTest::GetBooleanCallback,
                               base::Unretained(this)));
+    task_environment_.RunUntilIdle();
     EXPECT_TRUE(controller.IsLocked());
 
     controller.Unlock(
         "brave", base::BindOnce(&KeyringControllerUnitTest::GetBooleanCallback,
                                 base::Unretained(this)));
+    task_environment_.RunUntilIdle();
     EXPECT_FALSE(controller.IsLocked());
     controller.default_keyring_->AddAccounts(1);
 
@@ -781,6 +892,7 @@ TEST_F(KeyringControllerUnitTest, LockAndUnlock) {
     controller.Unlock(
         "brave", base::BindOnce(&KeyringControllerUnitTest::GetBooleanCallback,
                                 base::Unretained(this)));
+    task_environment_.RunUntilIdle();
     EXPECT_FALSE(controller.IsLocked());
     controller.default_keyring_->AddAccounts(1);
   }
@@ -1148,7 +1260,7 @@ TEST_F(KeyringControllerUnitTest, ImportedAccounts) {
   EXPECT_TRUE(callback_called);
 
   controller.Unlock("brave", base::DoNothing());
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
 
   callback_called = false;
   // Imported accounts should be restored
@@ -1247,7 +1359,7 @@ TEST_F(KeyringControllerUnitTest, ImportedAccountFromJson) {
         EXPECT_TRUE(address.empty());
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   callback_called = false;
@@ -1258,7 +1370,7 @@ TEST_F(KeyringControllerUnitTest, ImportedAccountFromJson) {
         EXPECT_TRUE(address.empty());
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   callback_called = false;
@@ -1269,12 +1381,12 @@ TEST_F(KeyringControllerUnitTest, ImportedAccountFromJson) {
         EXPECT_EQ(address, expected_address);
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   controller.Lock();
   controller.Unlock("brave", base::DoNothing());
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
 
   // check restore by getting private key
   callback_called = false;
@@ -1600,8 +1712,8 @@ TEST_F(KeyringControllerUnitTest, RestoreLegacyBraveWallet) {
       "crew where";
   KeyringController controller(GetPrefs());
   auto verify_restore_wallet = base::BindLambdaForTesting(
-      [&controller](const char* mnemonic, const char* address, bool is_legacy,
-                    bool expect_result) {
+      [this, &controller](const char* mnemonic, const char* address,
+                          bool is_legacy, bool expect_result) {
         bool callback_called = false;
         controller.RestoreWallet(mnemonic, "brave1", is_legacy,
                                  base::BindLambdaForTesting([&](bool success) {
@@ -1621,7 +1733,7 @@ TEST_F(KeyringControllerUnitTest, RestoreLegacyBraveWallet) {
           // legacy_brave_wallet pref so it will use the right seed
           controller.Lock();
           controller.Unlock("brave1", base::DoNothing());
-          base::RunLoop().RunUntilIdle();
+          task_environment_.RunUntilIdle();
           account_infos.clear();
           account_infos = controller.GetAccountInfosForKeyring("default");
           ASSERT_EQ(account_infos.size(), 1u);
@@ -1770,7 +1882,7 @@ TEST_F(KeyringControllerUnitTest, AutoLock) {
   controller.Unlock(
       "brave", base::BindOnce(&KeyringControllerUnitTest::GetBooleanCallback,
                               base::Unretained(this)));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   ASSERT_FALSE(controller.IsLocked());
   task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(5));
   ASSERT_TRUE(controller.IsLocked());
@@ -1780,7 +1892,7 @@ TEST_F(KeyringControllerUnitTest, AutoLock) {
   controller.Unlock(
       "brave", base::BindOnce(&KeyringControllerUnitTest::GetBooleanCallback,
                               base::Unretained(this)));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   ASSERT_FALSE(controller.IsLocked());
   task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(1));
   controller.Lock();
@@ -1799,6 +1911,7 @@ TEST_F(KeyringControllerUnitTest, AutoLock) {
   controller.Unlock(
       "brave", base::BindOnce(&KeyringControllerUnitTest::GetBooleanCallback,
                               base::Unretained(this)));
+  task_environment_.RunUntilIdle();
   ASSERT_FALSE(controller.IsLocked());
   task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(4));
   GetPrefs()->SetInteger(kBraveWalletAutoLockMinutes, 3);
@@ -1812,6 +1925,7 @@ TEST_F(KeyringControllerUnitTest, AutoLock) {
   controller.Unlock(
       "brave", base::BindOnce(&KeyringControllerUnitTest::GetBooleanCallback,
                               base::Unretained(this)));
+  task_environment_.RunUntilIdle();
   ASSERT_FALSE(controller.IsLocked());
   task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(2));
   EXPECT_FALSE(controller.IsLocked());
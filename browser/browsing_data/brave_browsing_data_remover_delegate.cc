@@ -9,6 +9,8 @@
 #include <utility>
 
 #include "brave/browser/brave_news/brave_news_controller_factory.h"
+#include "brave/browser/brave_wallet/rpc_controller_factory.h"
+#include "brave/components/brave_wallet/browser/eth_json_rpc_controller.h"
 #include "brave/components/brave_today/browser/brave_news_controller.h"
 #include "brave/components/brave_today/common/features.h"
 #include "brave/components/content_settings/core/browser/brave_content_settings_pref_provider.h"
@@ -29,6 +31,7 @@
 #include "base/threading/thread_restrictions.h"
 #include "base/time/time.h"
 #include "brave/browser/ipfs/ipfs_service_factory.h"
+#include "brave/browser/net/ipfs_redirect_network_delegate_helper.h"
 #include "brave/components/ipfs/ipfs_service.h"
 #endif
 
@@ -64,7 +67,21 @@ void BraveBrowsingDataRemoverDelegate::RemoveEmbedderData(
 #if BUILDFLAG(ENABLE_IPFS)
   if (remove_mask & content::BrowsingDataRemover::DATA_TYPE_CACHE)
     ClearIPFSCache();
+  // The known content paths are a record of visited URLs as well.
+  if (remove_mask & (content::BrowsingDataRemover::DATA_TYPE_CACHE |
+                     chrome_browsing_data_remover::DATA_TYPE_HISTORY))
+    ipfs::ClearContentPathCache(profile_);
 #endif
+  // The decentralized domains resolved by the wallet tell which sites were
+  // visited too.
+  if (remove_mask & (content::BrowsingDataRemover::DATA_TYPE_CACHE |
+                     chrome_browsing_data_remover::DATA_TYPE_HISTORY)) {
+    if (auto* rpc_controller =
+            brave_wallet::RpcControllerFactory::GetControllerForContext(
+                profile_)) {
+      rpc_controller->ClearDomainResolutionCache();
+    }
+  }
   if (base::FeatureList::IsEnabled(brave_today::features::kBraveNewsFeature)) {
     // Brave News feed cache
     if (remove_mask & chrome_browsing_data_remover::DATA_TYPE_HISTORY) {
@@ -3,6 +3,12 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/callback_helpers.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/macros.h"
@@ -11,7 +17,10 @@
 #include "base/single_thread_task_runner.h"
 #include "base/task/post_task.h"
 #include "base/test/scoped_feature_list.h"
+#include "brave/browser/brave_wallet/rpc_controller_factory.h"
 #include "brave/browser/browsing_data/brave_clear_browsing_data.h"
+#include "brave/components/brave_wallet/browser/domain_resolution_cache.h"
+#include "brave/components/brave_wallet/browser/eth_json_rpc_controller.h"
 #include "chrome/app/chrome_command_ids.h"
 #include "chrome/browser/browsing_data/chrome_browsing_data_remover_constants.h"
 #include "chrome/browser/profiles/profile.h"
@@ -37,6 +46,7 @@
 #include "content/public/common/content_features.h"
 #include "content/public/test/browser_test.h"
 #include "content/public/test/browser_test_utils.h"
+#include "content/public/test/browsing_data_remover_test_util.h"
 #include "content/public/test/test_navigation_observer.h"
 #include "url/url_constants.h"
 
@@ -404,3 +414,53 @@ IN_PROC_BROWSER_TEST_F(BraveClearDataOnExitTwoBrowsersTest, TwoProfiles) {
   // Tell the application to quit.
   chrome::ExecuteCommand(browser(), IDC_EXIT);
 }
+
+class BraveClearBrowsingDataTest : public InProcessBrowserTest {
+ public:
+  BraveClearBrowsingDataTest() = default;
+
+  brave_wallet::DomainResolutionCache* domain_resolution_cache() {
+    return brave_wallet::RpcControllerFactory::GetControllerForContext(
+               browser()->profile())
+        ->domain_resolution_cache_for_testing();
+  }
+
+  void ResolveDomain() {
+    domain_resolution_cache()->Resolve(
+        "0x1", "addr", "brave.crypto",
+        base::BindOnce(
+            [](brave_wallet::DomainResolutionCache::ResolveCallback callback) {
+              std::move(callback).Run(true, {"0x1"});
+            }),
+        base::DoNothing());
+  }
+
+  void RemoveBrowsingData(uint64_t remove_mask) {
+    content::BrowsingDataRemover* remover =
+        browser()->profile()->GetBrowsingDataRemover();
+    content::BrowsingDataRemoverCompletionObserver observer(remover);
+    remover->RemoveAndReply(
+        base::Time(), base::Time::Max(), remove_mask,
+        content::BrowsingDataRemover::ORIGIN_TYPE_UNPROTECTED_WEB, &observer);
+    observer.BlockUntilCompletion();
+  }
+};
+
+IN_PROC_BROWSER_TEST_F(BraveClearBrowsingDataTest,
+                       ClearsResolvedDomainsWithHistoryOrCache) {
+  for (uint64_t remove_mask :
+       {static_cast<uint64_t>(chrome_browsing_data_remover::DATA_TYPE_HISTORY),
+        static_cast<uint64_t>(
+            content::BrowsingDataRemover::DATA_TYPE_CACHE)}) {
+    SCOPED_TRACE(remove_mask);
+    ResolveDomain();
+    ASSERT_EQ(domain_resolution_cache()->size(), 1u);
+    RemoveBrowsingData(remove_mask);
+    EXPECT_EQ(domain_resolution_cache()->size(), 0u);
+  }
+
+  // Other data types don't tell which sites were visited.
+  ResolveDomain();
+  RemoveBrowsingData(content::BrowsingDataRemover::DATA_TYPE_DOWNLOADS);
+  EXPECT_EQ(domain_resolution_cache()->size(), 1u);
+}
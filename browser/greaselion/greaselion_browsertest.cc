@@ -3,10 +3,18 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <algorithm>
+#include <set>
+#include <string>
+#include <vector>
+
 #include "base/containers/flat_map.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
 #include "base/scoped_observation.h"
+#include "base/stl_util.h"
 #include "base/task/post_task.h"
 #include "base/test/thread_test_helper.h"
 #include "brave/browser/brave_browser_process.h"
@@ -21,9 +29,13 @@
 #include "brave/components/greaselion/browser/greaselion_download_service.h"
 #include "brave/components/greaselion/browser/greaselion_service.h"
 #include "chrome/browser/extensions/extension_browsertest.h"
+#include "chrome/common/chrome_paths.h"
 #include "chrome/test/base/ui_test_utils.h"
 #include "content/public/test/browser_test.h"
 #include "content/public/test/browser_test_utils.h"
+#include "extensions/browser/extension_file_task_runner.h"
+#include "extensions/browser/extension_registry.h"
+#include "extensions/browser/extension_registry_observer.h"
 #include "net/dns/mock_host_resolver.h"
 #include "ui/base/ui_base_switches.h"
 
@@ -93,6 +105,40 @@ class GreaselionServiceWaiter : public GreaselionService::Observer {
   DISALLOW_COPY_AND_ASSIGN(GreaselionServiceWaiter);
 };
 
+// Records the extensions loaded and unloaded while it is alive.
+class ExtensionLoadRecorder : public extensions::ExtensionRegistryObserver {
+ public:
+  explicit ExtensionLoadRecorder(content::BrowserContext* browser_context) {
+    scoped_observer_.Observe(extensions::ExtensionRegistry::Get(
+        browser_context));
+  }
+  ~ExtensionLoadRecorder() override = default;
+
+  const std::vector<std::string>& loaded() const { return loaded_; }
+  const std::vector<std::string>& unloaded() const { return unloaded_; }
+
+ private:
+  // extensions::ExtensionRegistryObserver:
+  void OnExtensionLoaded(content::BrowserContext* browser_context,
+                         const extensions::Extension* extension) override {
+    loaded_.push_back(extension->id());
+  }
+  void OnExtensionUnloaded(
+      content::BrowserContext* browser_context,
+      const extensions::Extension* extension,
+      extensions::UnloadedExtensionReason reason) override {
+    unloaded_.push_back(extension->id());
+  }
+
+  std::vector<std::string> loaded_;
+  std::vector<std::string> unloaded_;
+  base::ScopedObservation<extensions::ExtensionRegistry,
+                          extensions::ExtensionRegistryObserver>
+      scoped_observer_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(ExtensionLoadRecorder);
+};
+
 class GreaselionServiceTest : public BaseLocalDataFilesBrowserTest {
  public:
   GreaselionServiceTest(): https_server_(net::EmbeddedTestServer::TYPE_HTTPS) {
@@ -140,6 +186,75 @@ class GreaselionServiceTest : public BaseLocalDataFilesBrowserTest {
     g_brave_browser_process->greaselion_download_service()->rules()->clear();
   }
 
+  GreaselionService* greaselion_service() {
+    return GreaselionServiceFactory::GetForBrowserContext(profile());
+  }
+
+  // Updates the installed extensions and waits for the update to finish.
+  void UpdateInstalledExtensions() {
+    greaselion_service()->UpdateInstalledExtensions();
+    GreaselionServiceWaiter(greaselion_service()).Wait();
+  }
+
+  void SetFeatureEnabled(greaselion::GreaselionFeature feature, bool enabled) {
+    greaselion_service()->SetFeatureEnabled(feature, enabled);
+    GreaselionServiceWaiter(greaselion_service()).Wait();
+  }
+
+  base::FilePath GetExtensionCacheDir() {
+    base::FilePath user_data_dir;
+    base::PathService::Get(chrome::DIR_USER_DATA, &user_data_dir);
+    return user_data_dir.AppendASCII("Greaselion").AppendASCII("Extensions");
+  }
+
+  // Returns the keys of the cached extensions, once the file tasks posted by
+  // the last update, such as pruning the cache, are done.
+  std::set<std::string> GetCachedExtensionKeys() {
+    auto helper = base::MakeRefCounted<base::ThreadTestHelper>(
+        extensions::GetExtensionFileTaskRunner());
+    EXPECT_TRUE(helper->Run());
+    base::ScopedAllowBlockingForTesting allow_blocking;
+    std::set<std::string> keys;
+    base::FileEnumerator enumerator(GetExtensionCacheDir(), false,
+                                    base::FileEnumerator::DIRECTORIES);
+    for (base::FilePath path = enumerator.Next(); !path.empty();
+         path = enumerator.Next()) {
+      keys.insert(path.BaseName().AsUTF8Unsafe());
+    }
+    return keys;
+  }
+
+  // Returns the manifest of the cached extension injecting into |url_pattern|.
+  base::FilePath GetCachedManifestPath(const std::string& url_pattern) {
+    for (const auto& key : GetCachedExtensionKeys()) {
+      const base::FilePath manifest_path = GetExtensionCacheDir()
+                                               .AppendASCII(key)
+                                               .AppendASCII("manifest.json");
+      base::ScopedAllowBlockingForTesting allow_blocking;
+      std::string manifest;
+      if (base::ReadFileToString(manifest_path, &manifest) &&
+          manifest.find(url_pattern) != std::string::npos) {
+        return manifest_path;
+      }
+    }
+    return base::FilePath();
+  }
+
+  // Returns the script file of the only rule using |script_name|.
+  base::FilePath GetRuleScriptPath(const std::string& script_name) {
+    base::FilePath script_path;
+    for (const auto& rule :
+         *g_brave_browser_process->greaselion_download_service()->rules()) {
+      for (const auto& script : rule->scripts()) {
+        if (script.BaseName().AsUTF8Unsafe() == script_name) {
+          EXPECT_TRUE(script_path.empty());
+          script_path = script;
+        }
+      }
+    }
+    return script_path;
+  }
+
   void StartRewards() {
     // HTTP resolver
     https_server_.SetSSLConfig(net::EmbeddedTestServer::CERT_OK);
@@ -536,6 +651,155 @@ IN_PROC_BROWSER_TEST_F(GreaselionServiceTest,
   EXPECT_EQ(title, "Altered");
 }
 
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, UnchangedRulesReloadNothing) {
+  ASSERT_TRUE(InstallMockExtension());
+  const std::set<std::string> cached_keys = GetCachedExtensionKeys();
+  ASSERT_FALSE(cached_keys.empty());
+
+  ExtensionLoadRecorder recorder(profile());
+  UpdateInstalledExtensions();
+  EXPECT_TRUE(recorder.loaded().empty());
+  EXPECT_TRUE(recorder.unloaded().empty());
+  EXPECT_EQ(GetCachedExtensionKeys(), cached_keys);
+}
+
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, ChangedScriptReinstallsItsRule) {
+  ASSERT_TRUE(InstallMockExtension());
+  const std::set<std::string> cached_keys = GetCachedExtensionKeys();
+  const size_t extension_count =
+      greaselion_service()->GetExtensionIdsForTesting().size();
+
+  // Only the messages.example.com rule uses this script.
+  const base::FilePath script_path =
+      GetRuleScriptPath("messages-example-com.js");
+  ASSERT_FALSE(script_path.empty());
+  {
+    base::ScopedAllowBlockingForTesting allow_blocking;
+    std::string script;
+    ASSERT_TRUE(base::ReadFileToString(script_path, &script));
+    ASSERT_TRUE(base::WriteFile(script_path, script + "\n// changed\n"));
+  }
+
+  ExtensionLoadRecorder recorder(profile());
+  UpdateInstalledExtensions();
+  ASSERT_EQ(recorder.unloaded().size(), 1u);
+  EXPECT_EQ(recorder.loaded(), recorder.unloaded());
+  EXPECT_EQ(greaselion_service()->GetExtensionIdsForTesting().size(),
+            extension_count);
+
+  // The old conversion of the rule was replaced by the new one.
+  const std::set<std::string> new_cached_keys = GetCachedExtensionKeys();
+  EXPECT_EQ(new_cached_keys.size(), cached_keys.size());
+  EXPECT_EQ(
+      base::STLSetDifference<std::set<std::string>>(cached_keys,
+                                                    new_cached_keys)
+          .size(),
+      1u);
+}
+
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, RuleThatStopsMatchingIsUnloaded) {
+  ASSERT_TRUE(InstallMockExtension());
+  SetFeatureEnabled(greaselion::AUTO_CONTRIBUTION, true);
+  const std::set<std::string> cached_keys = GetCachedExtensionKeys();
+  const size_t extension_count =
+      greaselion_service()->GetExtensionIdsForTesting().size();
+
+  {
+    // The pre1.example.com rule no longer matches.
+    ExtensionLoadRecorder recorder(profile());
+    SetFeatureEnabled(greaselion::AUTO_CONTRIBUTION, false);
+    EXPECT_EQ(recorder.unloaded().size(), 1u);
+    EXPECT_TRUE(recorder.loaded().empty());
+    EXPECT_EQ(greaselion_service()->GetExtensionIdsForTesting().size(),
+              extension_count - 1);
+    // But its conversion is kept for when it matches again.
+    EXPECT_EQ(GetCachedExtensionKeys(), cached_keys);
+  }
+
+  ExtensionLoadRecorder recorder(profile());
+  SetFeatureEnabled(greaselion::AUTO_CONTRIBUTION, true);
+  EXPECT_EQ(recorder.loaded().size(), 1u);
+  EXPECT_TRUE(recorder.unloaded().empty());
+  EXPECT_EQ(greaselion_service()->GetExtensionIdsForTesting().size(),
+            extension_count);
+  EXPECT_EQ(GetCachedExtensionKeys(), cached_keys);
+}
+
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, PrunesStaleCachedExtensions) {
+  ASSERT_TRUE(InstallMockExtension());
+  const std::set<std::string> cached_keys = GetCachedExtensionKeys();
+
+  // E.g. the conversion of a rule that was removed by a component update.
+  const base::FilePath stale_dir = GetExtensionCacheDir().AppendASCII("stale");
+  {
+    base::ScopedAllowBlockingForTesting allow_blocking;
+    ASSERT_TRUE(base::CreateDirectory(stale_dir));
+    ASSERT_TRUE(
+        base::WriteFile(stale_dir.AppendASCII("manifest.json"), "{}"));
+  }
+
+  UpdateInstalledExtensions();
+  EXPECT_EQ(GetCachedExtensionKeys(), cached_keys);
+  base::ScopedAllowBlockingForTesting allow_blocking;
+  EXPECT_FALSE(base::PathExists(stale_dir));
+}
+
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest,
+                       KeepsCachedExtensionsWithoutRules) {
+  ASSERT_TRUE(InstallMockExtension());
+  const std::set<std::string> cached_keys = GetCachedExtensionKeys();
+  ASSERT_FALSE(cached_keys.empty());
+
+  // Like at startup, when the rewards service can toggle a feature before
+  // the Greaselion component has loaded.
+  ClearRules();
+  SetFeatureEnabled(greaselion::AUTO_CONTRIBUTION, true);
+  EXPECT_TRUE(greaselion_service()->GetExtensionIdsForTesting().empty());
+  EXPECT_EQ(GetCachedExtensionKeys(), cached_keys);
+
+  // Once the rules are back, their extensions come from the cache.
+  ASSERT_TRUE(InstallMockExtension());
+  EXPECT_FALSE(greaselion_service()->GetExtensionIdsForTesting().empty());
+  const std::set<std::string> reloaded_keys = GetCachedExtensionKeys();
+  EXPECT_TRUE(std::includes(reloaded_keys.begin(), reloaded_keys.end(),
+                            cached_keys.begin(), cached_keys.end()));
+}
+
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, RebuildsCorruptCachedExtension) {
+  ASSERT_TRUE(InstallMockExtension());
+  SetFeatureEnabled(greaselion::AUTO_CONTRIBUTION, true);
+  SetFeatureEnabled(greaselion::AUTO_CONTRIBUTION, false);
+
+  // Corrupt the conversion of the pre1.example.com rule while it is unloaded,
+  // so that it is read again when the rule matches.
+  const base::FilePath manifest_path =
+      GetCachedManifestPath("http://pre1.example.com/*");
+  ASSERT_FALSE(manifest_path.empty());
+  {
+    base::ScopedAllowBlockingForTesting allow_blocking;
+    ASSERT_TRUE(base::WriteFile(manifest_path, "{"));
+  }
+
+  ExtensionLoadRecorder recorder(profile());
+  // The waiter checks that the rule was installed successfully.
+  SetFeatureEnabled(greaselion::AUTO_CONTRIBUTION, true);
+  EXPECT_EQ(recorder.loaded().size(), 1u);
+  EXPECT_EQ(GetCachedManifestPath("http://pre1.example.com/*"), manifest_path);
+
+  GURL url = embedded_test_server()->GetURL("pre1.example.com", "/simple.html");
+  ASSERT_TRUE(ui_test_utils::NavigateToURL(browser(), url));
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+  ASSERT_TRUE(content::WaitForLoadStop(contents));
+  std::string title;
+  ASSERT_TRUE(
+      ExecuteScriptAndExtractString(contents,
+                                    "window.domAutomationController.send("
+                                    "document.title)",
+                                    &title));
+  EXPECT_EQ(title, "Altered");
+}
+
 IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, CleanShutdown) {
   ASSERT_TRUE(InstallMockExtension());
 
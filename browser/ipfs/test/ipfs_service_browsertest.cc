@@ -3,13 +3,22 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <algorithm>
+#include <vector>
+
 #include "base/base64.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
 #include "base/strings/strcat.h"
+#include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
+#include "base/synchronization/lock.h"
+#include "base/test/bind.h"
 #include "base/test/mock_callback.h"
 #include "base/test/scoped_feature_list.h"
+#include "base/threading/thread_restrictions.h"
 #include "brave/browser/brave_browser_process.h"
 #include "brave/browser/ipfs/ipfs_blob_context_getter_factory.h"
 #include "brave/browser/ipfs/ipfs_service_factory.h"
@@ -30,6 +39,7 @@
 #include "components/network_session_configurator/common/network_switches.h"
 #include "components/prefs/pref_service.h"
 #include "content/public/test/browser_test.h"
+#include "net/base/url_util.h"
 #include "net/dns/mock_host_resolver.h"
 #include "net/test/embedded_test_server/http_request.h"
 #include "net/test/embedded_test_server/http_response.h"
@@ -312,6 +322,52 @@ class IpfsServiceBrowserTest : public InProcessBrowserTest {
     return nullptr;
   }
 
+  // Stands in for the node API used by streaming folder imports. Each file
+  // is added with its own request and gets a progress line before its entry.
+  std::unique_ptr<net::test_server::HttpResponse>
+  HandleStreamingFolderImportRequests(
+      const net::test_server::HttpRequest& request) {
+    const GURL gurl = request.GetURL();
+    auto http_response =
+        std::make_unique<net::test_server::BasicHttpResponse>();
+    http_response->set_code(net::HTTP_OK);
+    http_response->set_content_type("application/json");
+
+    std::string arg;
+    if (gurl.path_piece() == kImportAddPath) {
+      const std::string marker = "filename=\"";
+      size_t start = request.content.find(marker);
+      if (start == std::string::npos)
+        return nullptr;
+      start += marker.size();
+      arg = request.content.substr(start,
+                                   request.content.find('"', start) - start);
+      http_response->set_content(base::StringPrintf(
+          "{\"Name\":\"%s\",\"Bytes\":5}\n"
+          "{\"Name\":\"%s\",\"Hash\":\"Qm%s\",\"Size\":\"10\"}\n",
+          arg.c_str(), arg.c_str(), arg.c_str()));
+    } else if (gurl.path_piece() == kImportStatPath) {
+      http_response->set_content(
+          R"({"Hash":"QmFolder","Size":0,"CumulativeSize":40,)"
+          R"("Type":"directory"})");
+    } else if (gurl.path_piece() != kImportMakeDirectoryPath &&
+               gurl.path_piece() != kImportCopyPath &&
+               gurl.path_piece() != kImportRemovePath) {
+      return nullptr;
+    }
+    if (arg.empty())
+      net::GetValueForKeyInQuery(gurl, "arg", &arg);
+
+    base::AutoLock lock(import_requests_lock_);
+    import_requests_.push_back(gurl.path() + " " + arg);
+    return http_response;
+  }
+
+  std::vector<std::string> GetImportRequests() {
+    base::AutoLock lock(import_requests_lock_);
+    return import_requests_;
+  }
+
   std::unique_ptr<net::test_server::HttpResponse> HandleGetNodeInfo(
       const net::test_server::HttpRequest& request) {
     const GURL gurl = request.GetURL();
@@ -633,6 +689,19 @@ class IpfsServiceBrowserTest : public InProcessBrowserTest {
   std::unique_ptr<net::EmbeddedTestServer> test_server_;
   IpfsService* ipfs_service_;
   base::test::ScopedFeatureList feature_list_;
+  base::Lock import_requests_lock_;
+  std::vector<std::string> import_requests_;
+};
+
+class IpfsStreamingFolderImportBrowserTest : public IpfsServiceBrowserTest {
+ public:
+  IpfsStreamingFolderImportBrowserTest() {
+    feature_list_.InitAndEnableFeature(
+        ipfs::features::kIpfsStreamingFolderImport);
+  }
+
+ private:
+  base::test::ScopedFeatureList feature_list_;
 };
 
 IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, StartSuccessAndLaunch) {
@@ -1135,6 +1204,101 @@ IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, ImportFileAndPinToIpfsSuccess) {
   WaitForRequest();
 }
 
+IN_PROC_BROWSER_TEST_F(IpfsStreamingFolderImportBrowserTest,
+                       ImportDirectoryToIpfsSuccess) {
+  ResetTestServer(base::BindRepeating(
+      &IpfsServiceBrowserTest::HandleStreamingFolderImportRequests,
+      base::Unretained(this)));
+  auto* folder = FILE_PATH_LITERAL("brave/test/data/autoplay-whitelist-data");
+  auto test_path = embedded_test_server()->GetFullPathFromSourceDirectory(
+      base::FilePath(folder));
+
+  ipfs::ImportedData result;
+  base::RunLoop run_loop;
+  ipfs_service()->ImportDirectoryToIpfs(
+      test_path, std::string(),
+      base::BindLambdaForTesting([&](const ipfs::ImportedData& data) {
+        result = data;
+        run_loop.Quit();
+      }));
+  run_loop.Run();
+
+  EXPECT_EQ(result.state, ipfs::IPFS_IMPORT_SUCCESS);
+  EXPECT_EQ(result.filename, "autoplay-whitelist-data");
+  EXPECT_EQ(result.hash, "QmFolder");
+  EXPECT_EQ(result.size, 20);
+  EXPECT_FALSE(result.directory.empty());
+
+  const auto requests = GetImportRequests();
+  auto count = [&requests](const std::string& request) {
+    return std::count(requests.begin(), requests.end(), request);
+  };
+  // Files are added one by one rather than as a single multipart request.
+  EXPECT_EQ(count("/api/v0/add AutoplayWhitelist.dat"), 1);
+  EXPECT_EQ(count("/api/v0/add manifest.json"), 1);
+  EXPECT_EQ(count("/api/v0/files/cp /ipfs/QmAutoplayWhitelist.dat"), 1);
+  EXPECT_EQ(count("/api/v0/files/cp /ipfs/Qmmanifest.json"), 1);
+  // The assembled folder is copied to the imports directory.
+  EXPECT_EQ(count("/api/v0/files/cp /ipfs/QmFolder"), 1);
+  ASSERT_FALSE(requests.empty());
+  EXPECT_EQ(requests.back().find("/api/v0/files/cp"), 0u);
+  EXPECT_EQ(std::count_if(requests.begin(), requests.end(),
+                          [](const std::string& request) {
+                            return request.find("/api/v0/files/rm ") == 0;
+                          }),
+            1);
+}
+
+IN_PROC_BROWSER_TEST_F(IpfsStreamingFolderImportBrowserTest,
+                       ImportDirectoryWithNonAsciiNames) {
+  ResetTestServer(base::BindRepeating(
+      &IpfsServiceBrowserTest::HandleStreamingFolderImportRequests,
+      base::Unretained(this)));
+  base::ScopedTempDir temp_dir;
+  base::FilePath test_path;
+  {
+    base::ScopedAllowBlockingForTesting allow_blocking;
+    ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+    test_path = temp_dir.GetPath().Append(
+        base::FilePath::FromUTF8Unsafe("donn\xC3\xA9" "es"));
+    const base::FilePath sub_path =
+        test_path.Append(base::FilePath::FromUTF8Unsafe("\xE6\x97\xA5"));
+    ASSERT_TRUE(base::CreateDirectory(sub_path));
+    ASSERT_TRUE(base::WriteFile(sub_path.Append(base::FilePath::FromUTF8Unsafe(
+                                    "r\xC3\xA9sum\xC3\xA9.txt")),
+                                "hello"));
+  }
+
+  ipfs::ImportedData result;
+  base::RunLoop run_loop;
+  ipfs_service()->ImportDirectoryToIpfs(
+      test_path, std::string(),
+      base::BindLambdaForTesting([&](const ipfs::ImportedData& data) {
+        result = data;
+        run_loop.Quit();
+      }));
+  run_loop.Run();
+  EXPECT_EQ(result.state, ipfs::IPFS_IMPORT_SUCCESS);
+  EXPECT_EQ(result.hash, "QmFolder");
+
+  const auto requests = GetImportRequests();
+  auto count = [&requests](const std::string& request) {
+    return std::count(requests.begin(), requests.end(), request);
+  };
+  // Names reach the node as UTF-8 rather than being dropped.
+  EXPECT_EQ(count("/api/v0/add r\xC3\xA9sum\xC3\xA9.txt"), 1);
+  EXPECT_EQ(count("/api/v0/files/cp /ipfs/Qmr\xC3\xA9sum\xC3\xA9.txt"), 1);
+  auto ends_with = [&requests](const std::string& suffix) {
+    return std::count_if(requests.begin(), requests.end(),
+                         [&suffix](const std::string& request) {
+                           return base::EndsWith(request, suffix);
+                         });
+  };
+  // The folder is created and then looked up, the subfolder only created.
+  EXPECT_EQ(ends_with("/donn\xC3\xA9" "es"), 2);
+  EXPECT_EQ(ends_with("/donn\xC3\xA9" "es/\xE6\x97\xA5"), 1);
+}
+
 IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest,
                        UpdaterRegistrationSuccessLaunch) {
   base::FilePath user_dir = base::FilePath(FILE_PATH_LITERAL("test"));
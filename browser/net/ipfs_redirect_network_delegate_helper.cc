@@ -5,9 +5,14 @@
 
 #include "brave/browser/net/ipfs_redirect_network_delegate_helper.h"
 
+#include <memory>
 #include <string>
+#include <utility>
 
+#include "base/supports_user_data.h"
+#include "base/time/time.h"
 #include "brave/browser/profiles/profile_util.h"
+#include "brave/components/ipfs/content_path_cache.h"
 #include "brave/components/ipfs/ipfs_utils.h"
 #include "chrome/common/channel_info.h"
 #include "components/prefs/pref_service.h"
@@ -15,6 +20,31 @@
 #include "content/public/browser/browser_context.h"
 #include "net/base/net_errors.h"
 
+namespace {
+
+const size_t kMaxCachedContentPaths = 1000;
+// How long an /ipns/ path is remembered when the response has no max-age.
+constexpr base::TimeDelta kDefaultIPNSTTL = base::TimeDelta::FromMinutes(1);
+
+const void* const kContentPathCacheKey = &kContentPathCacheKey;
+
+struct ContentPathCacheData : public base::SupportsUserData::Data {
+  ipfs::ContentPathCache cache{kMaxCachedContentPaths};
+};
+
+ipfs::ContentPathCache* GetContentPathCache(content::BrowserContext* context) {
+  auto* data = static_cast<ContentPathCacheData*>(
+      context->GetUserData(kContentPathCacheKey));
+  if (!data) {
+    auto new_data = std::make_unique<ContentPathCacheData>();
+    data = new_data.get();
+    context->SetUserData(kContentPathCacheKey, std::move(new_data));
+  }
+  return &data->cache;
+}
+
+}  // namespace
+
 namespace ipfs {
 
 int OnBeforeURLRequest_IPFSRedirectWork(
@@ -45,6 +75,21 @@ int OnBeforeURLRequest_IPFSRedirectWork(
     } else {
       ctx->blocked_by = brave::kOtherBlocked;
     }
+  } else if (ctx->ipfs_auto_fallback && ctx->method == "GET" &&
+             !ctx->request_url.DomainIs(ctx->ipfs_gateway_url.host()) &&
+             !IsAPIGateway(ctx->request_url, chrome::GetChannel())) {
+    // Content already known to be on IPFS goes straight to the gateway
+    // instead of waiting for the x-ipfs-path header of the response. Other
+    // methods are left to the origin, which may not serve the same content
+    // for them.
+    const std::string ipfs_path =
+        GetContentPathCache(ctx->browser_context)->Get(ctx->request_url);
+    if (!ipfs_path.empty()) {
+      GURL::Replacements replacements;
+      replacements.SetPathStr(ipfs_path);
+      ctx->new_url_spec =
+          ctx->ipfs_gateway_url.ReplaceComponents(replacements).spec();
+    }
   }
   return net::OK;
 }
@@ -68,6 +113,14 @@ int OnHeadersReceived_IPFSRedirectWork(
       response_headers->GetNormalizedHeader("x-ipfs-path", &ipfs_path) &&
       // Make sure we don't infinite redirect
       !ctx->request_url.DomainIs(ctx->ipfs_gateway_url.host())) {
+    if (brave::IsRegularProfile(ctx->browser_context)) {
+      base::TimeDelta ipns_ttl;
+      if (!response_headers->GetMaxAgeValue(&ipns_ttl))
+        ipns_ttl = kDefaultIPNSTTL;
+      GetContentPathCache(ctx->browser_context)
+          ->Add(ctx->request_url, ipfs_path, ipns_ttl);
+    }
+
     GURL::Replacements replacements;
     replacements.SetPathStr(ipfs_path);
     GURL new_url = ctx->ipfs_gateway_url.ReplaceComponents(replacements);
@@ -84,4 +137,8 @@ int OnHeadersReceived_IPFSRedirectWork(
   return net::OK;
 }
 
+void ClearContentPathCache(content::BrowserContext* context) {
+  GetContentPathCache(context)->Clear();
+}
+
 }  // namespace ipfs
@@ -12,6 +12,10 @@
 #include "net/http/http_response_headers.h"
 #include "url/gurl.h"
 
+namespace content {
+class BrowserContext;
+}  // namespace content
+
 namespace ipfs {
 
 int OnBeforeURLRequest_IPFSRedirectWork(
@@ -25,6 +29,10 @@ int OnHeadersReceived_IPFSRedirectWork(
     const brave::ResponseCallback& next_callback,
     std::shared_ptr<brave::BraveRequestInfo> ctx);
 
+// Forgets which URLs were found to serve IPFS content, e.g. when the user
+// clears their browsing data.
+void ClearContentPathCache(content::BrowserContext* context);
+
 }  // namespace ipfs
 
 #endif  // BRAVE_BROWSER_NET_IPFS_REDIRECT_NETWORK_DELEGATE_HELPER_H_
@@ -203,6 +203,70 @@ TEST_F(IPFSRedirectNetworkDelegateHelperTest, HeadersIPFSWorkNoRedirect) {
   EXPECT_TRUE(allowed_unsafe_redirect_url.is_empty());
 }
 
+TEST_F(IPFSRedirectNetworkDelegateHelperTest, KnownContentRedirectsUpfront) {
+  GURL url(
+      "https://cloudflare-ipfs.com/ipfs/"
+      "QmSrPmbaUKA3ZodhzPWZnpFgcPMFWF4QsxXbkWfEptTBJd");
+  auto request_info = std::make_shared<brave::BraveRequestInfo>(url);
+  request_info->browser_context = profile();
+  request_info->ipfs_gateway_url = GetPublicGateway();
+  request_info->resource_type = blink::mojom::ResourceType::kImage;
+  request_info->ipfs_auto_fallback = true;
+  request_info->method = "GET";
+
+  int rc = ipfs::OnBeforeURLRequest_IPFSRedirectWork(brave::ResponseCallback(),
+                                                     request_info);
+  EXPECT_EQ(rc, net::OK);
+  EXPECT_TRUE(request_info->new_url_spec.empty());
+
+  scoped_refptr<net::HttpResponseHeaders> orig_response_headers =
+      new net::HttpResponseHeaders(std::string());
+  orig_response_headers->AddHeader(
+      "x-ipfs-path", "/ipfs/QmSrPmbaUKA3ZodhzPWZnpFgcPMFWF4QsxXbkWfEptTBJd");
+  scoped_refptr<net::HttpResponseHeaders> overwrite_response_headers =
+      new net::HttpResponseHeaders(std::string());
+  GURL allowed_unsafe_redirect_url;
+  rc = ipfs::OnHeadersReceived_IPFSRedirectWork(
+      orig_response_headers.get(), &overwrite_response_headers,
+      &allowed_unsafe_redirect_url, brave::ResponseCallback(), request_info);
+  EXPECT_EQ(rc, net::OK);
+
+  // Other content on the same gateway no longer waits for the response.
+  request_info->request_url = GURL(
+      "https://cloudflare-ipfs.com/ipfs/"
+      "QmfM2r8seH2GiRaC4esTjeraXEachRt8ZsSeGaWTPLyMoG/image.png");
+  rc = ipfs::OnBeforeURLRequest_IPFSRedirectWork(brave::ResponseCallback(),
+                                                 request_info);
+  EXPECT_EQ(rc, net::OK);
+  EXPECT_EQ(request_info->new_url_spec,
+            "https://dweb.link/ipfs/"
+            "QmfM2r8seH2GiRaC4esTjeraXEachRt8ZsSeGaWTPLyMoG/image.png");
+
+  // Only GET requests are redirected before they are sent.
+  request_info->new_url_spec.clear();
+  request_info->method = "POST";
+  rc = ipfs::OnBeforeURLRequest_IPFSRedirectWork(brave::ResponseCallback(),
+                                                 request_info);
+  EXPECT_EQ(rc, net::OK);
+  EXPECT_TRUE(request_info->new_url_spec.empty());
+  request_info->method = "GET";
+
+  // Nor when automatic redirects are off.
+  request_info->ipfs_auto_fallback = false;
+  rc = ipfs::OnBeforeURLRequest_IPFSRedirectWork(brave::ResponseCallback(),
+                                                 request_info);
+  EXPECT_EQ(rc, net::OK);
+  EXPECT_TRUE(request_info->new_url_spec.empty());
+
+  // Clearing browsing data forgets the gateway.
+  request_info->ipfs_auto_fallback = true;
+  ipfs::ClearContentPathCache(profile());
+  rc = ipfs::OnBeforeURLRequest_IPFSRedirectWork(brave::ResponseCallback(),
+                                                 request_info);
+  EXPECT_EQ(rc, net::OK);
+  EXPECT_TRUE(request_info->new_url_spec.empty());
+}
+
 TEST_F(IPFSRedirectNetworkDelegateHelperTest, PrivateProfile) {
   GURL url("ipfs://QmfM2r8seH2GiRaC4esTjeraXEachRt8ZsSeGaWTPLyMoG");
   auto brave_request_info = std::make_shared<brave::BraveRequestInfo>(url);
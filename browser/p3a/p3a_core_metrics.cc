@@ -98,6 +98,11 @@ void BraveUptimeTracker::CreateInstance(PrefService* local_state) {
   g_brave_uptime_tracker_instance = new BraveUptimeTracker(local_state);
 }
 
+void BraveUptimeTracker::FlushInstance() {
+  if (g_brave_uptime_tracker_instance)
+    g_brave_uptime_tracker_instance->state_.Flush();
+}
+
 void BraveUptimeTracker::RegisterPrefs(PrefRegistrySimple* registry) {
   registry->RegisterListPref(kDailyUptimesListPrefName);
 }
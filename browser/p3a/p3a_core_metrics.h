@@ -35,6 +35,9 @@ class BraveUptimeTracker {
   ~BraveUptimeTracker();
 
   static void CreateInstance(PrefService* local_state);
+  // Writes the uptime recorded so far to local state, before it is committed
+  // on shutdown.
+  static void FlushInstance();
 
   static void RegisterPrefs(PrefRegistrySimple* registry);
 
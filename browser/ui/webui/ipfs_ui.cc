@@ -110,10 +110,15 @@ void IPFSDOMHandler::HandleGetConnectedPeers(base::Value::ConstListView args) {
   if (!service) {
     return;
   }
-  service->GetConnectedPeers(base::BindOnce(
+  service->GetCachedConnectedPeers(base::BindOnce(
       &IPFSDOMHandler::OnGetConnectedPeers, weak_ptr_factory_.GetWeakPtr()));
 }
 
+void IPFSDOMHandler::OnConnectedPeersChanged(
+    const std::vector<std::string>& peers) {
+  OnGetConnectedPeers(true, peers);
+}
+
 void IPFSDOMHandler::OnGetConnectedPeers(
     bool success,
     const std::vector<std::string>& peers) {
@@ -281,6 +286,10 @@ void IPFSDOMHandler::OnGetRepoStats(bool success,
                                          std::move(stats_value));
 }
 
+void IPFSDOMHandler::OnRepoStatsChanged(const ipfs::RepoStats& stats) {
+  OnGetRepoStats(true, stats);
+}
+
 void IPFSDOMHandler::HandleGetNodeInfo(base::Value::ConstListView args) {
   DCHECK_EQ(args.size(), 0U);
   if (!web_ui()->CanCallJavascript())
@@ -335,3 +344,7 @@ void IPFSDOMHandler::OnGetNodeInfo(bool success, const ipfs::NodeInfo& info) {
   web_ui()->CallJavascriptFunctionUnsafe("ipfs.onGetNodeInfo",
                                          std::move(node_value));
 }
+
+void IPFSDOMHandler::OnNodeInfoChanged(const ipfs::NodeInfo& info) {
+  OnGetNodeInfo(true, info);
+}
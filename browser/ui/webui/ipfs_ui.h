@@ -37,6 +37,9 @@ class IPFSDOMHandler : public content::WebUIMessageHandler,
   void OnGetConnectedPeers(bool success,
                            const std::vector<std::string>& peers) override;
   void OnInstallationEvent(ipfs::ComponentUpdaterEvents event) override;
+  void OnConnectedPeersChanged(const std::vector<std::string>& peers) override;
+  void OnRepoStatsChanged(const ipfs::RepoStats& stats) override;
+  void OnNodeInfoChanged(const ipfs::NodeInfo& info) override;
 
  private:
   void HandleGetConnectedPeers(base::Value::ConstListView args);
@@ -0,0 +1,119 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <array>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/core/execution_context/execution_context.h"
+
+namespace brave {
+
+namespace {
+
+std::vector<float> GetSamples() {
+  std::vector<float> samples;
+  for (int i = 0; i < 1000; ++i)
+    samples.push_back((i % 200 - 100) / 100.0f);
+  return samples;
+}
+
+// The per-sample path, as used by RealtimeAnalyser and formerly by
+// AudioBuffer.
+std::vector<float> FarblePerSample(const AudioFarblingHelper& helper,
+                                   std::vector<float> samples) {
+  for (size_t i = 0; i < samples.size(); ++i)
+    samples[i] = helper.FarbleAudioSample(samples[i], i);
+  return samples;
+}
+
+std::vector<float> FarblePerBuffer(const AudioFarblingHelper& helper,
+                                   std::vector<float> samples) {
+  helper.FarbleAudioBuffer(samples);
+  return samples;
+}
+
+using CanvasKey = std::array<uint8_t, 32>;
+
+CanvasKey GetCanvasKey(CanvasKeyCache* cache,
+                       const std::vector<unsigned char>& pixels) {
+  CanvasKey key;
+  cache->GetCanvasKey(pixels.data(), pixels.size(), key.data());
+  return key;
+}
+
+}  // namespace
+
+TEST(CanvasKeyCacheTest, UnchangedCanvasKeepsItsKey) {
+  std::vector<unsigned char> pixels(16 * 16 * 4, 0x80);
+  CanvasKeyCache cache(12345);
+  const CanvasKey key = GetCanvasKey(&cache, pixels);
+  EXPECT_EQ(GetCanvasKey(&cache, pixels), key);
+
+  // The cached key is the one a fresh computation gives.
+  CanvasKeyCache fresh_cache(12345);
+  EXPECT_EQ(GetCanvasKey(&fresh_cache, pixels), key);
+
+  // And it depends on the session and domain.
+  CanvasKeyCache other_cache(54321);
+  EXPECT_NE(GetCanvasKey(&other_cache, pixels), key);
+}
+
+TEST(CanvasKeyCacheTest, ChangedCanvasGetsNewKey) {
+  std::vector<unsigned char> pixels(16 * 16 * 4, 0x80);
+  CanvasKeyCache cache(12345);
+  const CanvasKey key = GetCanvasKey(&cache, pixels);
+
+  // A single changed byte in any of the stripes changes the key.
+  for (size_t index : {size_t{0}, pixels.size() / 2, pixels.size() - 1}) {
+    pixels[index] ^= 0x1;
+    const CanvasKey changed_key = GetCanvasKey(&cache, pixels);
+    EXPECT_NE(changed_key, key);
+    EXPECT_EQ(GetCanvasKey(&cache, pixels), changed_key);
+
+    pixels[index] ^= 0x1;
+    EXPECT_EQ(GetCanvasKey(&cache, pixels), key);
+  }
+
+  // So does a change of size.
+  pixels.resize(pixels.size() + 4, 0x80);
+  EXPECT_NE(GetCanvasKey(&cache, pixels), key);
+}
+
+TEST(AudioFarblingHelperTest, Off) {
+  AudioFarblingHelper helper;
+  EXPECT_FALSE(helper.IsEnabled());
+  EXPECT_EQ(FarblePerBuffer(helper, GetSamples()), GetSamples());
+  EXPECT_EQ(FarblePerSample(helper, GetSamples()), GetSamples());
+}
+
+TEST(AudioFarblingHelperTest, ConstantMultiplierMatchesPerSample) {
+  auto helper = AudioFarblingHelper::ConstantMultiplier(0.99417);
+  EXPECT_TRUE(helper.IsEnabled());
+  const std::vector<float> farbled = FarblePerBuffer(helper, GetSamples());
+  EXPECT_NE(farbled, GetSamples());
+  EXPECT_EQ(farbled, FarblePerSample(helper, GetSamples()));
+}
+
+TEST(AudioFarblingHelperTest, PseudoRandomSequenceMatchesPerSample) {
+  auto helper = AudioFarblingHelper::PseudoRandomSequence(0x1234567890abcdef);
+  EXPECT_TRUE(helper.IsEnabled());
+  const std::vector<float> farbled = FarblePerBuffer(helper, GetSamples());
+  EXPECT_EQ(farbled, FarblePerSample(helper, GetSamples()));
+  for (float sample : farbled) {
+    EXPECT_GE(sample, 0.0f);
+    EXPECT_LE(sample, 0.1f);
+  }
+
+  // Every buffer starts the sequence over, and the per-sample path restarts
+  // at index 0 even after a buffer was farbled with the same helper.
+  EXPECT_EQ(FarblePerBuffer(helper, GetSamples()), farbled);
+  EXPECT_EQ(FarblePerSample(helper, GetSamples()), farbled);
+
+  auto other_helper = AudioFarblingHelper::PseudoRandomSequence(42);
+  EXPECT_NE(FarblePerBuffer(other_helper, GetSamples()), farbled);
+}
+
+}  // namespace brave
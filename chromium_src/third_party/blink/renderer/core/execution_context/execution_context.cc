@@ -5,7 +5,11 @@
 
 #include "third_party/blink/renderer/core/execution_context/execution_context.h"
 
+#include <algorithm>
+
 #include "base/command_line.h"
+#include "base/containers/span.h"
+#include "base/hash/hash.h"
 #include "base/strings/string_number_conversions.h"
 #include "crypto/hmac.h"
 #include "third_party/blink/public/platform/web_content_settings_client.h"
@@ -30,25 +34,9 @@ inline uint64_t lfsr_next(uint64_t v) {
   return ((v >> 1) | (((v << 62) ^ (v << 61)) & (~(~zero << 63) << 62)));
 }
 
-float Identity(float value, size_t index) {
-  return value;
-}
-
-float ConstantMultiplier(double fudge_factor, float value, size_t index) {
-  return value * fudge_factor;
-}
-
-float PseudoRandomSequence(uint64_t seed, float value, size_t index) {
-  static uint64_t v;
+// Maps a PRNG value to the farbled sample, a float between 0 and 0.1.
+inline float PseudoRandomSample(uint64_t v) {
   const double maxUInt64AsDouble = UINT64_MAX;
-  if (index == 0) {
-    // start of loop, reset to initial seed which was passed in and is based on
-    // the domain key
-    v = seed;
-  }
-  // get next value in PRNG sequence
-  v = lfsr_next(v);
-  // return pseudo-random float between 0 and 0.1
   return (v / maxUInt64AsDouble) / 10;
 }
 
@@ -127,6 +115,8 @@ BraveSessionCache::BraveSessionCache(ExecutionContext& context)
   CHECK(h.Init(reinterpret_cast<const unsigned char*>(&session_key_),
                sizeof session_key_));
   CHECK(h.Sign(domain, domain_key_, sizeof domain_key_));
+  canvas_key_cache_ =
+      CanvasKeyCache(session_key_ ^ *reinterpret_cast<uint64_t*>(domain_key_));
   farbling_enabled_ = true;
 }
 
@@ -140,7 +130,119 @@ BraveSessionCache& BraveSessionCache::From(ExecutionContext& context) {
   return *cache;
 }
 
-AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
+AudioFarblingHelper::AudioFarblingHelper() = default;
+AudioFarblingHelper::AudioFarblingHelper(const AudioFarblingHelper&) = default;
+AudioFarblingHelper& AudioFarblingHelper::operator=(
+    const AudioFarblingHelper&) = default;
+AudioFarblingHelper::~AudioFarblingHelper() = default;
+
+// static
+AudioFarblingHelper AudioFarblingHelper::ConstantMultiplier(
+    double fudge_factor) {
+  AudioFarblingHelper helper;
+  helper.mode_ = Mode::kConstantMultiplier;
+  helper.fudge_factor_ = fudge_factor;
+  return helper;
+}
+
+// static
+AudioFarblingHelper AudioFarblingHelper::PseudoRandomSequence(uint64_t seed) {
+  AudioFarblingHelper helper;
+  helper.mode_ = Mode::kPseudoRandomSequence;
+  helper.seed_ = seed;
+  helper.prng_state_ = seed;
+  return helper;
+}
+
+void AudioFarblingHelper::FarbleAudioBuffer(base::span<float> buffer) const {
+  float* data = buffer.data();
+  const size_t size = buffer.size();
+  switch (mode_) {
+    case Mode::kOff:
+      break;
+    case Mode::kConstantMultiplier: {
+      // Plain loop over contiguous memory without calls so the compiler
+      // vectorizes it. The product is computed in double precision like the
+      // per-sample path so the output is bit-identical.
+      const double fudge_factor = fudge_factor_;
+      for (size_t i = 0; i < size; ++i)
+        data[i] = static_cast<float>(data[i] * fudge_factor);
+      break;
+    }
+    case Mode::kPseudoRandomSequence: {
+      // Sample i of the sequence is the (i + 1)th LFSR value after the seed.
+      uint64_t v = seed_;
+      for (size_t i = 0; i < size; ++i) {
+        v = lfsr_next(v);
+        data[i] = PseudoRandomSample(v);
+      }
+      break;
+    }
+  }
+}
+
+float AudioFarblingHelper::FarbleAudioSample(float value, size_t index) const {
+  switch (mode_) {
+    case Mode::kOff:
+      return value;
+    case Mode::kConstantMultiplier:
+      return value * fudge_factor_;
+    case Mode::kPseudoRandomSequence:
+      if (index == 0) {
+        // start of loop, reset to initial seed which is based on the domain
+        // key
+        prng_state_ = seed_;
+      }
+      prng_state_ = lfsr_next(prng_state_);
+      return PseudoRandomSample(prng_state_);
+  }
+  NOTREACHED();
+  return value;
+}
+
+CanvasKeyCache::CanvasKeyCache(uint64_t hmac_key) : hmac_key_(hmac_key) {}
+CanvasKeyCache::CanvasKeyCache(const CanvasKeyCache&) = default;
+CanvasKeyCache& CanvasKeyCache::operator=(const CanvasKeyCache&) = default;
+CanvasKeyCache::~CanvasKeyCache() = default;
+
+void CanvasKeyCache::GetCanvasKey(const unsigned char* data,
+                                  size_t size,
+                                  uint8_t canvas_key[32]) {
+  // HMAC-SHA256 over the whole buffer made every read of a large canvas
+  // expensive. Instead the contents are reduced with a fast non-cryptographic
+  // hash per stripe, and only that digest goes through the keyed HMAC. The
+  // hash must be stable across builds so farbled output stays reproducible.
+  Digest digest;
+  const size_t stripe_size = (size + kDigestStripes - 1) / kDigestStripes;
+  for (size_t i = 0; i < kDigestStripes; ++i) {
+    const size_t begin = std::min(size, i * stripe_size);
+    const size_t end = std::min(size, begin + stripe_size);
+    digest[i] =
+        base::PersistentHash(base::make_span(data + begin, end - begin));
+  }
+
+  if (size == last_size_ && digest == last_digest_) {
+    memcpy(canvas_key, last_key_, sizeof last_key_);
+    return;
+  }
+
+  crypto::HMAC h(crypto::HMAC::SHA256);
+  CHECK(h.Init(reinterpret_cast<const unsigned char*>(&hmac_key_),
+               sizeof hmac_key_));
+  uint64_t message[1 + kDigestStripes];
+  message[0] = size;
+  for (size_t i = 0; i < kDigestStripes; ++i)
+    message[i + 1] = digest[i];
+  CHECK(h.Sign(base::StringPiece(reinterpret_cast<const char*>(message),
+                                 sizeof message),
+               canvas_key, 32));
+
+  last_size_ = size;
+  last_digest_ = digest;
+  memcpy(last_key_, canvas_key, sizeof last_key_);
+}
+
+AudioFarblingHelper BraveSessionCache::GetAudioFarblingHelper(
     blink::WebContentSettingsClient* settings) {
   if (farbling_enabled_ && settings) {
     switch (settings->GetBraveFarblingLevel()) {
@@ -153,15 +255,23 @@ AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
         double fudge_factor = 0.99 + ((*fudge / maxUInt64AsDouble) / 100);
         VLOG(1) << "audio fudge factor (based on session token) = "
                 << fudge_factor;
-        return base::BindRepeating(&ConstantMultiplier, fudge_factor);
+        return AudioFarblingHelper::ConstantMultiplier(fudge_factor);
       }
       case BraveFarblingLevel::MAXIMUM: {
         uint64_t seed = *reinterpret_cast<uint64_t*>(domain_key_);
-        return base::BindRepeating(&PseudoRandomSequence, seed);
+        return AudioFarblingHelper::PseudoRandomSequence(seed);
       }
     }
   }
-  return base::BindRepeating(&Identity);
+  return AudioFarblingHelper();
+}
+
+void BraveSessionCache::FarbleAudioBuffer(
+    blink::WebContentSettingsClient* settings,
+    base::span<float> buffer) {
+  if (buffer.empty())
+    return;
+  GetAudioFarblingHelper(settings).FarbleAudioBuffer(buffer);
 }
 
 void BraveSessionCache::PerturbPixels(blink::WebContentSettingsClient* settings,
@@ -197,14 +307,8 @@ void BraveSessionCache::PerturbPixelsInternal(const unsigned char* data,
   const size_t pixel_count = size / 4;
   // calculate initial seed to find first pixel to perturb, based on session
   // key, domain key, and canvas contents
-  crypto::HMAC h(crypto::HMAC::SHA256);
-  uint64_t session_plus_domain_key =
-      session_key_ ^ *reinterpret_cast<uint64_t*>(domain_key_);
-  CHECK(h.Init(reinterpret_cast<const unsigned char*>(&session_plus_domain_key),
-               sizeof session_plus_domain_key));
   uint8_t canvas_key[32];
-  CHECK(h.Sign(base::StringPiece(reinterpret_cast<const char*>(pixels), size),
-               canvas_key, sizeof canvas_key));
+  canvas_key_cache_.GetCanvasKey(data, size, canvas_key);
   uint64_t v = *reinterpret_cast<uint64_t*>(canvas_key);
   uint64_t pixel_index;
   // choose which channel (R, G, or B) to perturb
@@ -8,9 +8,10 @@
 
 #include "../../../../../../../third_party/blink/renderer/core/execution_context/execution_context.h"
 
+#include <array>
 #include <random>
 
-#include "base/callback.h"
+#include "base/containers/span.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
 
 namespace blink {
@@ -24,7 +25,70 @@ using blink::Supplement;
 
 namespace brave {
 
-typedef base::RepeatingCallback<float(float, size_t)> AudioFarblingCallback;
+// Applies the audio farbling of a farbling level to WebAudio samples. It is a
+// small value type so callers can keep it around (e.g. RealtimeAnalyser) and
+// farble whole buffers without an indirect call per sample.
+class CORE_EXPORT AudioFarblingHelper {
+ public:
+  // Leaves samples untouched.
+  AudioFarblingHelper();
+  AudioFarblingHelper(const AudioFarblingHelper&);
+  AudioFarblingHelper& operator=(const AudioFarblingHelper&);
+  ~AudioFarblingHelper();
+
+  // BALANCED: every sample is scaled by |fudge_factor|.
+  static AudioFarblingHelper ConstantMultiplier(double fudge_factor);
+  // MAXIMUM: samples are replaced with a pseudo-random sequence seeded by
+  // |seed|.
+  static AudioFarblingHelper PseudoRandomSequence(uint64_t seed);
+
+  bool IsEnabled() const { return mode_ != Mode::kOff; }
+
+  // Farbles |buffer| in place, producing the same samples as calling
+  // FarbleAudioSample() for each of them from index 0.
+  void FarbleAudioBuffer(base::span<float> buffer) const;
+
+  // Farbles a single sample for loops that also transform the value. Must be
+  // called with consecutive indices starting from 0.
+  float FarbleAudioSample(float value, size_t index) const;
+
+ private:
+  enum class Mode { kOff, kConstantMultiplier, kPseudoRandomSequence };
+
+  Mode mode_ = Mode::kOff;
+  double fudge_factor_ = 1.0;
+  uint64_t seed_ = 0;
+  // Last generated value of the pseudo-random sequence for
+  // FarbleAudioSample().
+  mutable uint64_t prng_state_ = 0;
+};
+
+// Derives the key canvas farbling is seeded with from the canvas contents.
+// The key of the last buffer is kept, so that pages polling an unchanged
+// canvas skip the HMAC.
+class CORE_EXPORT CanvasKeyCache {
+ public:
+  // Number of stripes the pixel buffer is split into for the digest.
+  static constexpr size_t kDigestStripes = 4;
+
+  // |hmac_key| is the session key mixed with the domain key.
+  explicit CanvasKeyCache(uint64_t hmac_key = 0);
+  CanvasKeyCache(const CanvasKeyCache&);
+  CanvasKeyCache& operator=(const CanvasKeyCache&);
+  ~CanvasKeyCache();
+
+  void GetCanvasKey(const unsigned char* data,
+                    size_t size,
+                    uint8_t canvas_key[32]);
+
+ private:
+  using Digest = std::array<uint32_t, kDigestStripes>;
+
+  uint64_t hmac_key_;
+  size_t last_size_ = 0;
+  Digest last_digest_ = {};
+  uint8_t last_key_[32] = {};
+};
 
 CORE_EXPORT blink::WebContentSettingsClient* GetContentSettingsClientFor(
     ExecutionContext* context);
@@ -43,8 +107,10 @@ class CORE_EXPORT BraveSessionCache final
 
   static BraveSessionCache& From(ExecutionContext&);
 
-  AudioFarblingCallback GetAudioFarblingCallback(
+  AudioFarblingHelper GetAudioFarblingHelper(
       blink::WebContentSettingsClient* settings);
+  void FarbleAudioBuffer(blink::WebContentSettingsClient* settings,
+                         base::span<float> buffer);
   void PerturbPixels(blink::WebContentSettingsClient* settings,
                      const unsigned char* data,
                      size_t size);
@@ -56,6 +122,7 @@ class CORE_EXPORT BraveSessionCache final
   bool farbling_enabled_;
   uint64_t session_key_;
   uint8_t domain_key_[32];
+  CanvasKeyCache canvas_key_cache_;
 
   void PerturbPixelsInternal(const unsigned char* data, size_t size);
 };
@@ -0,0 +1,48 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_SAVINGS_FEATURES_H_
+#define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_SAVINGS_FEATURES_H_
+
+#include <stddef.h>
+
+namespace brave_perf_predictor {
+
+// Number of features of the bandwidth model. Must match |feature_count| of the
+// generated bandwidth_linreg_parameters.h, which is checked where both are
+// included.
+constexpr size_t kBandwidthFeatureCount = 213;
+
+// Positions of the page-level features in |feature_sequence|, which come first
+// and in this order. Third party features follow them.
+enum BandwidthFeatureIndex : size_t {
+  kAdblockRequests = 0,
+  kFirstMeaningfulPaint,
+  kObservedDomContentLoaded,
+  kObservedFirstVisualChange,
+  kObservedLoad,
+  kDocumentRequestCount,
+  kDocumentSize,
+  kFontRequestCount,
+  kFontSize,
+  kImageRequestCount,
+  kImageSize,
+  kMediaRequestCount,
+  kMediaSize,
+  kOtherRequestCount,
+  kOtherSize,
+  kScriptRequestCount,
+  kScriptSize,
+  kStylesheetRequestCount,
+  kStylesheetSize,
+  kThirdPartyRequestCount,
+  kThirdPartySize,
+  kTotalRequestCount,
+  kTotalSize,
+};
+
+}  // namespace brave_perf_predictor
+
+#endif  // BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_SAVINGS_FEATURES_H_
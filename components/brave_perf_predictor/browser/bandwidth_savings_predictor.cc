@@ -5,16 +5,66 @@
 
 #include "brave/components/brave_perf_predictor/browser/bandwidth_savings_predictor.h"
 
-#include <iostream>
+#include <algorithm>
+#include <utility>
+#include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
+#include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 #include "components/page_load_metrics/common/page_load_metrics.mojom.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom.h"
+#include "url/third_party/mozilla/url_parse.h"
 
 namespace brave_perf_predictor {
 
+namespace {
+
+static_assert(kBandwidthFeatureCount == static_cast<size_t>(feature_count),
+              "kBandwidthFeatureCount doesn't match the model");
+
+constexpr base::StringPiece kThirdPartyFeaturePrefix = "thirdParties.";
+constexpr base::StringPiece kThirdPartyFeatureSuffix = ".blocked";
+
+// Maps third party entity names to the index of their "blocked" feature.
+const base::flat_map<std::string, size_t>& GetThirdPartyFeatureIndices() {
+  static const base::NoDestructor<base::flat_map<std::string, size_t>>
+      indices([] {
+        std::vector<std::pair<std::string, size_t>> entries;
+        for (size_t i = kTotalSize + 1; i < feature_count; i++) {
+          const base::StringPiece name = feature_sequence[i];
+          if (base::StartsWith(name, kThirdPartyFeaturePrefix) &&
+              base::EndsWith(name, kThirdPartyFeatureSuffix)) {
+            entries.emplace_back(
+                std::string(name.substr(
+                    kThirdPartyFeaturePrefix.size(),
+                    name.size() - kThirdPartyFeaturePrefix.size() -
+                        kThirdPartyFeatureSuffix.size())),
+                i);
+          }
+        }
+        return base::flat_map<std::string, size_t>(std::move(entries));
+      }());
+  return *indices;
+}
+
+// Blocked resources are reported with their canonical spec, so the host can
+// be taken from it as is, without building a GURL for each of them.
+base::StringPiece GetHostPiece(base::StringPiece spec) {
+  url::Parsed parsed;
+  url::ParseStandardURL(spec.data(), spec.size(), &parsed);
+  if (!parsed.host.is_nonempty())
+    return base::StringPiece();
+  return spec.substr(parsed.host.begin, parsed.host.len);
+}
+
+}  // namespace
+
 BandwidthSavingsPredictor::BandwidthSavingsPredictor(
     const NamedThirdPartyRegistry* registry)
     : tp_registry_(registry) {}
@@ -25,34 +75,39 @@ void BandwidthSavingsPredictor::OnPageLoadTimingUpdated(
     const page_load_metrics::mojom::PageLoadTiming& timing) {
   // First meaningful paint
   if (timing.paint_timing->first_meaningful_paint.has_value())
-    feature_map_["metrics.firstMeaningfulPaint"] =
+    features_[kFirstMeaningfulPaint] =
         timing.paint_timing->first_meaningful_paint.value().InMillisecondsF();
 
   // DOM Content Loaded
   if (timing.document_timing->dom_content_loaded_event_start.has_value())
-    feature_map_["metrics.observedDomContentLoaded"] =
+    features_[kObservedDomContentLoaded] =
         timing.document_timing->dom_content_loaded_event_start.value()
             .InMillisecondsF();
 
   // First contentful paint
   if (timing.paint_timing->first_contentful_paint.has_value())
-    feature_map_["metrics.observedFirstVisualChange"] =
+    features_[kObservedFirstVisualChange] =
         timing.paint_timing->first_contentful_paint.value().InMillisecondsF();
 
   // Load
   if (timing.document_timing->load_event_start.has_value())
-    feature_map_["metrics.observedLoad"] =
+    features_[kObservedLoad] =
         timing.document_timing->load_event_start.value().InMillisecondsF();
 }
 
 void BandwidthSavingsPredictor::OnSubresourceBlocked(
     const std::string& resource_url) {
-  feature_map_["adblockRequests"] += 1;
+  features_[kAdblockRequests] += 1;
 
   if (tp_registry_) {
-    const auto tp_name = tp_registry_->GetThirdParty(resource_url);
-    if (tp_name.has_value())
-      feature_map_["thirdParties." + tp_name.value() + ".blocked"] = 1;
+    const auto tp_name =
+        tp_registry_->GetThirdPartyForHost(GetHostPiece(resource_url));
+    if (tp_name.has_value()) {
+      const auto& indices = GetThirdPartyFeatureIndices();
+      const auto it = indices.find(tp_name.value());
+      if (it != indices.end())
+        features_[it->second] = 1;
+    }
   }
 }
 
@@ -73,47 +128,45 @@ void BandwidthSavingsPredictor::OnResourceLoadComplete(
           net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
 
   if (is_third_party) {
-    feature_map_["resources.third-party.requestCount"] += 1;
-    feature_map_["resources.third-party.size"] +=
-        resource_load_info.raw_body_bytes;
+    features_[kThirdPartyRequestCount] += 1;
+    features_[kThirdPartySize] += resource_load_info.raw_body_bytes;
   }
 
-  feature_map_["resources.total.requestCount"] += 1;
-  feature_map_["resources.total.size"] += resource_load_info.raw_body_bytes;
-  feature_map_["transfer.total.size"] +=
-      resource_load_info.total_received_bytes;
-  std::string resource_type;
+  features_[kTotalRequestCount] += 1;
+  features_[kTotalSize] += resource_load_info.raw_body_bytes;
+  transfer_size_ += resource_load_info.total_received_bytes;
+  // Each resource type has its request count followed by its size.
+  size_t resource_type;
   switch (resource_load_info.request_destination) {
     case network::mojom::RequestDestination::kDocument:
-      resource_type = "document";
+      resource_type = kDocumentRequestCount;
       break;
     case network::mojom::RequestDestination::kIframe:
-      resource_type = "document";
+      resource_type = kDocumentRequestCount;
       break;
     case network::mojom::RequestDestination::kStyle:
-      resource_type = "stylesheet";
+      resource_type = kStylesheetRequestCount;
       break;
     case network::mojom::RequestDestination::kScript:
-      resource_type = "script";
+      resource_type = kScriptRequestCount;
       break;
     case network::mojom::RequestDestination::kImage:
-      resource_type = "image";
+      resource_type = kImageRequestCount;
       break;
     case network::mojom::RequestDestination::kFont:
-      resource_type = "font";
+      resource_type = kFontRequestCount;
       break;
     case network::mojom::RequestDestination::kAudio:
     case network::mojom::RequestDestination::kTrack:
     case network::mojom::RequestDestination::kVideo:
-      resource_type = "media";
+      resource_type = kMediaRequestCount;
       break;
     default:
-      resource_type = "other";
+      resource_type = kOtherRequestCount;
       break;
   }
-  feature_map_["resources." + resource_type + ".requestCount"] += 1;
-  feature_map_["resources." + resource_type + ".size"] +=
-      resource_load_info.raw_body_bytes;
+  features_[resource_type] += 1;
+  features_[resource_type + 1] += resource_load_info.raw_body_bytes;
 }
 
 double BandwidthSavingsPredictor::PredictSavingsBytes() const {
@@ -121,38 +174,47 @@ double BandwidthSavingsPredictor::PredictSavingsBytes() const {
       !main_frame_url_.SchemeIsHTTPOrHTTPS()) {
     return 0;
   }
-  const auto total_size = feature_map_.find("transfer.total.size");
-  if (total_size != feature_map_.end() && total_size->second > 0) {
-    VLOG(2) << main_frame_url_ << " total download size " << total_size->second
+  if (transfer_size_ > 0) {
+    VLOG(2) << main_frame_url_ << " total download size " << transfer_size_
             << " bytes";
   } else {
     return 0;
   }
 
   // Short-circuit if nothing got blocked
-  const auto adblock_requests = feature_map_.find("adblockRequests");
-  if (adblock_requests == feature_map_.end() || adblock_requests->second < 1) {
+  if (features_[kAdblockRequests] < 1) {
     return 0;
   }
   if (VLOG_IS_ON(3)) {
     VLOG(3) << "Predicting on feature map:";
-    for (const auto& feature : feature_map_) {
-      VLOG(3) << feature.first << " :: " << feature.second;
+    for (size_t i = 0; i < feature_count; i++) {
+      if (features_[i] != 0)
+        VLOG(3) << feature_sequence[i] << " :: " << features_[i];
     }
   }
-  double prediction = ::brave_perf_predictor::LinregPredictNamed(feature_map_);
+  double prediction = ::brave_perf_predictor::LinregPredictVector(features_);
   VLOG(2) << main_frame_url_ << " estimated saving " << prediction << " bytes";
   // Sanity check for predicted saving
   if (prediction > kSavingsAbsoluteOutlier &&
-      (prediction / kOutlierThreshold) > total_size->second) {
+      (prediction / kOutlierThreshold) > transfer_size_) {
     return 0;
   }
   return prediction;
 }
 
 void BandwidthSavingsPredictor::Reset() {
-  feature_map_.clear();
+  features_.fill(0);
+  transfer_size_ = 0;
   main_frame_url_ = {};
 }
 
+double BandwidthSavingsPredictor::GetFeatureForTesting(
+    const std::string& name) const {
+  const auto it =
+      std::find(feature_sequence.begin(), feature_sequence.end(), name);
+  if (it == feature_sequence.end())
+    return 0;
+  return features_[it - feature_sequence.begin()];
+}
+
 }  // namespace brave_perf_predictor
@@ -6,10 +6,10 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_SAVINGS_PREDICTOR_H_
 #define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_SAVINGS_PREDICTOR_H_
 
+#include <array>
 #include <string>
 
-#include "base/containers/flat_map.h"
-#include "base/gtest_prod_util.h"
+#include "brave/components/brave_perf_predictor/browser/bandwidth_savings_features.h"
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 #include "url/gurl.h"
 
@@ -56,15 +56,17 @@ class BandwidthSavingsPredictor {
   double PredictSavingsBytes() const;
   void Reset();
 
- private:
-  FRIEND_TEST_ALL_PREFIXES(BandwidthSavingsPredictorTest, FeaturiseBlocked);
-  FRIEND_TEST_ALL_PREFIXES(BandwidthSavingsPredictorTest, FeaturiseTiming);
-  FRIEND_TEST_ALL_PREFIXES(BandwidthSavingsPredictorTest,
-                           FeaturiseResourceLoading);
+  // Returns the value of the model feature called |name|, or 0 if the model
+  // doesn't use it.
+  double GetFeatureForTesting(const std::string& name) const;
 
+ private:
   GURL main_frame_url_;
   const NamedThirdPartyRegistry* tp_registry_;  // not owned
-  base::flat_map<std::string, double> feature_map_;
+  // Features in the order expected by the model, see |feature_sequence|.
+  std::array<double, kBandwidthFeatureCount> features_{};
+  // Not a model feature, only used to sanity check predictions.
+  double transfer_size_ = 0;
 };
 
 }  // namespace brave_perf_predictor
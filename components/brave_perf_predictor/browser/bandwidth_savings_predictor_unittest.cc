@@ -6,11 +6,13 @@
 #include "brave/components/brave_perf_predictor/browser/bandwidth_savings_predictor.h"
 
 #include <memory>
+#include <string>
 
-#include "base/containers/flat_map.h"
 #include "base/run_loop.h"
 #include "base/test/task_environment.h"
 #include "base/time/time.h"
+#include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
+#include "brave/components/brave_perf_predictor/browser/bandwidth_savings_features.h"
 #include "chrome/browser/predictors/loading_test_util.h"
 #include "components/page_load_metrics/common/page_load_metrics.mojom.h"
 #include "components/page_load_metrics/common/page_load_timing.h"
@@ -32,52 +34,104 @@ class BandwidthSavingsPredictorTest : public ::testing::Test {
   }
 
  protected:
+  double GetFeature(const std::string& name) const {
+    return predictor_->GetFeatureForTesting(name);
+  }
+
   base::test::TaskEnvironment env_;
   std::unique_ptr<NamedThirdPartyRegistry> tp_registry_;
   std::unique_ptr<BandwidthSavingsPredictor> predictor_;
 };
 
+TEST(BandwidthSavingsFeaturesTest, MatchModelFeatureSequence) {
+  // The predictor fills features by index, which must follow the order of the
+  // generated model.
+  EXPECT_EQ(feature_sequence[kAdblockRequests], "adblockRequests");
+  EXPECT_EQ(feature_sequence[kFirstMeaningfulPaint],
+            "metrics.firstMeaningfulPaint");
+  EXPECT_EQ(feature_sequence[kObservedDomContentLoaded],
+            "metrics.observedDomContentLoaded");
+  EXPECT_EQ(feature_sequence[kObservedFirstVisualChange],
+            "metrics.observedFirstVisualChange");
+  EXPECT_EQ(feature_sequence[kObservedLoad], "metrics.observedLoad");
+  EXPECT_EQ(feature_sequence[kDocumentRequestCount],
+            "resources.document.requestCount");
+  EXPECT_EQ(feature_sequence[kDocumentSize], "resources.document.size");
+  EXPECT_EQ(feature_sequence[kFontRequestCount],
+            "resources.font.requestCount");
+  EXPECT_EQ(feature_sequence[kFontSize], "resources.font.size");
+  EXPECT_EQ(feature_sequence[kImageRequestCount],
+            "resources.image.requestCount");
+  EXPECT_EQ(feature_sequence[kImageSize], "resources.image.size");
+  EXPECT_EQ(feature_sequence[kMediaRequestCount],
+            "resources.media.requestCount");
+  EXPECT_EQ(feature_sequence[kMediaSize], "resources.media.size");
+  EXPECT_EQ(feature_sequence[kOtherRequestCount],
+            "resources.other.requestCount");
+  EXPECT_EQ(feature_sequence[kOtherSize], "resources.other.size");
+  EXPECT_EQ(feature_sequence[kScriptRequestCount],
+            "resources.script.requestCount");
+  EXPECT_EQ(feature_sequence[kScriptSize], "resources.script.size");
+  EXPECT_EQ(feature_sequence[kStylesheetRequestCount],
+            "resources.stylesheet.requestCount");
+  EXPECT_EQ(feature_sequence[kStylesheetSize], "resources.stylesheet.size");
+  EXPECT_EQ(feature_sequence[kThirdPartyRequestCount],
+            "resources.third-party.requestCount");
+  EXPECT_EQ(feature_sequence[kThirdPartySize], "resources.third-party.size");
+  EXPECT_EQ(feature_sequence[kTotalRequestCount],
+            "resources.total.requestCount");
+  EXPECT_EQ(feature_sequence[kTotalSize], "resources.total.size");
+  // Only third party features follow.
+  for (size_t i = kTotalSize + 1; i < kBandwidthFeatureCount; i++)
+    EXPECT_EQ(feature_sequence[i].find("thirdParties."), 0u);
+}
+
 TEST_F(BandwidthSavingsPredictorTest, FeaturiseBlocked) {
   predictor_->OnSubresourceBlocked("https://google-analytics.com");
-  EXPECT_EQ(predictor_->feature_map_["adblockRequests"], 1);
-  EXPECT_EQ(predictor_->feature_map_["thirdParties.Google Analytics.blocked"],
+  EXPECT_EQ(GetFeature("adblockRequests"), 1);
+  EXPECT_EQ(GetFeature("thirdParties.Google Analytics.blocked"),
             1);
   predictor_->OnSubresourceBlocked("https://test.m.facebook.com");
-  EXPECT_EQ(predictor_->feature_map_["adblockRequests"], 2);
+  EXPECT_EQ(GetFeature("adblockRequests"), 2);
+
+  // Unknown hosts and invalid URLs only count as blocked requests.
+  predictor_->OnSubresourceBlocked("https://example.com/ad.js");
+  predictor_->OnSubresourceBlocked("not a url");
+  EXPECT_EQ(GetFeature("adblockRequests"), 4);
 }
 
 TEST_F(BandwidthSavingsPredictorTest, FeaturiseTiming) {
   const auto empty_timing = page_load_metrics::CreatePageLoadTiming();
   predictor_->OnPageLoadTimingUpdated(*empty_timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.firstMeaningfulPaint"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedDomContentLoaded"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedFirstVisualChange"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedLoad"], 0);
+  EXPECT_EQ(GetFeature("metrics.firstMeaningfulPaint"), 0);
+  EXPECT_EQ(GetFeature("metrics.observedDomContentLoaded"), 0);
+  EXPECT_EQ(GetFeature("metrics.observedFirstVisualChange"), 0);
+  EXPECT_EQ(GetFeature("metrics.observedLoad"), 0);
 
   auto timing = page_load_metrics::CreatePageLoadTiming();
   timing->document_timing->dom_content_loaded_event_start =
       base::TimeDelta::FromMilliseconds(1000);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedDomContentLoaded"], 1000);
+  EXPECT_EQ(GetFeature("metrics.observedDomContentLoaded"), 1000);
 
   timing->document_timing->load_event_start =
       base::TimeDelta::FromMilliseconds(2000);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedLoad"], 2000);
+  EXPECT_EQ(GetFeature("metrics.observedLoad"), 2000);
 
   timing->paint_timing->first_meaningful_paint =
       base::TimeDelta::FromMilliseconds(1500);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.firstMeaningfulPaint"], 1500);
+  EXPECT_EQ(GetFeature("metrics.firstMeaningfulPaint"), 1500);
 
   timing->paint_timing->first_contentful_paint =
       base::TimeDelta::FromMilliseconds(800);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedFirstVisualChange"], 800);
+  EXPECT_EQ(GetFeature("metrics.observedFirstVisualChange"), 800);
 }
 
 TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
-  EXPECT_EQ(predictor_->feature_map_["resources.third-party.requestCount"], 0);
+  EXPECT_EQ(GetFeature("resources.third-party.requestCount"), 0);
 
   const GURL main_frame("https://brave.com/");
 
@@ -86,9 +140,9 @@ TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
       network::mojom::RequestDestination::kStyle);
   fp_style->raw_body_bytes = 1000;
   predictor_->OnResourceLoadComplete(main_frame, *fp_style);
-  EXPECT_EQ(predictor_->feature_map_["resources.third-party.requestCount"], 0);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.size"], 1000);
+  EXPECT_EQ(GetFeature("resources.third-party.requestCount"), 0);
+  EXPECT_EQ(GetFeature("resources.stylesheet.requestCount"), 1);
+  EXPECT_EQ(GetFeature("resources.stylesheet.size"), 1000);
 
   auto tp_style = predictors::CreateResourceLoadInfo(
       "https://stackpath.bootstrapcdn.com/bootstrap/4.4.1/css/bootstrap.min.js",
@@ -96,14 +150,43 @@ TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
   tp_style->raw_body_bytes = 1001;
   predictor_->OnResourceLoadComplete(main_frame, *tp_style);
 
-  EXPECT_EQ(predictor_->feature_map_["resources.third-party.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.script.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.size"], 1000);
-  EXPECT_EQ(predictor_->feature_map_["resources.script.size"], 1001);
+  EXPECT_EQ(GetFeature("resources.third-party.requestCount"), 1);
+  EXPECT_EQ(GetFeature("resources.stylesheet.requestCount"), 1);
+  EXPECT_EQ(GetFeature("resources.script.requestCount"), 1);
+  EXPECT_EQ(GetFeature("resources.stylesheet.size"), 1000);
+  EXPECT_EQ(GetFeature("resources.script.size"), 1001);
 
-  EXPECT_EQ(predictor_->feature_map_["resources.total.requestCount"], 2);
-  EXPECT_EQ(predictor_->feature_map_["resources.total.size"], 2001);
+  EXPECT_EQ(GetFeature("resources.total.requestCount"), 2);
+  EXPECT_EQ(GetFeature("resources.total.size"), 2001);
+}
+
+TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceTypes) {
+  const GURL main_frame("https://brave.com/");
+  const struct {
+    network::mojom::RequestDestination destination;
+    const char* type;
+  } kResourceTypes[] = {
+      {network::mojom::RequestDestination::kDocument, "document"},
+      {network::mojom::RequestDestination::kFont, "font"},
+      {network::mojom::RequestDestination::kImage, "image"},
+      {network::mojom::RequestDestination::kVideo, "media"},
+      {network::mojom::RequestDestination::kEmpty, "other"},
+  };
+
+  for (const auto& resource_type : kResourceTypes) {
+    auto resource = predictors::CreateResourceLoadInfo(
+        "https://brave.com/resource", resource_type.destination);
+    resource->raw_body_bytes = 100;
+    predictor_->OnResourceLoadComplete(main_frame, *resource);
+    EXPECT_EQ(GetFeature(std::string("resources.") + resource_type.type +
+                         ".requestCount"),
+              1)
+        << resource_type.type;
+    EXPECT_EQ(
+        GetFeature(std::string("resources.") + resource_type.type + ".size"),
+        100)
+        << resource_type.type;
+  }
 }
 
 TEST_F(BandwidthSavingsPredictorTest, PredictZeroNoData) {
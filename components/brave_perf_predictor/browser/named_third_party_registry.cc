@@ -5,7 +5,9 @@
 
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 
-#include <tuple>
+#include <algorithm>
+#include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/containers/flat_set.h"
@@ -13,7 +15,6 @@
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/strings/string_piece.h"
-#include "base/strings/string_util.h"
 #include "base/task/post_task.h"
 #include "base/task/thread_pool.h"
 #include "base/values.h"
@@ -28,12 +29,29 @@ namespace brave_perf_predictor {
 
 namespace {
 
-std::tuple<base::flat_map<std::string, std::string>,
-           base::flat_map<std::string, std::string>>
-ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
-  base::flat_map<std::string, std::string> entity_by_domain;
-  base::flat_map<std::string, std::string> entity_by_root_domain;
+using EntityId = NamedThirdPartyRegistry::EntityId;
+using EntityMappings = NamedThirdPartyRegistry::EntityMappings;
 
+// Allocation-free equivalent of
+// net::registry_controlled_domains::GetDomainAndRegistry() for a canonical
+// host. Returns an empty piece if |host| has no registrable domain.
+base::StringPiece GetDomainAndRegistry(const base::StringPiece host) {
+  const size_t registry_length =
+      net::registry_controlled_domains::PermissiveGetHostRegistryLength(
+          host, net::registry_controlled_domains::EXCLUDE_UNKNOWN_REGISTRIES,
+          net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+  if (registry_length == std::string::npos || registry_length == 0 ||
+      registry_length + 2 > host.length())
+    return base::StringPiece();
+
+  const size_t dot = host.rfind('.', host.length() - registry_length - 2);
+  if (dot == base::StringPiece::npos)
+    return host;
+  return host.substr(dot + 1);
+}
+
+EntityMappings ParseMappings(const base::StringPiece entities,
+                             bool discard_irrelevant) {
   // Parse the JSON
   absl::optional<base::Value> document = base::JSONReader::Read(entities);
   if (!document || !document->is_list()) {
@@ -41,9 +59,13 @@ ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
     return {};
   }
 
-  // Collect the mappings
+  // Collect the mappings. The maps are built in one go at the end, inserting
+  // into them one by one would be quadratic.
+  EntityMappings mappings;
+  std::vector<std::pair<std::string, EntityId>> entity_by_domain;
+  std::vector<std::pair<std::string, EntityId>> entity_by_root_domain;
   for (auto& entity : document->GetList()) {
-    const std::string* entity_name = entity.FindStringPath("name");
+    std::string* entity_name = entity.FindStringPath("name");
     if (!entity_name)
       continue;
     if (discard_irrelevant && !relevant_entity_set.contains(*entity_name)) {
@@ -54,40 +76,60 @@ ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
     if (!entity_domains)
       continue;
 
+    const EntityId entity_id = mappings.entities.size();
+    mappings.entities.push_back(std::move(*entity_name));
+
     for (auto& entity_domain_it : entity_domains->GetList()) {
       if (!entity_domain_it.is_string()) {
         continue;
       }
-      const base::StringPiece entity_domain(entity_domain_it.GetString());
-
-      const auto inserted =
-          entity_by_domain.emplace(entity_domain, *entity_name);
-      if (!inserted.second) {
-        VLOG(2) << "Malformed data: duplicate domain " << entity_domain;
+      const std::string& entity_domain = entity_domain_it.GetString();
+
+      entity_by_domain.emplace_back(entity_domain, entity_id);
+      const base::StringPiece root_domain =
+          GetDomainAndRegistry(entity_domain);
+      if (!root_domain.empty()) {
+        entity_by_root_domain.emplace_back(std::string(root_domain),
+                                           entity_id);
       }
-      auto root_domain = net::registry_controlled_domains::GetDomainAndRegistry(
-          entity_domain,
-          net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+    }
+  }
 
-      auto root_entity_entry = entity_by_root_domain.find(root_domain);
-      if (root_entity_entry != entity_by_root_domain.end() &&
-          root_entity_entry->second != *entity_name) {
-        // If there is a clash at root domain level, neither is correct
-        entity_by_root_domain.erase(root_entity_entry);
-      } else {
-        entity_by_root_domain.emplace(root_domain, *entity_name);
-      }
+  // Keeps the first entity of duplicate domains.
+  const size_t domain_count = entity_by_domain.size();
+  mappings.entity_by_domain =
+      base::flat_map<std::string, EntityId>(std::move(entity_by_domain));
+  if (mappings.entity_by_domain.size() != domain_count) {
+    VLOG(2) << "Malformed data: "
+            << domain_count - mappings.entity_by_domain.size()
+            << " duplicate domains";
+  }
+
+  // If there is a clash at root domain level, neither is correct
+  std::stable_sort(
+      entity_by_root_domain.begin(), entity_by_root_domain.end(),
+      [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+  std::vector<std::pair<std::string, EntityId>> unique_entity_by_root_domain;
+  for (auto it = entity_by_root_domain.begin();
+       it != entity_by_root_domain.end();) {
+    auto next = it + 1;
+    bool clash = false;
+    for (; next != entity_by_root_domain.end() && next->first == it->first;
+         ++next) {
+      clash |= next->second != it->second;
     }
+    if (!clash)
+      unique_entity_by_root_domain.push_back(std::move(*it));
+    it = next;
   }
+  mappings.entity_by_root_domain = base::flat_map<std::string, EntityId>(
+      base::sorted_unique, std::move(unique_entity_by_root_domain));
 
-  entity_by_domain.shrink_to_fit();
-  entity_by_root_domain.shrink_to_fit();
-  return std::make_tuple(entity_by_domain, entity_by_root_domain);
+  mappings.entities.shrink_to_fit();
+  return mappings;
 }
 
-std::tuple<base::flat_map<std::string, std::string>,
-           base::flat_map<std::string, std::string>>
-ParseFromResource(int resource_id) {
+EntityMappings ParseFromResource(int resource_id) {
   // TODO(AndriusA): insert trace event here
   SCOPED_UMA_HISTOGRAM_TIMER(
       "Brave.Savings.NamedThirdPartyRegistry.LoadTimeMS");
@@ -100,32 +142,38 @@ ParseFromResource(int resource_id) {
 
 }  // namespace
 
+NamedThirdPartyRegistry::EntityMappings::EntityMappings() = default;
+NamedThirdPartyRegistry::EntityMappings::~EntityMappings() = default;
+NamedThirdPartyRegistry::EntityMappings::EntityMappings(EntityMappings&&) =
+    default;
+NamedThirdPartyRegistry::EntityMappings&
+NamedThirdPartyRegistry::EntityMappings::operator=(EntityMappings&&) =
+    default;
+
 bool NamedThirdPartyRegistry::LoadMappings(const base::StringPiece entities,
                                            bool discard_irrelevant) {
   // Reset previous mappings
-  entity_by_domain_.clear();
-  entity_by_root_domain_.clear();
+  mappings_ = EntityMappings();
   initialized_ = false;
 
-  tie(entity_by_domain_, entity_by_root_domain_) =
-      ParseMappings(entities, discard_irrelevant);
-  if (entity_by_domain_.size() == 0 || entity_by_root_domain_.size() == 0)
+  mappings_ = ParseMappings(entities, discard_irrelevant);
+  if (mappings_.entity_by_domain.empty() ||
+      mappings_.entity_by_root_domain.empty())
     return false;
 
   initialized_ = true;
   return true;
 }
 
-void NamedThirdPartyRegistry::UpdateMappings(
-    std::tuple<base::flat_map<std::string, std::string>,
-               base::flat_map<std::string, std::string>> entity_mappings) {
-  tie(entity_by_domain_, entity_by_root_domain_) = entity_mappings;
-  VLOG(2) << "Loaded " << entity_by_domain_.size() << " mappings by domain and "
-          << entity_by_root_domain_.size() << " by root domain; size";
+void NamedThirdPartyRegistry::UpdateMappings(EntityMappings entity_mappings) {
+  mappings_ = std::move(entity_mappings);
+  VLOG(2) << "Loaded " << mappings_.entities.size() << " entities with "
+          << mappings_.entity_by_domain.size() << " mappings by domain and "
+          << mappings_.entity_by_root_domain.size() << " by root domain";
   initialized_ = true;
 }
 
-absl::optional<std::string> NamedThirdPartyRegistry::GetThirdParty(
+absl::optional<base::StringPiece> NamedThirdPartyRegistry::GetThirdParty(
     const base::StringPiece request_url) const {
   if (!IsInitialized()) {
     VLOG(2) << "Named Third Party Registry not initialized";
@@ -133,21 +181,29 @@ absl::optional<std::string> NamedThirdPartyRegistry::GetThirdParty(
   }
 
   const GURL url(request_url);
-  if (!url.is_valid())
+  if (!url.is_valid() || !url.has_host())
     return absl::nullopt;
 
-  if (url.has_host()) {
-    auto domain_entry = entity_by_domain_.find(url.host());
-    if (domain_entry != entity_by_domain_.end())
-      return domain_entry->second;
+  return GetThirdPartyForHost(url.host_piece());
+}
 
-    auto root_domain = net::registry_controlled_domains::GetDomainAndRegistry(
-        url, net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+absl::optional<base::StringPiece>
+NamedThirdPartyRegistry::GetThirdPartyForHost(
+    const base::StringPiece host) const {
+  if (!IsInitialized() || host.empty())
+    return absl::nullopt;
 
-    auto root_domain_entry = entity_by_root_domain_.find(root_domain);
-    if (root_domain_entry != entity_by_root_domain_.end())
-      return root_domain_entry->second;
-  }
+  auto domain_entry = mappings_.entity_by_domain.find(host);
+  if (domain_entry != mappings_.entity_by_domain.end())
+    return base::StringPiece(mappings_.entities[domain_entry->second]);
+
+  const base::StringPiece root_domain = GetDomainAndRegistry(host);
+  if (root_domain.empty())
+    return absl::nullopt;
+
+  auto root_domain_entry = mappings_.entity_by_root_domain.find(root_domain);
+  if (root_domain_entry != mappings_.entity_by_root_domain.end())
+    return base::StringPiece(mappings_.entities[root_domain_entry->second]);
 
   return absl::nullopt;
 }
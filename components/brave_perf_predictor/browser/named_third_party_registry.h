@@ -6,13 +6,15 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_REGISTRY_H_
 #define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_REGISTRY_H_
 
+#include <cstdint>
 #include <string>
-#include <tuple>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/memory/weak_ptr.h"
-#include "base/values.h"
+#include "base/strings/string_piece.h"
 #include "components/keyed_service/core/keyed_service.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace brave_perf_predictor {
 
@@ -21,6 +23,22 @@ namespace brave_perf_predictor {
 // (https://github.com/patrickhulce/third-party-web).
 class NamedThirdPartyRegistry : public KeyedService {
  public:
+  // Index of an entity name in |EntityMappings::entities|.
+  using EntityId = uint32_t;
+
+  // Entity names are stored once and domains map to their index, rather than
+  // each domain holding a copy of the name.
+  struct EntityMappings {
+    EntityMappings();
+    ~EntityMappings();
+    EntityMappings(EntityMappings&&);
+    EntityMappings& operator=(EntityMappings&&);
+
+    std::vector<std::string> entities;
+    base::flat_map<std::string, EntityId> entity_by_domain;
+    base::flat_map<std::string, EntityId> entity_by_root_domain;
+  };
+
   NamedThirdPartyRegistry();
   ~NamedThirdPartyRegistry() override;
 
@@ -33,19 +51,22 @@ class NamedThirdPartyRegistry : public KeyedService {
   bool LoadMappings(const base::StringPiece entities, bool discard_irrelevant);
   // Default initialization - asynchronously load from bundled resource
   void InitializeDefault();
-  absl::optional<std::string> GetThirdParty(
-      const base::StringPiece domain) const;
+  // Returns the entity for |request_url|. The returned name is owned by the
+  // registry and stays valid until the mappings are reloaded.
+  absl::optional<base::StringPiece> GetThirdParty(
+      const base::StringPiece request_url) const;
+  // Same as GetThirdParty(), for an already canonicalized |host|. Does not
+  // allocate.
+  absl::optional<base::StringPiece> GetThirdPartyForHost(
+      const base::StringPiece host) const;
 
  private:
   bool IsInitialized() const { return initialized_; }
   void MarkInitialized(bool initialized) { initialized_ = initialized; }
-  void UpdateMappings(
-      std::tuple<base::flat_map<std::string, std::string>,
-                 base::flat_map<std::string, std::string>> entity_mappings);
+  void UpdateMappings(EntityMappings entity_mappings);
 
   bool initialized_ = false;
-  base::flat_map<std::string, std::string> entity_by_domain_;
-  base::flat_map<std::string, std::string> entity_by_root_domain_;
+  EntityMappings mappings_;
 
   base::WeakPtrFactory<NamedThirdPartyRegistry> weak_factory_{this};
 };
@@ -119,4 +119,38 @@ TEST(NamedThirdPartyRegistryTest, HandlesUnrecognisedThirdPartyTest) {
   EXPECT_FALSE(entity.has_value());
 }
 
+TEST(NamedThirdPartyRegistryTest, ExtractsThirdPartyForHostTest) {
+  NamedThirdPartyRegistry* extractor = new NamedThirdPartyRegistry();
+  extractor->LoadMappings(test_mapping, false);
+
+  auto entity = extractor->GetThirdPartyForHost("ssl.google-analytics.com");
+  ASSERT_TRUE(entity.has_value());
+  EXPECT_EQ(entity.value(), "Google Analytics");
+
+  entity = extractor->GetThirdPartyForHost("test.connect.facebook.net");
+  ASSERT_TRUE(entity.has_value());
+  EXPECT_EQ(entity.value(), "Facebook");
+
+  EXPECT_FALSE(extractor->GetThirdPartyForHost("23.62.3.184").has_value());
+  EXPECT_FALSE(extractor->GetThirdPartyForHost("").has_value());
+}
+
+TEST(NamedThirdPartyRegistryTest, DropsClashingRootDomainsTest) {
+  NamedThirdPartyRegistry* extractor = new NamedThirdPartyRegistry();
+  constexpr char kClashingMapping[] = R"([
+    {"name":"A","domains":["a.example.com","b.example.com","a.test.com"]},
+    {"name":"B","domains":["c.example.com"]}
+  ])";
+  extractor->LoadMappings(kClashingMapping, false);
+
+  auto entity = extractor->GetThirdPartyForHost("c.example.com");
+  ASSERT_TRUE(entity.has_value());
+  EXPECT_EQ(entity.value(), "B");
+  EXPECT_FALSE(extractor->GetThirdPartyForHost("d.example.com").has_value());
+
+  entity = extractor->GetThirdPartyForHost("b.test.com");
+  ASSERT_TRUE(entity.has_value());
+  EXPECT_EQ(entity.value(), "A");
+}
+
 }  // namespace brave_perf_predictor
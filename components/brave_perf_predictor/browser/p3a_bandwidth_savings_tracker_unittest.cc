@@ -10,6 +10,7 @@
 
 #include "base/test/metrics/histogram_tester.h"
 #include "base/test/simple_test_clock.h"
+#include "base/test/task_environment.h"
 #include "base/time/time.h"
 #include "components/prefs/testing_pref_service.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -29,6 +30,7 @@ class P3ABandwidthSavingsTrackerTest : public ::testing::Test {
   }
 
  protected:
+  base::test::TaskEnvironment task_environment_;
   base::SimpleTestClock* clock_;
   TestingPrefServiceSimple pref_service_;
   std::unique_ptr<P3ABandwidthSavingsTracker> tracker_;
@@ -14,6 +14,7 @@
 #include "brave/components/brave_today/browser/publishers_parsing.h"
 #include "brave/components/brave_today/common/brave_news.mojom-forward.h"
 #include "brave/components/brave_today/common/brave_news.mojom.h"
+#include "url/gurl.h"
 
 namespace brave_news {
 
@@ -22,6 +23,11 @@ bool BuildFeed(const std::string& json,
                Publishers* publishers,
                mojom::Feed* feed);
 
+// Padded image urls of the items on the page after the one which contains
+// the |cards_viewed|th card, so that they can be fetched ahead of scrolling.
+std::vector<GURL> GetPaddedImageUrlsForNextPage(const mojom::Feed& feed,
+                                                size_t cards_viewed);
+
 // Exposed for testing:
 bool ParseFeedItemsToDisplay(const std::string& json,
                              Publishers* publishers,
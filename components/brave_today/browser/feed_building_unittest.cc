@@ -204,4 +204,43 @@ TEST(BraveNewsFeedBuilding, IncludesUserEnabledItems) {
   ASSERT_EQ(found, true);
 }
 
+TEST(BraveNewsFeedBuilding, GetPaddedImageUrlsForNextPage) {
+  auto make_page_item = [](std::vector<mojom::ImagePtr> images) {
+    auto page_item = mojom::FeedPageItem::New();
+    page_item->card_type = mojom::CardType::HEADLINE;
+    for (auto& image : images) {
+      auto metadata = mojom::FeedItemMetadata::New();
+      metadata->image = std::move(image);
+      page_item->items.push_back(mojom::FeedItem::NewArticle(
+          mojom::Article::New(std::move(metadata))));
+    }
+    return page_item;
+  };
+  mojom::Feed feed;
+  auto first_page = mojom::FeedPage::New();
+  std::vector<mojom::ImagePtr> first_images;
+  first_images.push_back(
+      mojom::Image::NewPaddedImageUrl(GURL("https://example.com/1.jpg.pad")));
+  first_page->items.push_back(make_page_item(std::move(first_images)));
+  first_page->items.push_back(make_page_item({}));
+  feed.pages.push_back(std::move(first_page));
+  auto second_page = mojom::FeedPage::New();
+  std::vector<mojom::ImagePtr> second_images;
+  second_images.push_back(
+      mojom::Image::NewPaddedImageUrl(GURL("https://example.com/2.jpg.pad")));
+  second_images.push_back(
+      mojom::Image::NewImageUrl(GURL("https://example.com/3.jpg")));
+  second_page->items.push_back(make_page_item(std::move(second_images)));
+  feed.pages.push_back(std::move(second_page));
+
+  // While on the first page, only padded images from the second page.
+  for (size_t cards_viewed : {0u, 1u}) {
+    auto image_urls = GetPaddedImageUrlsForNextPage(feed, cards_viewed);
+    ASSERT_EQ(image_urls.size(), 1u);
+    EXPECT_EQ(image_urls[0], GURL("https://example.com/2.jpg.pad"));
+  }
+  // Nothing after the last page.
+  EXPECT_TRUE(GetPaddedImageUrlsForNextPage(feed, 2u).empty());
+}
+
 }  // namespace brave_news
@@ -0,0 +1,136 @@
+// Copyright (c) 2021 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/brave_today/browser/feed_cache.h"
+
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/pickle.h"
+#include "base/task/post_task.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+
+namespace brave_news {
+
+const base::FilePath::CharType kFeedCacheFilename[] =
+    FILE_PATH_LITERAL("Brave News Feed Cache");
+
+namespace {
+
+// Bump whenever the mojom structs or the layout below change, so that caches
+// written by an older version are discarded rather than misread.
+const int kCacheVersion = 1;
+
+absl::optional<CachedFeed> LoadOnFileTaskRunner(const base::FilePath& path) {
+  std::string data;
+  if (!base::ReadFileToString(path, &data)) {
+    return absl::nullopt;
+  }
+  return DeserializeCachedFeed(data);
+}
+
+void SaveOnFileTaskRunner(const base::FilePath& path, const std::string& data) {
+  if (!base::ImportantFileWriter::WriteFileAtomically(path, data)) {
+    VLOG(1) << "Failed to write Brave News feed cache";
+  }
+}
+
+void DeleteOnFileTaskRunner(const base::FilePath& path) {
+  base::DeleteFile(path);
+}
+
+}  // namespace
+
+CachedFeed::CachedFeed() = default;
+CachedFeed::~CachedFeed() = default;
+CachedFeed::CachedFeed(CachedFeed&&) = default;
+CachedFeed& CachedFeed::operator=(CachedFeed&&) = default;
+
+std::string SerializeCachedFeed(const CachedFeed& cached_feed) {
+  DCHECK(cached_feed.feed);
+  base::Pickle pickle;
+  pickle.WriteInt(kCacheVersion);
+  pickle.WriteString(cached_feed.etag);
+  std::vector<uint8_t> feed_data = mojom::Feed::Serialize(&cached_feed.feed);
+  pickle.WriteData(reinterpret_cast<const char*>(feed_data.data()),
+                   feed_data.size());
+  pickle.WriteUInt32(cached_feed.publishers.size());
+  for (const auto& kv : cached_feed.publishers) {
+    std::vector<uint8_t> publisher_data =
+        mojom::Publisher::Serialize(&kv.second);
+    pickle.WriteData(reinterpret_cast<const char*>(publisher_data.data()),
+                     publisher_data.size());
+  }
+  return std::string(static_cast<const char*>(pickle.data()), pickle.size());
+}
+
+absl::optional<CachedFeed> DeserializeCachedFeed(base::StringPiece data) {
+  base::Pickle pickle(data.data(), data.size());
+  base::PickleIterator iter(pickle);
+  int version;
+  if (!iter.ReadInt(&version) || version != kCacheVersion) {
+    return absl::nullopt;
+  }
+  CachedFeed cached_feed;
+  const char* feed_data;
+  int feed_length;
+  if (!iter.ReadString(&cached_feed.etag) ||
+      !iter.ReadData(&feed_data, &feed_length) ||
+      !mojom::Feed::Deserialize(feed_data, feed_length, &cached_feed.feed)) {
+    return absl::nullopt;
+  }
+  uint32_t publishers_count;
+  if (!iter.ReadUInt32(&publishers_count)) {
+    return absl::nullopt;
+  }
+  std::vector<std::pair<std::string, mojom::PublisherPtr>> publishers;
+  publishers.reserve(publishers_count);
+  for (uint32_t i = 0; i < publishers_count; i++) {
+    const char* publisher_data;
+    int publisher_length;
+    mojom::PublisherPtr publisher;
+    if (!iter.ReadData(&publisher_data, &publisher_length) ||
+        !mojom::Publisher::Deserialize(publisher_data, publisher_length,
+                                       &publisher)) {
+      return absl::nullopt;
+    }
+    std::string publisher_id = publisher->publisher_id;
+    publishers.emplace_back(std::move(publisher_id), std::move(publisher));
+  }
+  // Build the map in one go rather than inserting one by one.
+  cached_feed.publishers = Publishers(std::move(publishers));
+  return cached_feed;
+}
+
+FeedCache::FeedCache(const base::FilePath& path)
+    : path_(path),
+      file_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})) {}
+
+FeedCache::~FeedCache() = default;
+
+void FeedCache::Load(LoadCallback callback) {
+  base::PostTaskAndReplyWithResult(
+      file_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&LoadOnFileTaskRunner, path_), std::move(callback));
+}
+
+void FeedCache::Save(std::string data) {
+  file_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&SaveOnFileTaskRunner, path_, std::move(data)));
+}
+
+void FeedCache::Delete() {
+  file_task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&DeleteOnFileTaskRunner, path_));
+}
+
+}  // namespace brave_news
@@ -0,0 +1,69 @@
+// Copyright (c) 2021 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_FEED_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_FEED_CACHE_H_
+
+#include <string>
+
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/strings/string_piece.h"
+#include "brave/components/brave_today/browser/publishers_controller.h"
+#include "brave/components/brave_today/common/brave_news.mojom.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace base {
+class SequencedTaskRunner;
+}  // namespace base
+
+namespace brave_news {
+
+extern const base::FilePath::CharType kFeedCacheFilename[];
+
+// The parsed feed and the publishers it was built with, along with the etag
+// of the remote feed response, as persisted between sessions.
+struct CachedFeed {
+  CachedFeed();
+  ~CachedFeed();
+  CachedFeed(CachedFeed&&);
+  CachedFeed& operator=(CachedFeed&&);
+  CachedFeed(const CachedFeed&) = delete;
+  CachedFeed& operator=(const CachedFeed&) = delete;
+
+  std::string etag;
+  mojom::FeedPtr feed;
+  Publishers publishers;
+};
+
+// Binary format of the cache file. Exposed for testing.
+std::string SerializeCachedFeed(const CachedFeed& cached_feed);
+absl::optional<CachedFeed> DeserializeCachedFeed(base::StringPiece data);
+
+// Reads and writes the cached feed file, performing all file access on a
+// background sequence.
+class FeedCache {
+ public:
+  using LoadCallback = base::OnceCallback<void(absl::optional<CachedFeed>)>;
+
+  explicit FeedCache(const base::FilePath& path);
+  ~FeedCache();
+  FeedCache(const FeedCache&) = delete;
+  FeedCache& operator=(const FeedCache&) = delete;
+
+  void Load(LoadCallback callback);
+  // |data| is the output of SerializeCachedFeed.
+  void Save(std::string data);
+  void Delete();
+
+ private:
+  const base::FilePath path_;
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
+};
+
+}  // namespace brave_news
+
+#endif  // BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_FEED_CACHE_H_
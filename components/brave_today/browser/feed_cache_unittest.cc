@@ -0,0 +1,66 @@
+// Copyright (c) 2021 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <string>
+#include <utility>
+
+#include "brave/components/brave_today/browser/feed_cache.h"
+#include "brave/components/brave_today/common/brave_news.mojom.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_news {
+
+namespace {
+
+mojom::PublisherPtr MakePublisher(const std::string& publisher_id,
+                                  mojom::UserEnabled user_enabled_status) {
+  auto publisher = mojom::Publisher::New();
+  publisher->publisher_id = publisher_id;
+  publisher->publisher_name = "Publisher " + publisher_id;
+  publisher->category_name = "Tech";
+  publisher->is_enabled = true;
+  publisher->user_enabled_status = user_enabled_status;
+  return publisher;
+}
+
+}  // namespace
+
+TEST(BraveNewsFeedCache, RoundTrip) {
+  CachedFeed cached_feed;
+  cached_feed.etag = "\"etag-1\"";
+  cached_feed.feed = mojom::Feed::New();
+  cached_feed.feed->hash = "1234";
+  cached_feed.feed->pages.push_back(mojom::FeedPage::New());
+  cached_feed.feed->pages.push_back(mojom::FeedPage::New());
+  cached_feed.publishers["111"] =
+      MakePublisher("111", mojom::UserEnabled::NOT_MODIFIED);
+  cached_feed.publishers["222"] =
+      MakePublisher("222", mojom::UserEnabled::DISABLED);
+
+  auto result = DeserializeCachedFeed(SerializeCachedFeed(cached_feed));
+  ASSERT_TRUE(result);
+  EXPECT_EQ(result->etag, "\"etag-1\"");
+  ASSERT_TRUE(result->feed);
+  EXPECT_TRUE(result->feed->Equals(*cached_feed.feed));
+  ASSERT_EQ(result->publishers.size(), 2u);
+  EXPECT_TRUE(
+      result->publishers["111"]->Equals(*cached_feed.publishers["111"]));
+  EXPECT_TRUE(
+      result->publishers["222"]->Equals(*cached_feed.publishers["222"]));
+}
+
+TEST(BraveNewsFeedCache, RejectsInvalidData) {
+  EXPECT_FALSE(DeserializeCachedFeed(""));
+  EXPECT_FALSE(DeserializeCachedFeed("not a feed cache"));
+
+  CachedFeed cached_feed;
+  cached_feed.feed = mojom::Feed::New();
+  cached_feed.feed->hash = "1234";
+  std::string data = SerializeCachedFeed(cached_feed);
+  // Truncated files, e.g. from a crash, must not be served.
+  EXPECT_FALSE(DeserializeCachedFeed(data.substr(0, data.size() - 1)));
+}
+
+}  // namespace brave_news
@@ -13,9 +13,12 @@
 #include "base/bind.h"
 #include "base/callback_forward.h"
 #include "base/one_shot_event.h"
+#include "base/task/post_task.h"
+#include "base/task/thread_pool.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/brave_private_cdn/headers.h"
 #include "brave/components/brave_today/browser/feed_building.h"
+#include "brave/components/brave_today/browser/feed_cache.h"
 #include "brave/components/brave_today/browser/publishers_controller.h"
 #include "brave/components/brave_today/browser/urls.h"
 #include "brave/components/brave_today/common/brave_news.mojom.h"
@@ -34,17 +37,47 @@ GURL GetFeedUrl() {
   return feed_url;
 }
 
+// The feed as built on a background sequence, along with its serialized form
+// ready to be written to the disk cache.
+struct BuildFeedResult {
+  mojom::FeedPtr feed;
+  std::string etag;
+  std::string serialized_cache;
+};
+
+BuildFeedResult BuildFeedOnBackgroundSequence(
+    const std::string& body,
+    const std::string& etag,
+    const std::unordered_set<std::string>& history_hosts,
+    Publishers publishers) {
+  BuildFeedResult result;
+  CachedFeed cached_feed;
+  cached_feed.feed = mojom::Feed::New();
+  if (!BuildFeed(body, history_hosts, &publishers, cached_feed.feed.get())) {
+    VLOG(1) << "ParseFeed reported failure.";
+    return result;
+  }
+  cached_feed.etag = etag;
+  cached_feed.publishers = std::move(publishers);
+  result.serialized_cache = SerializeCachedFeed(cached_feed);
+  result.feed = std::move(cached_feed.feed);
+  result.etag = etag;
+  return result;
+}
+
 }  // namespace
 
 FeedController::FeedController(
     PublishersController* publishers_controller,
     history::HistoryService* history_service,
-    api_request_helper::APIRequestHelper* api_request_helper)
+    api_request_helper::APIRequestHelper* api_request_helper,
+    const base::FilePath& cache_path)
     : publishers_controller_(publishers_controller),
       history_service_(history_service),
       api_request_helper_(api_request_helper),
       on_current_update_complete_(new base::OneShotEvent()),
-      publishers_observation_(this) {
+      publishers_observation_(this),
+      feed_cache_(cache_path) {
   publishers_observation_.Observe(publishers_controller);
 }
 
@@ -86,7 +119,14 @@ void FeedController::EnsureFeedIsUpdating() {
   if (is_update_in_progress_) {
     return;
   }
+  // Wait for the disk cache, which will either provide the feed or tell us
+  // that we still need to fetch it.
+  if (is_loading_disk_cache_) {
+    is_fetch_pending_disk_cache_ = true;
+    return;
+  }
   is_update_in_progress_ = true;
+  update_cache_generation_ = cache_generation_;
 
   // Fetch https request via callback
   // TODO(petemill): avoid callback hell when c++ allows
@@ -129,18 +169,41 @@ void FeedController::EnsureFeedIsUpdating() {
                       history_hosts.insert(host);
                     }
                     VLOG(1) << "history hosts # " << history_hosts.size();
-                    // Parse directly to in-memory property
-                    controller->ResetFeed();
-                    if (BuildFeed(body, history_hosts, &publishers,
-                                  &controller->current_feed_)) {
-                      // Only mark cache time of remote request if
-                      // parsing was successful
-                      controller->current_feed_etag_ = etag;
-                    } else {
-                      VLOG(1) << "ParseFeed reported failure.";
-                    }
-                    // Let any callbacks know that the data is ready or errored.
-                    controller->NotifyUpdateDone();
+                    // Parsing and sorting the whole feed is too slow for the
+                    // UI thread, so build it on a background sequence.
+                    base::ThreadPool::PostTaskAndReplyWithResult(
+                        FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+                        base::BindOnce(&BuildFeedOnBackgroundSequence,
+                                       std::move(body), std::move(etag),
+                                       std::move(history_hosts),
+                                       std::move(publishers)),
+                        base::BindOnce(
+                            [](base::WeakPtr<FeedController> controller,
+                               BuildFeedResult result) {
+                              if (!controller) {
+                                return;
+                              }
+                              // The cache was cleared while building, so the
+                              // result may contain data the user removed.
+                              if (controller->update_cache_generation_ !=
+                                  controller->cache_generation_) {
+                                controller->NotifyUpdateDone();
+                                return;
+                              }
+                              controller->ResetFeed();
+                              if (result.feed) {
+                                // Only mark cache time of remote request if
+                                // parsing was successful
+                                controller->SetFeed(std::move(result.feed),
+                                                    result.etag);
+                                controller->feed_cache_.Save(
+                                    std::move(result.serialized_cache));
+                              }
+                              // Let any callbacks know that the data is ready
+                              // or errored.
+                              controller->NotifyUpdateDone();
+                            },
+                            controller->weak_ptr_factory_.GetWeakPtr()));
                   },
                   base::Unretained(controller), std::move(body),
                   std::move(etag), std::move(publishers));
@@ -213,8 +276,57 @@ void FeedController::UpdateIfRemoteChanged() {
       brave::private_cdn_headers);
 }
 
+std::vector<GURL> FeedController::GetImagesToPrefetch(
+    size_t cards_viewed) const {
+  return GetPaddedImageUrlsForNextPage(current_feed_, cards_viewed);
+}
+
+void FeedController::LoadFromDiskCache() {
+  if (has_loaded_disk_cache_) {
+    return;
+  }
+  has_loaded_disk_cache_ = true;
+  // Nothing to gain from the disk cache if a fetch has already started.
+  if (is_update_in_progress_ || !current_feed_.hash.empty()) {
+    return;
+  }
+  is_loading_disk_cache_ = true;
+  feed_cache_.Load(base::BindOnce(&FeedController::OnDiskCacheLoaded,
+                                  weak_ptr_factory_.GetWeakPtr(),
+                                  cache_generation_));
+}
+
+void FeedController::OnDiskCacheLoaded(
+    uint64_t cache_generation,
+    absl::optional<CachedFeed> cached_feed) {
+  is_loading_disk_cache_ = false;
+  if (cache_generation != cache_generation_) {
+    VLOG(1) << "Brave News feed cache was cleared while loading";
+    cached_feed = absl::nullopt;
+  }
+  if (!cached_feed) {
+    VLOG(1) << "No Brave News feed cache on disk";
+    if (is_fetch_pending_disk_cache_) {
+      is_fetch_pending_disk_cache_ = false;
+      EnsureFeedIsUpdating();
+    }
+    return;
+  }
+  VLOG(1) << "Loaded Brave News feed cache, etag: " << cached_feed->etag;
+  is_fetch_pending_disk_cache_ = false;
+  publishers_controller_->SetCachedPublishers(
+      std::move(cached_feed->publishers));
+  SetFeed(std::move(cached_feed->feed), cached_feed->etag);
+  NotifyUpdateDone();
+  // The cache may be from a long time ago, so revalidate it.
+  UpdateIfRemoteChanged();
+}
+
 void FeedController::ClearCache() {
+  cache_generation_++;
   ResetFeed();
+  current_feed_etag_.clear();
+  feed_cache_.Delete();
 }
 
 void FeedController::OnPublishersUpdated(PublishersController* controller) {
@@ -238,6 +350,13 @@ void FeedController::GetOrFetchFeed(base::OnceClosure callback) {
   EnsureFeedIsUpdating();
 }
 
+void FeedController::SetFeed(mojom::FeedPtr feed, const std::string& etag) {
+  current_feed_.hash = std::move(feed->hash);
+  current_feed_.pages = std::move(feed->pages);
+  current_feed_.featured_item = std::move(feed->featured_item);
+  current_feed_etag_ = etag;
+}
+
 void FeedController::ResetFeed() {
   current_feed_.featured_item = nullptr;
   current_feed_.hash = "";
@@ -8,13 +8,18 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "base/memory/weak_ptr.h"
 #include "base/one_shot_event.h"
 #include "base/scoped_observation.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
+#include "brave/components/brave_today/browser/feed_cache.h"
 #include "brave/components/brave_today/browser/publishers_controller.h"
 #include "brave/components/brave_today/common/brave_news.mojom.h"
 #include "components/history/core/browser/history_service.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "url/gurl.h"
 
 namespace history {
 class HistoryService;
@@ -28,7 +33,8 @@ class FeedController : public PublishersController::Observer {
  public:
   FeedController(PublishersController* publishers_controller,
                  history::HistoryService* history_service,
-                 api_request_helper::APIRequestHelper* api_request_helper);
+                 api_request_helper::APIRequestHelper* api_request_helper,
+                 const base::FilePath& cache_path);
   ~FeedController() override;
   FeedController(const FeedController&) = delete;
   FeedController& operator=(const FeedController&) = delete;
@@ -47,6 +53,14 @@ class FeedController : public PublishersController::Observer {
   // parsing).
   void EnsureFeedIsCached();
   void UpdateIfRemoteChanged();
+  // Images of the page after the one the user has scrolled to, if the feed
+  // is available.
+  std::vector<GURL> GetImagesToPrefetch(size_t cards_viewed) const;
+  // Serves the feed persisted by a previous session, if any, and then checks
+  // in the background whether the remote feed has changed since. Only has an
+  // effect the first time it is called.
+  void LoadFromDiskCache();
+  // Clears both the in-memory and the on-disk feed.
   void ClearCache();
 
   // PublishersController::Observer
@@ -59,6 +73,9 @@ class FeedController : public PublishersController::Observer {
 
  private:
   void GetOrFetchFeed(base::OnceClosure callback);
+  void OnDiskCacheLoaded(uint64_t cache_generation,
+                         absl::optional<CachedFeed> cached_feed);
+  void SetFeed(mojom::FeedPtr feed, const std::string& etag);
   void ResetFeed();
   void NotifyUpdateDone();
 
@@ -78,6 +95,17 @@ class FeedController : public PublishersController::Observer {
   mojom::Feed current_feed_;
   std::string current_feed_etag_;
   bool is_update_in_progress_ = false;
+  // Bumped by ClearCache(), so that loads and updates which were already
+  // running don't bring the cleared feed back.
+  uint64_t cache_generation_ = 0;
+  uint64_t update_cache_generation_ = 0;
+  // Persists the feed so that it is available immediately on startup.
+  FeedCache feed_cache_;
+  bool has_loaded_disk_cache_ = false;
+  bool is_loading_disk_cache_ = false;
+  // Whether a fetch was requested while the disk cache was loading.
+  bool is_fetch_pending_disk_cache_ = false;
+  base::WeakPtrFactory<FeedController> weak_ptr_factory_{this};
 };
 
 }  // namespace brave_news
@@ -0,0 +1,96 @@
+// Copyright (c) 2021 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/brave_today/browser/feed_controller.h"
+
+#include <memory>
+#include <string>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "brave/components/api_request_helper/api_request_helper.h"
+#include "brave/components/brave_today/browser/feed_cache.h"
+#include "brave/components/brave_today/browser/publishers_controller.h"
+#include "brave/components/brave_today/common/brave_news.mojom.h"
+#include "brave/components/brave_today/common/pref_names.h"
+#include "components/prefs/testing_pref_service.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_news {
+
+class BraveNewsFeedControllerTest : public testing::Test {
+ public:
+  BraveNewsFeedControllerTest()
+      : api_request_helper_(
+            TRAFFIC_ANNOTATION_FOR_TESTS,
+            base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+                &url_loader_factory_)),
+        publishers_controller_(&prefs_, &api_request_helper_) {
+    prefs_.registry()->RegisterDictionaryPref(prefs::kBraveTodaySources);
+  }
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    cache_path_ = temp_dir_.GetPath().AppendASCII("feed_cache");
+
+    CachedFeed cached_feed;
+    cached_feed.etag = "\"etag-1\"";
+    cached_feed.feed = mojom::Feed::New();
+    cached_feed.feed->hash = "1234";
+    cached_feed.feed->pages.push_back(mojom::FeedPage::New());
+    const std::string data = SerializeCachedFeed(cached_feed);
+    ASSERT_TRUE(base::WriteFile(cache_path_, data));
+
+    feed_controller_ = std::make_unique<FeedController>(
+        &publishers_controller_, nullptr, &api_request_helper_, cache_path_);
+  }
+
+  // Whether the feed is available without fetching it.
+  bool HasFeed() {
+    bool has_feed = false;
+    feed_controller_->DoesFeedVersionDiffer(
+        "1234", base::BindLambdaForTesting(
+                    [&](bool differs) { has_feed = !differs; }));
+    return has_feed;
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  base::FilePath cache_path_;
+  TestingPrefServiceSimple prefs_;
+  network::TestURLLoaderFactory url_loader_factory_;
+  api_request_helper::APIRequestHelper api_request_helper_;
+  PublishersController publishers_controller_;
+  std::unique_ptr<FeedController> feed_controller_;
+};
+
+TEST_F(BraveNewsFeedControllerTest, LoadsFeedFromDiskCache) {
+  feed_controller_->LoadFromDiskCache();
+  task_environment_.RunUntilIdle();
+
+  EXPECT_TRUE(HasFeed());
+  // The cached feed is revalidated with a HEAD request.
+  EXPECT_EQ(url_loader_factory_.NumPending(), 1);
+}
+
+TEST_F(BraveNewsFeedControllerTest, ClearCacheWhileLoadingDiskCache) {
+  feed_controller_->LoadFromDiskCache();
+  // The load has been posted but has not replied yet.
+  feed_controller_->ClearCache();
+  task_environment_.RunUntilIdle();
+
+  EXPECT_FALSE(base::PathExists(cache_path_));
+  // Nothing was restored, so there is nothing to revalidate either.
+  EXPECT_EQ(url_loader_factory_.NumPending(), 0);
+  EXPECT_FALSE(HasFeed());
+}
+
+}  // namespace brave_news
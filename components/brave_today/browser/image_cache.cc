@@ -0,0 +1,188 @@
+// Copyright (c) 2021 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/brave_today/browser/image_cache.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/hash/sha1.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
+#include "base/task/post_task.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "base/time/time.h"
+
+namespace brave_news {
+
+const base::FilePath::CharType kImageCacheDirname[] =
+    FILE_PATH_LITERAL("Brave News Image Cache");
+
+namespace {
+
+const int kWritesPerDiskTrim = 25;
+
+absl::optional<std::vector<uint8_t>> ReadOnFileTaskRunner(
+    const base::FilePath& path) {
+  std::string data;
+  if (!base::ReadFileToString(path, &data)) {
+    return absl::nullopt;
+  }
+  // Reading counts as a use, for the purposes of eviction.
+  const base::Time now = base::Time::Now();
+  base::TouchFile(path, now, now);
+  return std::vector<uint8_t>(data.begin(), data.end());
+}
+
+void WriteOnFileTaskRunner(const base::FilePath& cache_dir,
+                           const base::FilePath& path,
+                           const std::vector<uint8_t>& data) {
+  if (!base::CreateDirectory(cache_dir)) {
+    return;
+  }
+  base::ImportantFileWriter::WriteFileAtomically(
+      path, base::StringPiece(reinterpret_cast<const char*>(data.data()),
+                              data.size()));
+}
+
+// Deletes the least recently used files until |cache_dir| is no larger than
+// |max_bytes|.
+void TrimOnFileTaskRunner(const base::FilePath& cache_dir, int64_t max_bytes) {
+  struct Entry {
+    base::Time last_modified;
+    int64_t size;
+    base::FilePath path;
+  };
+  std::vector<Entry> entries;
+  int64_t total_bytes = 0;
+  base::FileEnumerator enumerator(cache_dir, false,
+                                  base::FileEnumerator::FILES);
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    const auto info = enumerator.GetInfo();
+    entries.push_back({info.GetLastModifiedTime(), info.GetSize(), path});
+    total_bytes += info.GetSize();
+  }
+  if (total_bytes <= max_bytes) {
+    return;
+  }
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) {
+              return a.last_modified < b.last_modified;
+            });
+  for (const auto& entry : entries) {
+    if (total_bytes <= max_bytes) {
+      break;
+    }
+    if (base::DeleteFile(entry.path)) {
+      total_bytes -= entry.size;
+    }
+  }
+}
+
+void ClearOnFileTaskRunner(const base::FilePath& cache_dir) {
+  base::DeletePathRecursively(cache_dir);
+}
+
+}  // namespace
+
+ImageCache::ImageCache(const base::FilePath& cache_dir,
+                       size_t max_memory_bytes,
+                       int64_t max_disk_bytes)
+    : cache_dir_(cache_dir),
+      max_memory_bytes_(max_memory_bytes),
+      max_disk_bytes_(max_disk_bytes),
+      file_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})),
+      memory_cache_(
+          base::MRUCache<std::string, std::vector<uint8_t>>::NO_AUTO_EVICT) {
+  file_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&TrimOnFileTaskRunner, cache_dir_, max_disk_bytes_));
+}
+
+ImageCache::~ImageCache() = default;
+
+void ImageCache::Get(const GURL& url, GetCallback callback) {
+  const std::string key = url.spec();
+  auto it = memory_cache_.Get(key);
+  if (it != memory_cache_.end()) {
+    std::move(callback).Run(it->second);
+    return;
+  }
+  base::PostTaskAndReplyWithResult(
+      file_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&ReadOnFileTaskRunner, GetPathForKey(key)),
+      base::BindOnce(&ImageCache::OnReadFromDisk,
+                     weak_ptr_factory_.GetWeakPtr(), key, clear_count_,
+                     std::move(callback)));
+}
+
+void ImageCache::Put(const GURL& url, const std::vector<uint8_t>& data) {
+  const std::string key = url.spec();
+  AddToMemoryCache(key, data);
+  file_task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&WriteOnFileTaskRunner, cache_dir_,
+                                GetPathForKey(key), data));
+  if (++writes_since_trim_ >= kWritesPerDiskTrim) {
+    writes_since_trim_ = 0;
+    file_task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(&TrimOnFileTaskRunner, cache_dir_, max_disk_bytes_));
+  }
+}
+
+void ImageCache::Clear() {
+  memory_cache_.Clear();
+  memory_cache_bytes_ = 0;
+  writes_since_trim_ = 0;
+  // Reads already in flight must not re-populate memory.
+  clear_count_++;
+  file_task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&ClearOnFileTaskRunner, cache_dir_));
+}
+
+void ImageCache::OnReadFromDisk(const std::string& key,
+                                int clear_count,
+                                GetCallback callback,
+                                absl::optional<std::vector<uint8_t>> data) {
+  if (data && clear_count == clear_count_) {
+    AddToMemoryCache(key, *data);
+  }
+  std::move(callback).Run(std::move(data));
+}
+
+void ImageCache::AddToMemoryCache(const std::string& key,
+                                  std::vector<uint8_t> data) {
+  // Images larger than the whole budget are only kept on disk.
+  if (data.size() > max_memory_bytes_) {
+    return;
+  }
+  auto existing = memory_cache_.Peek(key);
+  if (existing != memory_cache_.end()) {
+    memory_cache_bytes_ -= existing->second.size();
+    memory_cache_.Erase(existing);
+  }
+  memory_cache_bytes_ += data.size();
+  memory_cache_.Put(key, std::move(data));
+  while (memory_cache_bytes_ > max_memory_bytes_) {
+    auto oldest = memory_cache_.rbegin();
+    memory_cache_bytes_ -= oldest->second.size();
+    memory_cache_.Erase(oldest);
+  }
+}
+
+base::FilePath ImageCache::GetPathForKey(const std::string& key) const {
+  const std::string hash = base::SHA1HashString(key);
+  return cache_dir_.AppendASCII(base::HexEncode(hash.data(), hash.size()));
+}
+
+}  // namespace brave_news
@@ -0,0 +1,161 @@
+// Copyright (c) 2021 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/brave_today/browser/image_controller.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_path.h"
+#include "base/strings/string_piece.h"
+#include "brave/components/brave_private_cdn/headers.h"
+#include "brave/components/brave_private_cdn/private_cdn_helper.h"
+
+namespace brave_news {
+
+namespace {
+
+// Thumbnails are small, so these hold a few pages' and a few days' worth of
+// feed images respectively.
+const size_t kMaxMemoryCacheBytes = 8 * 1024 * 1024;
+const int64_t kMaxDiskCacheBytes = 50 * 1024 * 1024;
+const size_t kMaxConcurrentPrefetches = 4;
+// Enough for several pages of a feed, so that a page whose images were
+// already prefetched isn't queued again.
+const size_t kMaxRecentPrefetches = 256;
+
+}  // namespace
+
+ImageController::ImageController(
+    api_request_helper::APIRequestHelper* api_request_helper,
+    const base::FilePath& cache_dir)
+    : api_request_helper_(api_request_helper),
+      image_cache_(cache_dir, kMaxMemoryCacheBytes, kMaxDiskCacheBytes),
+      recent_prefetches_(kMaxRecentPrefetches) {}
+
+ImageController::~ImageController() = default;
+
+void ImageController::GetImageData(const GURL& padded_image_url,
+                                   GetImageDataCallback callback) {
+  image_cache_.Get(padded_image_url,
+                   base::BindOnce(&ImageController::OnCacheLookup,
+                                  weak_ptr_factory_.GetWeakPtr(),
+                                  padded_image_url, std::move(callback)));
+}
+
+void ImageController::PrefetchImages(
+    const std::vector<GURL>& padded_image_urls) {
+  for (const auto& url : padded_image_urls) {
+    if (recent_prefetches_.Peek(url) != recent_prefetches_.end()) {
+      continue;
+    }
+    recent_prefetches_.Put(url, true);
+    prefetch_queue_.push_back(url);
+  }
+  while (prefetch_queue_.size() > kMaxQueuedPrefetches) {
+    auto it = recent_prefetches_.Peek(prefetch_queue_.front());
+    if (it != recent_prefetches_.end()) {
+      recent_prefetches_.Erase(it);
+    }
+    prefetch_queue_.pop_front();
+  }
+  StartPrefetches();
+}
+
+void ImageController::ClearCache() {
+  prefetch_queue_.clear();
+  recent_prefetches_.Clear();
+  image_cache_.Clear();
+}
+
+void ImageController::OnCacheLookup(
+    const GURL& padded_image_url,
+    GetImageDataCallback callback,
+    absl::optional<std::vector<uint8_t>> image_data) {
+  if (image_data) {
+    std::move(callback).Run(std::move(image_data));
+    return;
+  }
+  FetchImage(padded_image_url, std::move(callback));
+}
+
+void ImageController::FetchImage(const GURL& padded_image_url,
+                                 GetImageDataCallback callback) {
+  auto& callbacks = pending_fetches_[padded_image_url];
+  callbacks.push_back(std::move(callback));
+  // Already being fetched.
+  if (callbacks.size() > 1) {
+    return;
+  }
+  api_request_helper_->Request(
+      "GET", padded_image_url, "", "", true,
+      base::BindOnce(&ImageController::OnImageFetched,
+                     weak_ptr_factory_.GetWeakPtr(), padded_image_url),
+      brave::private_cdn_headers);
+}
+
+void ImageController::OnImageFetched(
+    const GURL& padded_image_url,
+    const int status,
+    const std::string& body,
+    const base::flat_map<std::string, std::string>& headers) {
+  absl::optional<std::vector<uint8_t>> image_data;
+  // Attempt to remove byte padding
+  base::StringPiece body_payload(body.data(), body.size());
+  if (status >= 200 && status < 300 &&
+      brave::PrivateCdnHelper::GetInstance()->RemovePadding(&body_payload)) {
+    image_data.emplace(body_payload.begin(), body_payload.end());
+    image_cache_.Put(padded_image_url, *image_data);
+  } else {
+    VLOG(1) << "Failed to fetch Brave News image, status: " << status;
+  }
+  auto it = pending_fetches_.find(padded_image_url);
+  if (it == pending_fetches_.end()) {
+    return;
+  }
+  auto callbacks = std::move(it->second);
+  pending_fetches_.erase(it);
+  for (auto& callback : callbacks) {
+    std::move(callback).Run(image_data);
+  }
+}
+
+void ImageController::StartPrefetches() {
+  while (active_prefetches_ < kMaxConcurrentPrefetches &&
+         !prefetch_queue_.empty()) {
+    GURL url = std::move(prefetch_queue_.front());
+    prefetch_queue_.pop_front();
+    // Whoever started the fetch will populate the cache.
+    if (pending_fetches_.contains(url)) {
+      continue;
+    }
+    active_prefetches_++;
+    GetImageData(
+        url, base::BindOnce(
+                 [](base::WeakPtr<ImageController> controller, const GURL& url,
+                    const absl::optional<std::vector<uint8_t>>& image_data) {
+                   if (controller) {
+                     controller->OnPrefetchDone(url, image_data.has_value());
+                   }
+                 },
+                 weak_ptr_factory_.GetWeakPtr(), url));
+  }
+}
+
+void ImageController::OnPrefetchDone(const GURL& padded_image_url,
+                                     bool success) {
+  DCHECK_GT(active_prefetches_, 0u);
+  active_prefetches_--;
+  // Allow failed images to be queued again.
+  if (!success) {
+    auto it = recent_prefetches_.Peek(padded_image_url);
+    if (it != recent_prefetches_.end()) {
+      recent_prefetches_.Erase(it);
+    }
+  }
+  StartPrefetches();
+}
+
+}  // namespace brave_news
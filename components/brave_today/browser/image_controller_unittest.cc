@@ -0,0 +1,102 @@
+// Copyright (c) 2021 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/brave_today/browser/image_controller.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "brave/components/api_request_helper/api_request_helper.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave_news {
+
+namespace {
+
+// A one byte image with its private CDN length header.
+const char kPaddedImage[] = {0, 0, 0, 1, 'x'};
+
+}  // namespace
+
+class BraveNewsImageControllerTest : public testing::Test {
+ public:
+  BraveNewsImageControllerTest()
+      : api_request_helper_(
+            TRAFFIC_ANNOTATION_FOR_TESTS,
+            base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+                &url_loader_factory_)) {}
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    image_controller_ = std::make_unique<ImageController>(
+        &api_request_helper_, temp_dir_.GetPath());
+    url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+        [&](const network::ResourceRequest& request) {
+          requested_urls_.push_back(request.url);
+        }));
+  }
+
+  // Images which the server will answer successfully.
+  std::vector<GURL> MakeImageUrls(size_t count) {
+    std::vector<GURL> urls;
+    for (size_t i = 0; i < count; i++) {
+      GURL url("https://pcdn.brave.com/" + base::NumberToString(i) + ".pad");
+      url_loader_factory_.AddResponse(
+          url.spec(), std::string(kPaddedImage, sizeof(kPaddedImage)));
+      urls.push_back(url);
+    }
+    return urls;
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  network::TestURLLoaderFactory url_loader_factory_;
+  api_request_helper::APIRequestHelper api_request_helper_;
+  std::unique_ptr<ImageController> image_controller_;
+  std::vector<GURL> requested_urls_;
+};
+
+TEST_F(BraveNewsImageControllerTest, SkipsRecentlyQueuedImages) {
+  const std::vector<GURL> urls = MakeImageUrls(2);
+  image_controller_->PrefetchImages(urls);
+  // E.g. the card views count changed again without reaching a new page.
+  image_controller_->PrefetchImages(urls);
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(requested_urls_, urls);
+
+  // Already prefetched.
+  image_controller_->PrefetchImages(urls);
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(requested_urls_.size(), 2u);
+}
+
+TEST_F(BraveNewsImageControllerTest, LimitsQueuedPrefetches) {
+  const std::vector<GURL> urls =
+      MakeImageUrls(ImageController::kMaxQueuedPrefetches * 2);
+  image_controller_->PrefetchImages(urls);
+  task_environment_.RunUntilIdle();
+  // The oldest images were dropped.
+  ASSERT_EQ(requested_urls_.size(), ImageController::kMaxQueuedPrefetches);
+  EXPECT_EQ(requested_urls_.front(),
+            urls[ImageController::kMaxQueuedPrefetches]);
+
+  // And can be queued again.
+  image_controller_->PrefetchImages({urls.front()});
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(requested_urls_.back(), urls.front());
+}
+
+}  // namespace brave_news
@@ -86,23 +86,7 @@ void PublishersController::EnsurePublishersIsUpdating() {
         Publishers publisher_list;
         ParsePublisherList(body, &publisher_list);
         // Add user enabled statuses
-        const base::DictionaryValue* publisher_prefs =
-            controller->prefs_->GetDictionary(prefs::kBraveTodaySources);
-        for (auto kv : publisher_prefs->DictItems()) {
-          auto publisher_id = kv.first;
-          auto is_user_enabled = kv.second.GetIfBool();
-          if (publisher_list.contains(publisher_id) &&
-              is_user_enabled.has_value()) {
-            publisher_list[publisher_id]->user_enabled_status =
-                (is_user_enabled.value()
-                     ? brave_news::mojom::UserEnabled::ENABLED
-                     : brave_news::mojom::UserEnabled::DISABLED);
-          } else {
-            VLOG(1) << "Publisher list did not contain publisher found in"
-                       "user prefs: "
-                    << publisher_id;
-          }
-        }
+        controller->ApplyUserEnabledPrefs(&publisher_list);
         // Set memory cache
         controller->publishers_ = std::move(publisher_list);
         // Let any callback know that the data is ready.
@@ -123,6 +107,36 @@ void PublishersController::EnsurePublishersIsUpdating() {
                                brave::private_cdn_headers);
 }
 
+void PublishersController::SetCachedPublishers(Publishers publishers) {
+  if (!publishers_.empty() || is_update_in_progress_) {
+    return;
+  }
+  // The user may have changed preferences since the cache was written.
+  for (auto& kv : publishers) {
+    kv.second->user_enabled_status = mojom::UserEnabled::NOT_MODIFIED;
+  }
+  ApplyUserEnabledPrefs(&publishers);
+  publishers_ = std::move(publishers);
+}
+
+void PublishersController::ApplyUserEnabledPrefs(Publishers* publishers) {
+  const base::DictionaryValue* publisher_prefs =
+      prefs_->GetDictionary(prefs::kBraveTodaySources);
+  for (auto kv : publisher_prefs->DictItems()) {
+    auto publisher_id = kv.first;
+    auto is_user_enabled = kv.second.GetIfBool();
+    if (publishers->contains(publisher_id) && is_user_enabled.has_value()) {
+      (*publishers)[publisher_id]->user_enabled_status =
+          (is_user_enabled.value() ? brave_news::mojom::UserEnabled::ENABLED
+                                   : brave_news::mojom::UserEnabled::DISABLED);
+    } else {
+      VLOG(1) << "Publisher list did not contain publisher found in"
+                 "user prefs: "
+              << publisher_id;
+    }
+  }
+}
+
 void PublishersController::ClearCache() {
   publishers_.clear();
 }
@@ -0,0 +1,195 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_wallet/browser/account_discovery_manager.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/task/thread_pool.h"
+#include "base/values.h"
+#include "brave/components/brave_wallet/browser/eth_json_rpc_controller.h"
+#include "brave/components/brave_wallet/browser/eth_requests.h"
+#include "brave/components/brave_wallet/browser/hd_keyring.h"
+#include "brave/components/brave_wallet/browser/keyring_controller.h"
+#include "brave/components/brave_wallet/common/hex_utils.h"
+#include "brave/components/brave_wallet/common/web3_provider_constants.h"
+
+namespace brave_wallet {
+
+namespace {
+
+// Each address is checked with two requests in the batch, its nonce and its
+// balance, with ids 2 * i and 2 * i + 1 respectively.
+constexpr size_t kRequestsPerAddress = 2;
+
+}  // namespace
+
+AccountDiscoveryManager::AccountDiscoveryManager(
+    EthJsonRpcController* rpc_controller,
+    KeyringController* keyring_controller)
+    : rpc_controller_(rpc_controller),
+      keyring_controller_(keyring_controller),
+      weak_factory_(this) {
+  DCHECK(rpc_controller_);
+  DCHECK(keyring_controller_);
+}
+
+AccountDiscoveryManager::~AccountDiscoveryManager() = default;
+
+void AccountDiscoveryManager::StartDiscovery(DiscoveryCallback callback) {
+  weak_factory_.InvalidateWeakPtrs();
+  callback_ = std::move(callback);
+  last_used_index_ = absl::nullopt;
+  public_extended_key_ =
+      keyring_controller_->GetDefaultKeyringPublicExtendedKey();
+  if (public_extended_key_.empty()) {
+    Finish(false);
+    return;
+  }
+  DeriveBatch(0);
+}
+
+void AccountDiscoveryManager::Stop() {
+  weak_factory_.InvalidateWeakPtrs();
+  callback_.Reset();
+  last_used_index_ = absl::nullopt;
+  public_extended_key_.clear();
+}
+
+bool AccountDiscoveryManager::IsRunning() const {
+  return !callback_.is_null();
+}
+
+bool AccountDiscoveryManager::IsKeyringUnchanged() const {
+  return !keyring_controller_->IsLocked() &&
+         keyring_controller_->GetDefaultKeyringPublicExtendedKey() ==
+             public_extended_key_;
+}
+
+void AccountDiscoveryManager::DeriveBatch(size_t start) {
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&HDKeyring::DeriveAddressesFromPublicExtendedKey,
+                     public_extended_key_, start, kBatchSize),
+      base::BindOnce(&AccountDiscoveryManager::OnBatchDerived,
+                     weak_factory_.GetWeakPtr(), start));
+}
+
+void AccountDiscoveryManager::OnBatchDerived(
+    size_t start,
+    const std::vector<std::string>& addresses) {
+  if (addresses.size() != kBatchSize || !IsKeyringUnchanged()) {
+    Finish(false);
+    return;
+  }
+
+  rpc_controller_->RequestBatch(
+      kEthGetTransactionCount, GetBatchRequestPayload(addresses),
+      base::BindOnce(&AccountDiscoveryManager::OnBatchChecked,
+                     weak_factory_.GetWeakPtr(), start, addresses));
+}
+
+void AccountDiscoveryManager::OnBatchChecked(
+    size_t start,
+    const std::vector<std::string>& addresses,
+    int status,
+    const std::string& body,
+    const base::flat_map<std::string, std::string>& headers) {
+  if (status < 200 || status > 299 || !IsKeyringUnchanged()) {
+    Finish(false);
+    return;
+  }
+  auto used_indices = ParseBatchResponse(addresses, body);
+  if (!used_indices) {
+    Finish(false);
+    return;
+  }
+  for (size_t index : *used_indices)
+    last_used_index_ = start + index;
+
+  const size_t next = start + addresses.size();
+  const size_t first_unused = last_used_index_ ? *last_used_index_ + 1 : 0;
+  if (next - first_unused >= kGapLimit || next >= kMaxAccounts) {
+    Finish(true);
+    return;
+  }
+  DeriveBatch(next);
+}
+
+void AccountDiscoveryManager::Finish(bool success) {
+  // Accounts found by the batches that succeeded before a failure are not
+  // reported, as they are not added either.
+  const size_t discovered_accounts =
+      success && last_used_index_ ? *last_used_index_ + 1 : 0;
+  if (discovered_accounts) {
+    keyring_controller_->AddDiscoveredAccountsForDefaultKeyring(
+        discovered_accounts);
+  }
+  public_extended_key_.clear();
+  if (callback_)
+    std::move(callback_).Run(success, discovered_accounts);
+}
+
+// static
+std::string AccountDiscoveryManager::GetBatchRequestPayload(
+    const std::vector<std::string>& addresses) {
+  base::Value batch(base::Value::Type::LIST);
+  for (size_t i = 0; i < addresses.size(); ++i) {
+    const std::string requests[kRequestsPerAddress] = {
+        eth_getTransactionCount(addresses[i], "latest"),
+        eth_getBalance(addresses[i], "latest")};
+    for (size_t j = 0; j < kRequestsPerAddress; ++j) {
+      absl::optional<base::Value> request = base::JSONReader::Read(requests[j]);
+      DCHECK(request && request->is_dict());
+      request->SetIntKey("id", i * kRequestsPerAddress + j);
+      batch.Append(std::move(*request));
+    }
+  }
+  std::string json;
+  base::JSONWriter::Write(batch, &json);
+  return json;
+}
+
+// static
+absl::optional<std::vector<size_t>>
+AccountDiscoveryManager::ParseBatchResponse(
+    const std::vector<std::string>& addresses,
+    const std::string& body) {
+  absl::optional<base::Value> response =
+      base::JSONReader::Read(body, base::JSON_PARSE_RFC);
+  if (!response || !response->is_list())
+    return absl::nullopt;
+
+  std::vector<bool> used(addresses.size(), false);
+  size_t results = 0;
+  for (const auto& item : response->GetList()) {
+    absl::optional<int> id = item.FindIntKey("id");
+    const std::string* result = item.FindStringKey("result");
+    if (!id || !result || *id < 0 ||
+        static_cast<size_t>(*id) >= addresses.size() * kRequestsPerAddress)
+      return absl::nullopt;
+    uint256_t value;
+    if (!HexValueToUint256(*result, &value))
+      return absl::nullopt;
+    if (value > 0)
+      used[*id / kRequestsPerAddress] = true;
+    ++results;
+  }
+  // Servers are allowed to reorder batch responses but not to drop entries.
+  if (results != addresses.size() * kRequestsPerAddress)
+    return absl::nullopt;
+
+  std::vector<size_t> used_indices;
+  for (size_t i = 0; i < used.size(); ++i) {
+    if (used[i])
+      used_indices.push_back(i);
+  }
+  return used_indices;
+}
+
+}  // namespace brave_wallet
@@ -0,0 +1,87 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ACCOUNT_DISCOVERY_MANAGER_H_
+#define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ACCOUNT_DISCOVERY_MANAGER_H_
+
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/flat_map.h"
+#include "base/gtest_prod_util.h"
+#include "base/memory/weak_ptr.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace brave_wallet {
+
+class EthJsonRpcController;
+class KeyringController;
+
+// Scans derived accounts of the default keyring for on-chain activity after a
+// restore. Addresses are derived in batches from the public extended key on
+// the thread pool and each batch is checked with a single JSON-RPC batch
+// request. Discovery stops after |kGapLimit| consecutive unused accounts.
+class AccountDiscoveryManager {
+ public:
+  static constexpr size_t kBatchSize = 10;
+  static constexpr size_t kGapLimit = 20;
+  static constexpr size_t kMaxAccounts = 200;
+
+  // |discovered_accounts| is the number of derived accounts up to and
+  // including the last one with activity, 0 when |success| is false.
+  using DiscoveryCallback =
+      base::OnceCallback<void(bool success, size_t discovered_accounts)>;
+
+  AccountDiscoveryManager(EthJsonRpcController* rpc_controller,
+                          KeyringController* keyring_controller);
+  ~AccountDiscoveryManager();
+  AccountDiscoveryManager(const AccountDiscoveryManager&) = delete;
+  AccountDiscoveryManager& operator=(const AccountDiscoveryManager&) = delete;
+
+  // Default keyring must be unlocked. A discovery already in progress is
+  // cancelled and its callback is never run.
+  void StartDiscovery(DiscoveryCallback callback);
+  // Cancels a discovery in progress, its callback is never run.
+  void Stop();
+  bool IsRunning() const;
+
+ private:
+  FRIEND_TEST_ALL_PREFIXES(AccountDiscoveryManagerUnitTest,
+                           GetBatchRequestPayload);
+
+  static std::string GetBatchRequestPayload(
+      const std::vector<std::string>& addresses);
+  // Returns indices into |addresses| of accounts with a non-zero nonce or
+  // balance, absl::nullopt when |body| isn't a valid batch response.
+  static absl::optional<std::vector<size_t>> ParseBatchResponse(
+      const std::vector<std::string>& addresses,
+      const std::string& body);
+
+  // False once the default keyring was locked, reset or replaced after
+  // discovery started.
+  bool IsKeyringUnchanged() const;
+  void DeriveBatch(size_t start);
+  void OnBatchDerived(size_t start, const std::vector<std::string>& addresses);
+  void OnBatchChecked(size_t start,
+                      const std::vector<std::string>& addresses,
+                      int status,
+                      const std::string& body,
+                      const base::flat_map<std::string, std::string>& headers);
+  void Finish(bool success);
+
+  std::string public_extended_key_;
+  absl::optional<size_t> last_used_index_;
+  DiscoveryCallback callback_;
+
+  EthJsonRpcController* rpc_controller_;   // NOT OWNED
+  KeyringController* keyring_controller_;  // NOT OWNED
+
+  base::WeakPtrFactory<AccountDiscoveryManager> weak_factory_;
+};
+
+}  // namespace brave_wallet
+
+#endif  // BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ACCOUNT_DISCOVERY_MANAGER_H_
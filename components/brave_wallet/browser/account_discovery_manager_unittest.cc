@@ -0,0 +1,310 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_wallet/browser/account_discovery_manager.h"
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/callback_helpers.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/test/bind.h"
+#include "brave/components/brave_wallet/browser/brave_wallet_prefs.h"
+#include "brave/components/brave_wallet/browser/eth_json_rpc_controller.h"
+#include "brave/components/brave_wallet/browser/hd_keyring.h"
+#include "brave/components/brave_wallet/browser/keyring_controller.h"
+#include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
+#include "components/sync_preferences/testing_pref_service_syncable.h"
+#include "content/public/test/browser_task_environment.h"
+#include "net/http/http_status_code.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_wallet {
+
+namespace {
+
+const char kMnemonic[] =
+    "divide cruise upon flag harsh carbon filter merit once advice bright "
+    "drive";
+
+}  // namespace
+
+class AccountDiscoveryManagerUnitTest : public testing::Test {
+ public:
+  AccountDiscoveryManagerUnitTest()
+      : shared_url_loader_factory_(
+            base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+                &url_loader_factory_)) {}
+
+  void SetUp() override {
+    brave_wallet::RegisterProfilePrefs(prefs_.registry());
+    rpc_controller_ = std::make_unique<EthJsonRpcController>(
+        shared_url_loader_factory_, &prefs_);
+    keyring_controller_ = std::make_unique<KeyringController>(&prefs_);
+    base::RunLoop run_loop;
+    rpc_controller_->SetNetwork(mojom::kLocalhostChainId,
+                                base::BindLambdaForTesting([&](bool success) {
+                                  EXPECT_TRUE(success);
+                                  run_loop.Quit();
+                                }));
+    run_loop.Run();
+  }
+
+  // Responds to batched nonce/balance requests, only accounts whose index is
+  // in |used_accounts| have a non zero nonce.
+  void SetBatchInterceptor(const std::set<size_t>& used_accounts) {
+    url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+        [&, used_accounts](const network::ResourceRequest& request) {
+          url_loader_factory_.ClearResponses();
+          EXPECT_TRUE(
+              request.headers.GetHeader("X-Eth-Method", &eth_method_header_));
+          base::StringPiece request_string(request.request_body->elements()
+                                               ->at(0)
+                                               .As<network::DataElementBytes>()
+                                               .AsStringPiece());
+          absl::optional<base::Value> batch =
+              base::JSONReader::Read(request_string);
+          ASSERT_TRUE(batch && batch->is_list());
+          base::Value response(base::Value::Type::LIST);
+          for (const auto& item : batch->GetList()) {
+            int id = *item.FindIntKey("id");
+            const std::string* method = item.FindStringKey("method");
+            ASSERT_TRUE(method);
+            base::Value result(base::Value::Type::DICTIONARY);
+            result.SetStringKey("jsonrpc", "2.0");
+            result.SetIntKey("id", id);
+            bool used = *method == "eth_getTransactionCount" &&
+                        used_accounts.count(batch_start_ + id / 2);
+            result.SetStringKey("result", used ? "0x1" : "0x0");
+            response.Append(std::move(result));
+          }
+          batch_start_ += batch->GetList().size() / 2;
+          ++batch_requests_;
+          std::string json;
+          base::JSONWriter::Write(response, &json);
+          url_loader_factory_.AddResponse(request.url.spec(), json);
+        }));
+  }
+
+  void RestoreWallet() {
+    base::RunLoop run_loop;
+    keyring_controller_->RestoreWallet(
+        kMnemonic, "brave123", false,
+        base::BindLambdaForTesting([&](bool success) {
+          ASSERT_TRUE(success);
+          run_loop.Quit();
+        }));
+    run_loop.Run();
+  }
+
+  HDKeyring* default_keyring() {
+    return keyring_controller_->default_keyring_.get();
+  }
+
+  void Discover(bool* success, size_t* discovered_accounts) {
+    AccountDiscoveryManager manager(rpc_controller_.get(),
+                                    keyring_controller_.get());
+    base::RunLoop run_loop;
+    manager.StartDiscovery(base::BindLambdaForTesting(
+        [&](bool result_success, size_t result_discovered) {
+          *success = result_success;
+          *discovered_accounts = result_discovered;
+          run_loop.Quit();
+        }));
+    EXPECT_TRUE(manager.IsRunning());
+    run_loop.Run();
+    EXPECT_FALSE(manager.IsRunning());
+  }
+
+ protected:
+  content::BrowserTaskEnvironment task_environment_;
+  sync_preferences::TestingPrefServiceSyncable prefs_;
+  network::TestURLLoaderFactory url_loader_factory_;
+  scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
+  std::unique_ptr<EthJsonRpcController> rpc_controller_;
+  std::unique_ptr<KeyringController> keyring_controller_;
+  size_t batch_start_ = 0;
+  size_t batch_requests_ = 0;
+  std::string eth_method_header_;
+};
+
+TEST_F(AccountDiscoveryManagerUnitTest, GetBatchRequestPayload) {
+  const std::string payload = AccountDiscoveryManager::GetBatchRequestPayload(
+      {"0x2166fB4e11D44100112B1124ac593081519cA1ec",
+       "0x2A22ad45446E8b34Da4da1f4ADd7B1571Ab4e4E7"});
+  absl::optional<base::Value> batch = base::JSONReader::Read(payload);
+  ASSERT_TRUE(batch && batch->is_list());
+  ASSERT_EQ(batch->GetList().size(), 4u);
+  EXPECT_EQ(*batch->GetList()[0].FindStringKey("method"),
+            "eth_getTransactionCount");
+  EXPECT_EQ(*batch->GetList()[1].FindStringKey("method"), "eth_getBalance");
+  for (size_t i = 0; i < batch->GetList().size(); ++i)
+    EXPECT_EQ(*batch->GetList()[i].FindIntKey("id"), static_cast<int>(i));
+  EXPECT_EQ(
+      batch->GetList()[2].FindListKey("params")->GetList()[0].GetString(),
+      "0x2A22ad45446E8b34Da4da1f4ADd7B1571Ab4e4E7");
+}
+
+TEST_F(AccountDiscoveryManagerUnitTest, DiscoverUsedAccounts) {
+  RestoreWallet();
+  SetBatchInterceptor({0, 2, 13});
+
+  bool success = false;
+  size_t discovered_accounts = 0;
+  Discover(&success, &discovered_accounts);
+  EXPECT_TRUE(success);
+  EXPECT_EQ(discovered_accounts, 14u);
+  // Account 13 is the last used one, so scanning stops once 20 more are
+  // checked: indices 0-9, 10-19, 20-29 and 30-39.
+  EXPECT_EQ(batch_requests_, 4u);
+  EXPECT_EQ(eth_method_header_, "eth_getTransactionCount");
+
+  auto* keyring = default_keyring();
+  ASSERT_TRUE(keyring);
+  EXPECT_EQ(keyring->GetAccountsNumber(), 14u);
+  // Addresses derived from the public extended key must match the ones the
+  // keyring derives from the private one.
+  std::vector<std::string> addresses =
+      HDKeyring::DeriveAddressesFromPublicExtendedKey(
+          keyring_controller_->GetDefaultKeyringPublicExtendedKey(), 0, 14);
+  EXPECT_EQ(addresses, keyring->GetAccounts());
+}
+
+TEST_F(AccountDiscoveryManagerUnitTest, NoUsedAccounts) {
+  RestoreWallet();
+  SetBatchInterceptor({});
+
+  bool success = false;
+  size_t discovered_accounts = 1;
+  Discover(&success, &discovered_accounts);
+  EXPECT_TRUE(success);
+  EXPECT_EQ(discovered_accounts, 0u);
+  EXPECT_EQ(batch_requests_, 2u);
+  // First account added by RestoreWallet is kept
+  EXPECT_EQ(default_keyring()->GetAccountsNumber(), 1u);
+}
+
+TEST_F(AccountDiscoveryManagerUnitTest, InvalidResponse) {
+  RestoreWallet();
+  url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+      [&](const network::ResourceRequest& request) {
+        url_loader_factory_.ClearResponses();
+        url_loader_factory_.AddResponse(
+            request.url.spec(),
+            "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":\"0x1\"}");
+      }));
+
+  bool success = true;
+  size_t discovered_accounts = 1;
+  Discover(&success, &discovered_accounts);
+  EXPECT_FALSE(success);
+  EXPECT_EQ(discovered_accounts, 0u);
+}
+
+TEST_F(AccountDiscoveryManagerUnitTest, FailureAfterUsedAccounts) {
+  RestoreWallet();
+  // The first batch finds account 2, the second one is rejected.
+  url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+      [&](const network::ResourceRequest& request) {
+        url_loader_factory_.ClearResponses();
+        if (batch_requests_++ == 0) {
+          base::Value response(base::Value::Type::LIST);
+          for (size_t id = 0; id < 2 * AccountDiscoveryManager::kBatchSize;
+               ++id) {
+            base::Value result(base::Value::Type::DICTIONARY);
+            result.SetStringKey("jsonrpc", "2.0");
+            result.SetIntKey("id", static_cast<int>(id));
+            result.SetStringKey("result", id == 4 ? "0x1" : "0x0");
+            response.Append(std::move(result));
+          }
+          std::string json;
+          base::JSONWriter::Write(response, &json);
+          url_loader_factory_.AddResponse(request.url.spec(), json);
+          return;
+        }
+        url_loader_factory_.AddResponse(request.url.spec(), "",
+                                        net::HTTP_REQUEST_TIMEOUT);
+      }));
+
+  bool success = true;
+  size_t discovered_accounts = 1;
+  Discover(&success, &discovered_accounts);
+  EXPECT_FALSE(success);
+  EXPECT_EQ(discovered_accounts, 0u);
+  EXPECT_EQ(batch_requests_, 2u);
+  EXPECT_EQ(default_keyring()->GetAccountsNumber(), 1u);
+}
+
+TEST_F(AccountDiscoveryManagerUnitTest, Locked) {
+  bool success = true;
+  size_t discovered_accounts = 1;
+  AccountDiscoveryManager manager(rpc_controller_.get(),
+                                  keyring_controller_.get());
+  manager.StartDiscovery(base::BindLambdaForTesting(
+      [&](bool result_success, size_t result_discovered) {
+        success = result_success;
+        discovered_accounts = result_discovered;
+      }));
+  EXPECT_FALSE(success);
+  EXPECT_EQ(discovered_accounts, 0u);
+  EXPECT_FALSE(manager.IsRunning());
+}
+
+TEST_F(AccountDiscoveryManagerUnitTest, Stop) {
+  RestoreWallet();
+  SetBatchInterceptor({0, 2, 13});
+
+  bool callback_called = false;
+  AccountDiscoveryManager manager(rpc_controller_.get(),
+                                  keyring_controller_.get());
+  manager.StartDiscovery(base::BindLambdaForTesting(
+      [&](bool success, size_t discovered_accounts) {
+        callback_called = true;
+      }));
+  manager.Stop();
+  EXPECT_FALSE(manager.IsRunning());
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(callback_called);
+  EXPECT_EQ(batch_requests_, 0u);
+  EXPECT_EQ(default_keyring()->GetAccountsNumber(), 1u);
+}
+
+TEST_F(AccountDiscoveryManagerUnitTest, LockedOrResetWhileRunning) {
+  for (bool reset : {false, true}) {
+    SCOPED_TRACE(reset);
+    RestoreWallet();
+    batch_start_ = 0;
+    batch_requests_ = 0;
+    SetBatchInterceptor({0, 2, 13});
+
+    bool success = true;
+    size_t discovered_accounts = 1;
+    AccountDiscoveryManager manager(rpc_controller_.get(),
+                                    keyring_controller_.get());
+    base::RunLoop run_loop;
+    manager.StartDiscovery(base::BindLambdaForTesting(
+        [&](bool result_success, size_t result_discovered) {
+          success = result_success;
+          discovered_accounts = result_discovered;
+          run_loop.Quit();
+        }));
+    if (reset)
+      keyring_controller_->Reset();
+    else
+      keyring_controller_->Lock();
+    run_loop.Run();
+    EXPECT_FALSE(success);
+    EXPECT_EQ(discovered_accounts, 0u);
+    EXPECT_EQ(batch_requests_, 0u);
+  }
+}
+
+}  // namespace brave_wallet
@@ -5,8 +5,10 @@
 
 #include "brave/components/brave_wallet/browser/brave_wallet_provider_impl.h"
 
+#include <memory>
 #include <utility>
 
+#include "base/barrier_closure.h"
 #include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
 #include "base/strings/string_number_conversions.h"
@@ -493,6 +495,121 @@ void BraveWalletProviderImpl::Request(const std::string& json_payload,
   }
 }
 
+void BraveWalletProviderImpl::RequestBatch(
+    const std::vector<std::string>& json_payloads,
+    RequestBatchCallback callback) {
+  if (!rpc_controller_ || json_payloads.empty()) {
+    std::move(callback).Run({});
+    return;
+  }
+
+  // Forward everything as a single JSON-RPC batch. Ids are replaced with the
+  // payload index so responses can be matched up even if the page reused
+  // ids, and are restored before handing the responses back.
+  base::Value batch(base::Value::Type::LIST);
+  std::vector<base::Value> ids;
+  ids.reserve(json_payloads.size());
+  std::string method;
+  for (size_t i = 0; i < json_payloads.size(); ++i) {
+    absl::optional<base::Value> request =
+        base::JSONReader::Read(json_payloads[i], base::JSON_PARSE_RFC);
+    if (!request || !request->is_dict()) {
+      RequestIndividually(json_payloads, std::move(callback));
+      return;
+    }
+    // Pages mostly batch calls of a single method, so the method of the first
+    // request is used for the whole batch.
+    const std::string* request_method = request->FindStringKey(kMethod);
+    if (i == 0 && request_method)
+      method = *request_method;
+    const base::Value* id = request->FindKey(kId);
+    ids.push_back(id ? id->Clone() : base::Value());
+    request->SetIntKey(kId, i);
+    batch.Append(std::move(*request));
+  }
+  std::string batch_payload;
+  base::JSONWriter::Write(batch, &batch_payload);
+
+  rpc_controller_->RequestBatch(
+      method, batch_payload,
+      base::BindOnce(&BraveWalletProviderImpl::OnRequestBatch,
+                     weak_factory_.GetWeakPtr(), json_payloads, std::move(ids),
+                     std::move(callback)));
+}
+
+void BraveWalletProviderImpl::OnRequestBatch(
+    std::vector<std::string> json_payloads,
+    std::vector<base::Value> ids,
+    RequestBatchCallback callback,
+    const int http_code,
+    const std::string& response,
+    const base::flat_map<std::string, std::string>& headers) {
+  std::vector<mojom::ProviderResponsePtr> responses(json_payloads.size());
+  if (http_code < 200 || http_code > 299) {
+    for (auto& entry : responses)
+      entry = mojom::ProviderResponse::New(http_code, response);
+    std::move(callback).Run(std::move(responses));
+    return;
+  }
+
+  absl::optional<base::Value> response_value =
+      base::JSONReader::Read(response, base::JSON_PARSE_RFC);
+  if (!response_value || !response_value->is_list()) {
+    RequestIndividually(std::move(json_payloads), std::move(callback));
+    return;
+  }
+  for (auto& item : response_value->GetList()) {
+    absl::optional<int> index = item.is_dict() ? item.FindIntKey(kId)
+                                               : absl::nullopt;
+    if (!index || *index < 0 ||
+        static_cast<size_t>(*index) >= responses.size() ||
+        responses[*index]) {
+      continue;
+    }
+    item.SetKey(kId, std::move(ids[*index]));
+    std::string item_json;
+    base::JSONWriter::Write(item, &item_json);
+    responses[*index] = mojom::ProviderResponse::New(http_code, item_json);
+  }
+  for (const auto& entry : responses) {
+    if (!entry) {
+      RequestIndividually(std::move(json_payloads), std::move(callback));
+      return;
+    }
+  }
+
+  std::move(callback).Run(std::move(responses));
+}
+
+void BraveWalletProviderImpl::RequestIndividually(
+    std::vector<std::string> json_payloads,
+    RequestBatchCallback callback) {
+  auto responses = std::make_unique<std::vector<mojom::ProviderResponsePtr>>(
+      json_payloads.size());
+  auto* responses_ptr = responses.get();
+  base::RepeatingClosure barrier = base::BarrierClosure(
+      json_payloads.size(),
+      base::BindOnce(
+          [](RequestBatchCallback callback,
+             std::unique_ptr<std::vector<mojom::ProviderResponsePtr>>
+                 responses) { std::move(callback).Run(std::move(*responses)); },
+          std::move(callback), std::move(responses)));
+  for (size_t i = 0; i < json_payloads.size(); ++i) {
+    rpc_controller_->Request(
+        json_payloads[i], true,
+        base::BindOnce(
+            [](std::vector<mojom::ProviderResponsePtr>* responses, size_t index,
+               base::RepeatingClosure barrier, const int http_code,
+               const std::string& response,
+               const base::flat_map<std::string, std::string>& headers) {
+              (*responses)[index] =
+                  mojom::ProviderResponse::New(http_code, response);
+              barrier.Run();
+            },
+            responses_ptr, i, barrier));
+  }
+}
+
 void BraveWalletProviderImpl::RequestEthereumPermissions(
     RequestEthereumPermissionsCallback callback) {
   DCHECK(delegate_);
@@ -13,6 +13,7 @@
 
 #include "base/containers/flat_map.h"
 #include "base/memory/weak_ptr.h"
+#include "base/values.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "brave/components/brave_wallet/common/web3_provider_constants.h"
 #include "components/content_settings/core/browser/content_settings_observer.h"
@@ -51,6 +52,8 @@ class BraveWalletProviderImpl final
   void Request(const std::string& json_payload,
                bool auto_retry_on_network_change,
                RequestCallback callback) override;
+  void RequestBatch(const std::vector<std::string>& json_payloads,
+                    RequestBatchCallback callback) override;
   void RequestEthereumPermissions(
       RequestEthereumPermissionsCallback callback) override;
   void OnRequestEthereumPermissions(RequestEthereumPermissionsCallback callback,
@@ -115,6 +118,16 @@ class BraveWalletProviderImpl final
 
   void OnAddEthereumChain(const std::string& chain_id, bool accepted);
 
+  void OnRequestBatch(std::vector<std::string> json_payloads,
+                      std::vector<base::Value> ids,
+                      RequestBatchCallback callback,
+                      const int http_code,
+                      const std::string& response,
+                      const base::flat_map<std::string, std::string>& headers);
+  // Used when the endpoint does not answer a JSON-RPC batch with a batch.
+  void RequestIndividually(std::vector<std::string> json_payloads,
+                           RequestBatchCallback callback);
+
   void OnChainApprovalResult(const std::string& chain_id,
                              const std::string& error);
   void OnConnectionError();
@@ -0,0 +1,145 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_wallet/browser/domain_resolution_cache.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/check.h"
+#include "base/strings/strcat.h"
+
+namespace brave_wallet {
+
+DomainResolutionCache::Entry::Entry() = default;
+DomainResolutionCache::Entry::~Entry() = default;
+DomainResolutionCache::Entry::Entry(const Entry&) = default;
+DomainResolutionCache::Entry& DomainResolutionCache::Entry::operator=(
+    const Entry&) = default;
+
+DomainResolutionCache::DomainResolutionCache() = default;
+
+DomainResolutionCache::~DomainResolutionCache() = default;
+
+void DomainResolutionCache::Resolve(const std::string& chain_id,
+                                    const std::string& record_type,
+                                    const std::string& domain,
+                                    Resolver resolver,
+                                    ResolveCallback callback) {
+  const std::string key =
+      base::StrCat({chain_id, "|", record_type, "|", domain});
+
+  base::TimeDelta age;
+  absl::optional<std::vector<std::string>> values =
+      GetCachedValues(key, chain_id, &age);
+  if (!values) {
+    StartResolve(key, chain_id, std::move(resolver), std::move(callback));
+    return;
+  }
+
+  std::move(callback).Run(true, *values);
+  if (age > kTimeToLive / 2)
+    StartResolve(key, chain_id, std::move(resolver), ResolveCallback());
+}
+
+void DomainResolutionCache::OnNewBlock(const std::string& chain_id,
+                                       uint256_t block_number) {
+  uint256_t& latest_block = latest_blocks_[chain_id];
+  latest_block = std::max(latest_block, block_number);
+}
+
+void DomainResolutionCache::Clear() {
+  entries_.clear();
+}
+
+absl::optional<std::vector<std::string>> DomainResolutionCache::GetCachedValues(
+    const std::string& key,
+    const std::string& chain_id,
+    base::TimeDelta* age) const {
+  const auto entry = entries_.find(key);
+  if (entry == entries_.end())
+    return absl::nullopt;
+
+  // Also treat entries expiring further out than kTimeToLive as stale, which
+  // happens when the clock was moved back.
+  const base::TimeDelta time_left =
+      entry->second.expiration - base::Time::Now();
+  if (time_left <= base::TimeDelta() || time_left > kTimeToLive)
+    return absl::nullopt;
+
+  const auto latest_block = latest_blocks_.find(chain_id);
+  if (entry->second.block && latest_block != latest_blocks_.end() &&
+      latest_block->second >= *entry->second.block + kMaxBlockAge) {
+    return absl::nullopt;
+  }
+
+  *age = kTimeToLive - time_left;
+  return entry->second.values;
+}
+
+void DomainResolutionCache::StartResolve(const std::string& key,
+                                         const std::string& chain_id,
+                                         Resolver resolver,
+                                         ResolveCallback callback) {
+  auto it = pending_.find(key);
+  if (it != pending_.end()) {
+    if (callback)
+      it->second.push_back(std::move(callback));
+    return;
+  }
+
+  std::vector<ResolveCallback>& callbacks = pending_[key];
+  if (callback)
+    callbacks.push_back(std::move(callback));
+
+  // |resolver| may reply synchronously, so |pending_| must not be touched
+  // after this.
+  std::move(resolver).Run(base::BindOnce(&DomainResolutionCache::OnResolved,
+                                         weak_ptr_factory_.GetWeakPtr(), key,
+                                         chain_id));
+}
+
+void DomainResolutionCache::OnResolved(const std::string& key,
+                                       const std::string& chain_id,
+                                       bool success,
+                                       const std::vector<std::string>& values) {
+  auto it = pending_.find(key);
+  DCHECK(it != pending_.end());
+  std::vector<ResolveCallback> callbacks = std::move(it->second);
+  pending_.erase(it);
+
+  // A failed refresh leaves the previous entry to expire on its own.
+  if (success)
+    Store(key, chain_id, values);
+
+  for (auto& callback : callbacks)
+    std::move(callback).Run(success, values);
+}
+
+void DomainResolutionCache::Store(const std::string& key,
+                                  const std::string& chain_id,
+                                  const std::vector<std::string>& values) {
+  if (!entries_.contains(key) && entries_.size() >= kMaxEntries) {
+    // Make room by dropping whatever expires first, which includes entries
+    // that already expired.
+    const auto oldest = std::min_element(
+        entries_.begin(), entries_.end(), [](const auto& a, const auto& b) {
+          return a.second.expiration < b.second.expiration;
+        });
+    entries_.erase(oldest);
+  }
+
+  Entry& entry = entries_[key];
+  entry.values = values;
+  entry.expiration = base::Time::Now() + kTimeToLive;
+  const auto latest_block = latest_blocks_.find(chain_id);
+  if (latest_block != latest_blocks_.end())
+    entry.block = latest_block->second;
+  else
+    entry.block = absl::nullopt;
+}
+
+}  // namespace brave_wallet
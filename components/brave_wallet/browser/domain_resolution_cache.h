@@ -0,0 +1,109 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_DOMAIN_RESOLUTION_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_DOMAIN_RESOLUTION_CACHE_H_
+
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/flat_map.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "brave/components/brave_wallet/common/brave_wallet_types.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace brave_wallet {
+
+// Keeps the records of decentralized domains (ENS, Unstoppable Domains) that
+// were resolved on chain in memory, so repeat navigations to a domain don't
+// have to wait for the eth_call round trips. Nothing is written to disk, so
+// the domains a user visited don't outlive the session.
+//
+// An entry is dropped once it is older than kTimeToLive, or once the chain is
+// known to have advanced kMaxBlockAge blocks past the block it was resolved
+// at. Block numbers are only known while something polls for them (e.g. the
+// wallet's block tracker), so the TTL is the upper bound.
+class DomainResolutionCache {
+ public:
+  using ResolveCallback =
+      base::OnceCallback<void(bool success,
+                              const std::vector<std::string>& values)>;
+  // Looks |values| up on chain. Only run on a cache miss, or to refresh an
+  // entry which is about to expire.
+  using Resolver = base::OnceCallback<void(ResolveCallback callback)>;
+
+  static constexpr base::TimeDelta kTimeToLive = base::TimeDelta::FromHours(1);
+  static constexpr uint64_t kMaxBlockAge = 150;
+  static constexpr size_t kMaxEntries = 100;
+
+  DomainResolutionCache();
+  ~DomainResolutionCache();
+  DomainResolutionCache(const DomainResolutionCache&) = delete;
+  DomainResolutionCache& operator=(const DomainResolutionCache&) = delete;
+
+  // Runs |callback| with the cached |record_type| records of |domain| on
+  // |chain_id|, or with the result of |resolver| if there are none. Lookups of
+  // the same records which overlap share a single |resolver| run. Entries past
+  // half of their lifetime are answered from the cache and refreshed in the
+  // background so that a domain in use doesn't go back to the slow path.
+  // Failures are not cached.
+  void Resolve(const std::string& chain_id,
+               const std::string& record_type,
+               const std::string& domain,
+               Resolver resolver,
+               ResolveCallback callback);
+
+  // Records the latest block number seen on |chain_id|.
+  void OnNewBlock(const std::string& chain_id, uint256_t block_number);
+
+  // Drops every entry. Lookups in progress still complete and are cached.
+  void Clear();
+
+  size_t size() const { return entries_.size(); }
+
+ private:
+  struct Entry {
+    Entry();
+    ~Entry();
+    Entry(const Entry&);
+    Entry& operator=(const Entry&);
+
+    std::vector<std::string> values;
+    base::Time expiration;
+    // Latest block number of the chain when |values| were resolved, if known.
+    absl::optional<uint256_t> block;
+  };
+
+  absl::optional<std::vector<std::string>> GetCachedValues(
+      const std::string& key,
+      const std::string& chain_id,
+      base::TimeDelta* age) const;
+  void StartResolve(const std::string& key,
+                    const std::string& chain_id,
+                    Resolver resolver,
+                    ResolveCallback callback);
+  void OnResolved(const std::string& key,
+                  const std::string& chain_id,
+                  bool success,
+                  const std::vector<std::string>& values);
+  void Store(const std::string& key,
+             const std::string& chain_id,
+             const std::vector<std::string>& values);
+
+  // Keyed by "<chain_id>|<record type>|<domain>".
+  base::flat_map<std::string, Entry> entries_;
+  // Callers waiting for a resolution, keyed like the cache entries. Holds an
+  // empty list for background refreshes.
+  base::flat_map<std::string, std::vector<ResolveCallback>> pending_;
+  // <chain_id, latest block number>
+  base::flat_map<std::string, uint256_t> latest_blocks_;
+  base::WeakPtrFactory<DomainResolutionCache> weak_ptr_factory_{this};
+};
+
+}  // namespace brave_wallet
+
+#endif  // BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_DOMAIN_RESOLUTION_CACHE_H_
@@ -0,0 +1,246 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_wallet/browser/domain_resolution_cache.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/callback_helpers.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_wallet {
+
+namespace {
+
+constexpr char kChainId[] = "0x1";
+constexpr char kRecordType[] = "ens:contenthash";
+
+}  // namespace
+
+class DomainResolutionCacheUnitTest : public testing::Test {
+ public:
+  DomainResolutionCacheUnitTest()
+      : cache_(std::make_unique<DomainResolutionCache>()) {}
+
+  // Resolves |domain| and returns the values it was resolved to. Cache misses
+  // resolve to "value_<domain>", background refreshes are left pending until
+  // Reply() is called.
+  absl::optional<std::vector<std::string>> Resolve(const std::string& domain) {
+    absl::optional<std::vector<std::string>> result;
+    bool callback_called = false;
+    cache_->Resolve(kChainId, kRecordType, domain,
+                    base::BindLambdaForTesting(
+                        [&](DomainResolutionCache::ResolveCallback callback) {
+                          resolve_callbacks_.push_back(std::move(callback));
+                        }),
+                    base::BindLambdaForTesting(
+                        [&](bool success,
+                            const std::vector<std::string>& values) {
+                          callback_called = true;
+                          if (success)
+                            result = values;
+                        }));
+    if (!callback_called) {
+      EXPECT_FALSE(resolve_callbacks_.empty());
+      Reply(true, {"value_" + domain});
+    }
+    return result;
+  }
+
+  // Whether |domain| is answered without a lookup. A lookup is left pending.
+  bool IsCached(const std::string& domain) {
+    const size_t pending = resolve_callbacks_.size();
+    cache_->Resolve(kChainId, kRecordType, domain,
+                    base::BindLambdaForTesting(
+                        [&](DomainResolutionCache::ResolveCallback callback) {
+                          resolve_callbacks_.push_back(std::move(callback));
+                        }),
+                    base::DoNothing());
+    return resolve_callbacks_.size() == pending;
+  }
+
+  void Reply(bool success, const std::vector<std::string>& values) {
+    ASSERT_FALSE(resolve_callbacks_.empty());
+    auto callback = std::move(resolve_callbacks_.front());
+    resolve_callbacks_.erase(resolve_callbacks_.begin());
+    std::move(callback).Run(success, values);
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  std::unique_ptr<DomainResolutionCache> cache_;
+  std::vector<DomainResolutionCache::ResolveCallback> resolve_callbacks_;
+};
+
+TEST_F(DomainResolutionCacheUnitTest, CachesResolvedValues) {
+  int resolver_runs = 0;
+  auto resolver = [&](DomainResolutionCache::ResolveCallback callback) {
+    resolver_runs++;
+    std::move(callback).Run(true, {"hash"});
+  };
+  std::vector<std::string> result;
+  auto callback = [&](bool success, const std::vector<std::string>& values) {
+    EXPECT_TRUE(success);
+    result = values;
+  };
+
+  cache_->Resolve(kChainId, kRecordType, "brave.eth",
+                  base::BindLambdaForTesting(resolver),
+                  base::BindLambdaForTesting(callback));
+  EXPECT_EQ(resolver_runs, 1);
+  EXPECT_EQ(result, std::vector<std::string>({"hash"}));
+
+  result.clear();
+  cache_->Resolve(kChainId, kRecordType, "brave.eth",
+                  base::BindLambdaForTesting(resolver),
+                  base::BindLambdaForTesting(callback));
+  EXPECT_EQ(resolver_runs, 1);
+  EXPECT_EQ(result, std::vector<std::string>({"hash"}));
+
+  // Other record types, domains and chains are separate entries.
+  cache_->Resolve(kChainId, "ud:dweb.ipfs.hash", "brave.eth",
+                  base::BindLambdaForTesting(resolver),
+                  base::BindLambdaForTesting(callback));
+  cache_->Resolve(kChainId, kRecordType, "brave2.eth",
+                  base::BindLambdaForTesting(resolver),
+                  base::BindLambdaForTesting(callback));
+  cache_->Resolve("0x3", kRecordType, "brave.eth",
+                  base::BindLambdaForTesting(resolver),
+                  base::BindLambdaForTesting(callback));
+  EXPECT_EQ(resolver_runs, 4);
+
+  // Until they are cleared.
+  cache_->Clear();
+  EXPECT_EQ(cache_->size(), 0u);
+  cache_->Resolve(kChainId, kRecordType, "brave.eth",
+                  base::BindLambdaForTesting(resolver),
+                  base::BindLambdaForTesting(callback));
+  EXPECT_EQ(resolver_runs, 5);
+
+  // Nothing is persisted, so a restart starts over too.
+  cache_ = std::make_unique<DomainResolutionCache>();
+  cache_->Resolve(kChainId, kRecordType, "brave.eth",
+                  base::BindLambdaForTesting(resolver),
+                  base::BindLambdaForTesting(callback));
+  EXPECT_EQ(resolver_runs, 6);
+}
+
+TEST_F(DomainResolutionCacheUnitTest, CoalescesConcurrentLookups) {
+  std::vector<std::vector<std::string>> results;
+  for (int i = 0; i < 3; ++i) {
+    cache_->Resolve(kChainId, kRecordType, "brave.eth",
+                    base::BindLambdaForTesting(
+                        [&](DomainResolutionCache::ResolveCallback callback) {
+                          resolve_callbacks_.push_back(std::move(callback));
+                        }),
+                    base::BindLambdaForTesting(
+                        [&](bool success,
+                            const std::vector<std::string>& values) {
+                          EXPECT_TRUE(success);
+                          results.push_back(values);
+                        }));
+  }
+  EXPECT_EQ(resolve_callbacks_.size(), 1u);
+  EXPECT_TRUE(results.empty());
+
+  Reply(true, {"hash"});
+  EXPECT_EQ(results, std::vector<std::vector<std::string>>(
+                         3, std::vector<std::string>({"hash"})));
+}
+
+TEST_F(DomainResolutionCacheUnitTest, DoesNotCacheFailures) {
+  bool callback_called = false;
+  cache_->Resolve(kChainId, kRecordType, "brave.eth",
+                  base::BindOnce([](DomainResolutionCache::ResolveCallback
+                                        callback) {
+                    std::move(callback).Run(false, {});
+                  }),
+                  base::BindLambdaForTesting(
+                      [&](bool success,
+                          const std::vector<std::string>& values) {
+                        callback_called = true;
+                        EXPECT_FALSE(success);
+                      }));
+  EXPECT_TRUE(callback_called);
+  EXPECT_EQ(cache_->size(), 0u);
+}
+
+TEST_F(DomainResolutionCacheUnitTest, Expiration) {
+  EXPECT_EQ(Resolve("brave.eth"),
+            std::vector<std::string>({"value_brave.eth"}));
+
+  // Answered from the cache, with a refresh once half of the TTL is gone.
+  task_environment_.FastForwardBy(DomainResolutionCache::kTimeToLive / 4);
+  EXPECT_EQ(Resolve("brave.eth"),
+            std::vector<std::string>({"value_brave.eth"}));
+  EXPECT_TRUE(resolve_callbacks_.empty());
+
+  task_environment_.FastForwardBy(DomainResolutionCache::kTimeToLive / 2);
+  EXPECT_EQ(Resolve("brave.eth"),
+            std::vector<std::string>({"value_brave.eth"}));
+  EXPECT_EQ(resolve_callbacks_.size(), 1u);
+  Reply(true, {"new_value"});
+
+  // The refresh started the TTL over.
+  task_environment_.FastForwardBy(DomainResolutionCache::kTimeToLive / 2);
+  EXPECT_EQ(Resolve("brave.eth"), std::vector<std::string>({"new_value"}));
+  EXPECT_TRUE(resolve_callbacks_.empty());
+
+  task_environment_.FastForwardBy(DomainResolutionCache::kTimeToLive);
+  EXPECT_EQ(Resolve("brave.eth"),
+            std::vector<std::string>({"value_brave.eth"}));
+}
+
+TEST_F(DomainResolutionCacheUnitTest, BlockBasedInvalidation) {
+  cache_->OnNewBlock(kChainId, 1000);
+  EXPECT_EQ(Resolve("brave.eth"),
+            std::vector<std::string>({"value_brave.eth"}));
+
+  cache_->OnNewBlock(kChainId, 1000 + DomainResolutionCache::kMaxBlockAge - 1);
+  cache_->OnNewBlock("0x3", 1000000);
+  EXPECT_EQ(Resolve("brave.eth"),
+            std::vector<std::string>({"value_brave.eth"}));
+  EXPECT_TRUE(resolve_callbacks_.empty());
+
+  // Older blocks don't move the chain head back.
+  cache_->OnNewBlock(kChainId, 1000 + DomainResolutionCache::kMaxBlockAge);
+  cache_->OnNewBlock(kChainId, 0);
+  bool callback_called = false;
+  cache_->Resolve(kChainId, kRecordType, "brave.eth",
+                  base::BindLambdaForTesting(
+                      [&](DomainResolutionCache::ResolveCallback callback) {
+                        resolve_callbacks_.push_back(std::move(callback));
+                      }),
+                  base::BindLambdaForTesting(
+                      [&](bool success,
+                          const std::vector<std::string>& values) {
+                        callback_called = true;
+                      }));
+  EXPECT_FALSE(callback_called);
+  EXPECT_EQ(resolve_callbacks_.size(), 1u);
+}
+
+TEST_F(DomainResolutionCacheUnitTest, EvictsEntriesExpiringFirst) {
+  for (size_t i = 0; i < DomainResolutionCache::kMaxEntries; ++i) {
+    Resolve(base::NumberToString(i) + ".eth");
+    task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+  }
+  EXPECT_EQ(cache_->size(), DomainResolutionCache::kMaxEntries);
+
+  Resolve("brave.eth");
+  EXPECT_EQ(cache_->size(), DomainResolutionCache::kMaxEntries);
+  EXPECT_TRUE(IsCached("1.eth"));
+  EXPECT_TRUE(IsCached("brave.eth"));
+  EXPECT_FALSE(IsCached("0.eth"));
+}
+
+}  // namespace brave_wallet
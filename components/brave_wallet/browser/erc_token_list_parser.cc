@@ -69,6 +69,7 @@ bool ParseTokenList(const std::string& json,
     return false;
   }
 
+  token_list->reserve(token_list->size() + response_dict->DictSize());
   for (const auto erc_token_value_pair : response_dict->DictItems()) {
     auto erc_token = brave_wallet::mojom::ERCToken::New();
     erc_token->contract_address = erc_token_value_pair.first;
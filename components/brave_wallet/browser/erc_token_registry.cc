@@ -8,6 +8,8 @@
 #include <algorithm>
 #include <utility>
 
+#include "base/containers/flat_set.h"
+#include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 
@@ -35,35 +37,49 @@ void ERCTokenRegistry::Bind(
 void ERCTokenRegistry::UpdateTokenList(
     std::vector<mojom::ERCTokenPtr> erc_tokens) {
   erc_tokens_ = std::move(erc_tokens);
+  BuildIndices();
+}
+
+void ERCTokenRegistry::BuildIndices() {
+  std::vector<std::pair<std::string, size_t>> contracts;
+  std::vector<std::pair<std::string, size_t>> symbols;
+  contracts.reserve(erc_tokens_.size());
+  symbols.reserve(erc_tokens_.size());
+  search_index_.clear();
+  search_index_.reserve(erc_tokens_.size() * 2);
+  for (size_t i = 0; i < erc_tokens_.size(); ++i) {
+    const auto& token = erc_tokens_[i];
+    contracts.emplace_back(base::ToLowerASCII(token->contract_address), i);
+    symbols.emplace_back(token->symbol, i);
+    search_index_.emplace_back(base::ToLowerASCII(token->symbol), i);
+    search_index_.emplace_back(base::ToLowerASCII(token->name), i);
+  }
+  // flat_map keeps the first of duplicated keys which matches the order
+  // tokens used to be scanned in.
+  contract_index_ = base::flat_map<std::string, size_t>(std::move(contracts));
+  symbol_index_ = base::flat_map<std::string, size_t>(std::move(symbols));
+  std::sort(search_index_.begin(), search_index_.end());
 }
 
 void ERCTokenRegistry::GetTokenByContract(const std::string& contract,
                                           GetTokenByContractCallback callback) {
-  auto token_it =
-      std::find_if(erc_tokens_.begin(), erc_tokens_.end(),
-                   [&](const mojom::ERCTokenPtr& current_token) {
-                     return current_token->contract_address == contract;
-                   });
-  if (token_it == erc_tokens_.end()) {
+  auto it = contract_index_.find(base::ToLowerASCII(contract));
+  if (it == contract_index_.end()) {
     std::move(callback).Run(nullptr);
     return;
   }
-  std::move(callback).Run(token_it->Clone());
+  std::move(callback).Run(erc_tokens_[it->second].Clone());
 }
 
 void ERCTokenRegistry::GetTokenBySymbol(const std::string& symbol,
                                         GetTokenBySymbolCallback callback) {
-  auto token_it = std::find_if(erc_tokens_.begin(), erc_tokens_.end(),
-                               [&](const mojom::ERCTokenPtr& current_token) {
-                                 return current_token->symbol == symbol;
-                               });
-
-  if (token_it == erc_tokens_.end()) {
+  auto it = symbol_index_.find(symbol);
+  if (it == symbol_index_.end()) {
     std::move(callback).Run(nullptr);
     return;
   }
 
-  std::move(callback).Run(token_it->Clone());
+  std::move(callback).Run(erc_tokens_[it->second].Clone());
 }
 
 void ERCTokenRegistry::GetAllTokens(GetAllTokensCallback callback) {
@@ -78,6 +94,32 @@ void ERCTokenRegistry::GetAllTokens(GetAllTokensCallback callback) {
   std::move(callback).Run(std::move(erc_tokens_copy));
 }
 
+void ERCTokenRegistry::SearchTokens(const std::string& query,
+                                    uint32_t max_results,
+                                    SearchTokensCallback callback) {
+  std::vector<brave_wallet::mojom::ERCTokenPtr> results;
+  const std::string prefix = base::ToLowerASCII(query);
+  if (prefix.empty() || !max_results) {
+    std::move(callback).Run(std::move(results));
+    return;
+  }
+
+  // A token can match on both its symbol and its name
+  base::flat_set<size_t> matched;
+  auto it = std::lower_bound(
+      search_index_.begin(), search_index_.end(), prefix,
+      [](const std::pair<std::string, size_t>& entry,
+         const std::string& value) { return entry.first < value; });
+  for (; it != search_index_.end() && results.size() < max_results; ++it) {
+    if (!base::StartsWith(it->first, prefix))
+      break;
+    if (!matched.insert(it->second).second)
+      continue;
+    results.push_back(erc_tokens_[it->second].Clone());
+  }
+  std::move(callback).Run(std::move(results));
+}
+
 void ERCTokenRegistry::GetBuyTokens(GetBuyTokensCallback callback) {
   std::vector<brave_wallet::mojom::ERCTokenPtr> erc_buy_tokens;
   for (auto token : *kBuyTokens) {
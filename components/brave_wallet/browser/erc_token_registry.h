@@ -7,8 +7,10 @@
 #define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ERC_TOKEN_REGISTRY_H_
 
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/macros.h"
 #include "base/memory/singleton.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
@@ -37,6 +39,9 @@ class ERCTokenRegistry : public mojom::ERCTokenRegistry {
   void GetTokenBySymbol(const std::string& symbol,
                         GetTokenBySymbolCallback callback) override;
   void GetAllTokens(GetAllTokensCallback callback) override;
+  void SearchTokens(const std::string& query,
+                    uint32_t max_results,
+                    SearchTokensCallback callback) override;
   void GetBuyTokens(GetBuyTokensCallback callback) override;
   void GetBuyUrl(const std::string& address,
                  const std::string& symbol,
@@ -50,6 +55,16 @@ class ERCTokenRegistry : public mojom::ERCTokenRegistry {
   ERCTokenRegistry();
 
  private:
+  void BuildIndices();
+
+  // Indices into |erc_tokens_|, rebuilt on each token list update.
+  // Keyed by lower case contract address
+  base::flat_map<std::string, size_t> contract_index_;
+  // First token for each symbol, same as a front to back scan would return
+  base::flat_map<std::string, size_t> symbol_index_;
+  // (lower case symbol or name, index) sorted for prefix search
+  std::vector<std::pair<std::string, size_t>> search_index_;
+
   mojo::ReceiverSet<mojom::ERCTokenRegistry> receivers_;
 };
 
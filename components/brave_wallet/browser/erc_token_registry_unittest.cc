@@ -96,6 +96,12 @@ TEST(ERCTokenRegistryUnitTest, GetTokenByContract) {
                                  ASSERT_EQ(token->symbol, "BAT");
                                }));
 
+  // Lookup doesn't depend on address checksum casing
+  registry->GetTokenByContract("0x0d8775f648430679a709e98d2b0cb6250d2887ef",
+                               base::BindOnce([](mojom::ERCTokenPtr token) {
+                                 ASSERT_EQ(token->symbol, "BAT");
+                               }));
+
   registry->GetTokenByContract(
       "0xCCC775F648430679A709E98d2b0Cb6250d2887EF",
       base::BindOnce([](mojom::ERCTokenPtr token) { ASSERT_FALSE(token); }));
@@ -117,4 +123,49 @@ TEST(ERCTokenRegistryUnitTest, GetTokenBySymbol) {
       base::BindOnce([](mojom::ERCTokenPtr token) { ASSERT_FALSE(token); }));
 }
 
+TEST(ERCTokenRegistryUnitTest, SearchTokens) {
+  auto* registry = ERCTokenRegistry::GetInstance();
+  std::vector<mojom::ERCTokenPtr> input_erc_tokens;
+  ASSERT_TRUE(ParseTokenList(token_list_json, &input_erc_tokens));
+  registry->UpdateTokenList(std::move(input_erc_tokens));
+
+  // Matches symbol prefix case insensitively
+  registry->SearchTokens(
+      "ba", 10,
+      base::BindOnce([](std::vector<mojom::ERCTokenPtr> token_list) {
+        ASSERT_EQ(token_list.size(), 1UL);
+        EXPECT_EQ(token_list[0]->symbol, "BAT");
+      }));
+
+  // Matches name prefix, token matching both symbol and name is returned once
+  registry->SearchTokens(
+      "u", 10, base::BindOnce([](std::vector<mojom::ERCTokenPtr> token_list) {
+        ASSERT_EQ(token_list.size(), 1UL);
+        EXPECT_EQ(token_list[0]->symbol, "UNI");
+      }));
+  registry->SearchTokens(
+      "Crypto K", 10,
+      base::BindOnce([](std::vector<mojom::ERCTokenPtr> token_list) {
+        ASSERT_EQ(token_list.size(), 1UL);
+        EXPECT_EQ(token_list[0]->symbol, "CK");
+      }));
+
+  // Results are capped by max_results
+  registry->SearchTokens(
+      "c", 1, base::BindOnce([](std::vector<mojom::ERCTokenPtr> token_list) {
+        ASSERT_EQ(token_list.size(), 1UL);
+        EXPECT_EQ(token_list[0]->symbol, "CK");
+      }));
+
+  registry->SearchTokens(
+      "xyz", 10,
+      base::BindOnce([](std::vector<mojom::ERCTokenPtr> token_list) {
+        EXPECT_TRUE(token_list.empty());
+      }));
+  registry->SearchTokens(
+      "", 10, base::BindOnce([](std::vector<mojom::ERCTokenPtr> token_list) {
+        EXPECT_TRUE(token_list.empty());
+      }));
+}
+
 }  // namespace brave_wallet
@@ -5,6 +5,7 @@
 
 #include "brave/components/brave_wallet/browser/eth_block_tracker.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/bind.h"
@@ -13,6 +14,12 @@
 
 namespace brave_wallet {
 
+namespace {
+
+constexpr int kMaxBackoffMultiplier = 4;
+
+}  // namespace
+
 EthBlockTracker::EthBlockTracker(EthJsonRpcController* rpc_controller)
     : rpc_controller_(rpc_controller), weak_factory_(this) {
   DCHECK(rpc_controller_);
@@ -20,6 +27,12 @@ EthBlockTracker::EthBlockTracker(EthJsonRpcController* rpc_controller)
 EthBlockTracker::~EthBlockTracker() = default;
 
 void EthBlockTracker::Start(base::TimeDelta interval) {
+  base_interval_ = interval;
+  ScheduleTimer(interval);
+}
+
+void EthBlockTracker::ScheduleTimer(base::TimeDelta interval) {
+  current_interval_ = interval;
   timer_.Start(FROM_HERE, interval,
                base::BindRepeating(&EthBlockTracker::GetBlockNumber,
                                    weak_factory_.GetWeakPtr()));
@@ -57,8 +70,10 @@ void EthBlockTracker::GetBlockNumber() {
 }
 
 void EthBlockTracker::OnGetBlockNumber(bool status, uint256_t block_num) {
+  bool new_block = false;
   if (status) {
     if (current_block_ != block_num) {
+      new_block = true;
       current_block_ = block_num;
       for (auto& observer : observers_)
         observer.OnNewBlock(block_num);
@@ -69,6 +84,16 @@ void EthBlockTracker::OnGetBlockNumber(bool status, uint256_t block_num) {
   } else {
     LOG(ERROR) << "GetBlockNumber failed";
   }
+
+  // Stopped while the request was in flight.
+  if (!timer_.IsRunning())
+    return;
+  const base::TimeDelta next_interval =
+      new_block ? base_interval_
+                : std::min(current_interval_ * 2,
+                           base_interval_ * kMaxBackoffMultiplier);
+  if (next_interval != current_interval_)
+    ScheduleTimer(next_interval);
 }
 
 }  // namespace brave_wallet
@@ -31,7 +31,10 @@ class EthBlockTracker {
     virtual void OnNewBlock(uint256_t block_num) = 0;
   };
 
-  // If timer is already running, it will be replaced with new interval
+  // If timer is already running, it will be replaced with new interval.
+  // While the chain head does not move, the polling interval backs off
+  // exponentially up to kMaxBackoffMultiplier times |interval| and goes back
+  // to |interval| as soon as a new block is seen.
   void Start(base::TimeDelta interval);
   void Stop();
   bool IsRunning() const;
@@ -40,6 +43,9 @@ class EthBlockTracker {
   void RemoveObserver(Observer* observer);
 
   uint256_t GetCurrentBlock() const { return current_block_; }
+  base::TimeDelta GetCurrentIntervalForTesting() const {
+    return current_interval_;
+  }
 
   void CheckForLatestBlock(
       base::OnceCallback<void(bool status, uint256_t block_num)>);
@@ -49,8 +55,11 @@ class EthBlockTracker {
       base::OnceCallback<void(bool status, uint256_t block_num)>);
   void GetBlockNumber();
   void OnGetBlockNumber(bool status, uint256_t block_num);
+  void ScheduleTimer(base::TimeDelta interval);
 
   uint256_t current_block_ = 0;
+  base::TimeDelta base_interval_;
+  base::TimeDelta current_interval_;
   base::RepeatingTimer timer_;
 
   base::ObserverList<Observer> observers_;
@@ -156,6 +156,69 @@ TEST_F(EthBlockTrackerUnitTest, GetBlockNumber) {
   EXPECT_EQ(tracker.GetCurrentBlock(), uint256_t(3));
 }
 
+TEST_F(EthBlockTrackerUnitTest, AdaptiveInterval) {
+  EthBlockTracker tracker(rpc_controller_.get());
+  size_t requests = 0;
+  url_loader_factory_.SetInterceptor(
+      base::BindLambdaForTesting([&](const network::ResourceRequest& request) {
+        ++requests;
+        url_loader_factory_.ClearResponses();
+        url_loader_factory_.AddResponse(request.url.spec(),
+                                        GetResponseString());
+      }));
+  response_block_num_ = 1;
+  TrackerObserver observer;
+  tracker.AddObserver(&observer);
+
+  tracker.Start(base::TimeDelta::FromSeconds(5));
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(5));
+  EXPECT_EQ(requests, 1u);
+  EXPECT_EQ(observer.new_block_fired_, 1u);
+  EXPECT_EQ(tracker.GetCurrentIntervalForTesting(),
+            base::TimeDelta::FromSeconds(5));
+
+  // Same block, back off to 10s and then 20s.
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(5));
+  EXPECT_EQ(requests, 2u);
+  EXPECT_EQ(tracker.GetCurrentIntervalForTesting(),
+            base::TimeDelta::FromSeconds(10));
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(9));
+  EXPECT_EQ(requests, 2u);
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+  EXPECT_EQ(requests, 3u);
+  EXPECT_EQ(tracker.GetCurrentIntervalForTesting(),
+            base::TimeDelta::FromSeconds(20));
+
+  // Capped at 4x the base interval.
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(20));
+  EXPECT_EQ(requests, 4u);
+  EXPECT_EQ(tracker.GetCurrentIntervalForTesting(),
+            base::TimeDelta::FromSeconds(20));
+  EXPECT_EQ(observer.latest_block_fired_, 4u);
+  EXPECT_EQ(observer.new_block_fired_, 1u);
+
+  // A new block resets the interval.
+  response_block_num_ = 2;
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(20));
+  EXPECT_EQ(requests, 5u);
+  EXPECT_EQ(observer.new_block_fired_, 2u);
+  EXPECT_EQ(tracker.GetCurrentIntervalForTesting(),
+            base::TimeDelta::FromSeconds(5));
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(5));
+  EXPECT_EQ(requests, 6u);
+
+  // Restarting also resets the interval.
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(10));
+  EXPECT_EQ(tracker.GetCurrentIntervalForTesting(),
+            base::TimeDelta::FromSeconds(20));
+  tracker.Start(base::TimeDelta::FromSeconds(5));
+  EXPECT_EQ(tracker.GetCurrentIntervalForTesting(),
+            base::TimeDelta::FromSeconds(5));
+  tracker.Stop();
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(60));
+  EXPECT_FALSE(tracker.IsRunning());
+}
+
 TEST_F(EthBlockTrackerUnitTest, GetBlockNumberError) {
   EthBlockTracker tracker(rpc_controller_.get());
   url_loader_factory_.SetInterceptor(
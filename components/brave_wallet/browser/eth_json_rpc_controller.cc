@@ -7,9 +7,14 @@
 
 #include <utility>
 
+#include "base/barrier_closure.h"
 #include "base/bind.h"
 #include "base/environment.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
 #include "base/no_destructor.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/browser/eth_address.h"
@@ -37,6 +42,9 @@ namespace {
 constexpr char kDomainPattern[] =
     "(?:[A-Za-z0-9][A-Za-z0-9-]*[A-Za-z0-9]\\.)+[A-Za-z]{2,}$";
 
+// Record type of ENS content hashes in the domain resolution cache.
+constexpr char kEnsContentHashRecord[] = "ens:contenthash";
+
 net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTag() {
   return net::DefineNetworkTrafficAnnotation("eth_json_rpc_controller", R"(
       semantics {
@@ -60,6 +68,37 @@ net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTag() {
     )");
 }
 
+// The domain resolution cache stores a list of values per record, these adapt
+// single value lookups to it.
+void RunWithValueList(
+    brave_wallet::DomainResolutionCache::ResolveCallback callback,
+    bool success,
+    const std::string& value) {
+  if (!success) {
+    std::move(callback).Run(false, std::vector<std::string>());
+    return;
+  }
+  std::move(callback).Run(true, {value});
+}
+
+void RunWithSingleValue(
+    brave_wallet::EthJsonRpcController::StringResultCallback callback,
+    bool success,
+    const std::vector<std::string>& values) {
+  if (!success || values.size() != 1) {
+    std::move(callback).Run(false, "");
+    return;
+  }
+  std::move(callback).Run(true, values[0]);
+}
+
+// Receipts collected by EthJsonRpcController::GetTransactionReceiptsOneByOne.
+struct PendingReceipts {
+  explicit PendingReceipts(size_t count) : receipts(count) {}
+  std::vector<absl::optional<brave_wallet::TransactionReceipt>> receipts;
+  bool failed = false;
+};
+
 }  // namespace
 
 namespace brave_wallet {
@@ -123,6 +162,27 @@ void EthJsonRpcController::RequestInternal(const std::string& json_payload,
     }
   }
 
+  SendRequest(json_payload, auto_retry_on_network_change, network_url,
+              std::move(request_headers), std::move(callback));
+}
+
+void EthJsonRpcController::RequestBatch(const std::string& method,
+                                        const std::string& json_payload,
+                                        RequestCallback callback) {
+  // GetEthJsonRequestInfo only understands single requests, so the method of
+  // a batch is passed in by the caller.
+  base::flat_map<std::string, std::string> request_headers;
+  request_headers["X-Eth-Method"] = method;
+  SendRequest(json_payload, true, network_url_, std::move(request_headers),
+              std::move(callback));
+}
+
+void EthJsonRpcController::SendRequest(
+    const std::string& json_payload,
+    bool auto_retry_on_network_change,
+    const GURL& network_url,
+    base::flat_map<std::string, std::string> request_headers,
+    RequestCallback callback) {
   std::unique_ptr<base::Environment> env(base::Environment::Create());
   std::string brave_key(BRAVE_SERVICES_KEY);
   if (env->HasVar("BRAVE_SERVICES_KEY")) {
@@ -309,14 +369,19 @@ void EthJsonRpcController::SetCustomNetworkForTesting(
   FireNetworkChanged();
 }
 
+void EthJsonRpcController::ClearDomainResolutionCache() {
+  domain_resolution_cache_.Clear();
+}
+
 void EthJsonRpcController::GetBlockNumber(GetBlockNumberCallback callback) {
-  auto internal_callback =
-      base::BindOnce(&EthJsonRpcController::OnGetBlockNumber,
-                     weak_ptr_factory_.GetWeakPtr(), std::move(callback));
+  auto internal_callback = base::BindOnce(
+      &EthJsonRpcController::OnGetBlockNumber, weak_ptr_factory_.GetWeakPtr(),
+      chain_id_, std::move(callback));
   return Request(eth_blockNumber(), true, std::move(internal_callback));
 }
 
 void EthJsonRpcController::OnGetBlockNumber(
+    const std::string& chain_id,
     GetBlockNumberCallback callback,
     const int status,
     const std::string& body,
@@ -331,6 +396,7 @@ void EthJsonRpcController::OnGetBlockNumber(
     return;
   }
 
+  domain_resolution_cache_.OnNewBlock(chain_id, block_number);
   std::move(callback).Run(true, block_number);
 }
 
@@ -417,6 +483,91 @@ void EthJsonRpcController::OnGetTransactionReceipt(
   std::move(callback).Run(true, receipt);
 }
 
+void EthJsonRpcController::GetTransactionReceipts(
+    const std::vector<std::string>& tx_hashes,
+    GetTxReceiptsCallback callback) {
+  if (tx_hashes.empty()) {
+    std::move(callback).Run(true, {});
+    return;
+  }
+
+  base::Value batch(base::Value::Type::LIST);
+  for (size_t i = 0; i < tx_hashes.size(); ++i) {
+    absl::optional<base::Value> request =
+        base::JSONReader::Read(eth_getTransactionReceipt(tx_hashes[i]));
+    DCHECK(request && request->is_dict());
+    request->SetIntKey("id", i);
+    batch.Append(std::move(*request));
+  }
+  std::string json_payload;
+  base::JSONWriter::Write(batch, &json_payload);
+
+  auto internal_callback = base::BindOnce(
+      &EthJsonRpcController::OnGetTransactionReceipts,
+      weak_ptr_factory_.GetWeakPtr(), tx_hashes, std::move(callback));
+  RequestBatch(kEthGetTransactionReceipt, json_payload,
+               std::move(internal_callback));
+}
+
+void EthJsonRpcController::OnGetTransactionReceipts(
+    const std::vector<std::string>& tx_hashes,
+    GetTxReceiptsCallback callback,
+    const int status,
+    const std::string& body,
+    const base::flat_map<std::string, std::string>& headers) {
+  std::vector<absl::optional<TransactionReceipt>> receipts;
+  if (status < 200 || status > 299 ||
+      !ParseEthGetTransactionReceipts(body, tx_hashes.size(), &receipts)) {
+    // Many custom and local nodes reject batches, either with an HTTP error
+    // or with a single error object instead of an array.
+    GetTransactionReceiptsOneByOne(tx_hashes, std::move(callback));
+    return;
+  }
+
+  std::move(callback).Run(true, std::move(receipts));
+}
+
+void EthJsonRpcController::GetTransactionReceiptsOneByOne(
+    const std::vector<std::string>& tx_hashes,
+    GetTxReceiptsCallback callback) {
+  auto pending = std::make_unique<PendingReceipts>(tx_hashes.size());
+  PendingReceipts* pending_ptr = pending.get();
+  base::RepeatingClosure barrier = base::BarrierClosure(
+      tx_hashes.size(),
+      base::BindOnce(
+          [](GetTxReceiptsCallback callback,
+             std::unique_ptr<PendingReceipts> pending) {
+            if (pending->failed) {
+              std::move(callback).Run(false, {});
+              return;
+            }
+            std::move(callback).Run(true, std::move(pending->receipts));
+          },
+          std::move(callback), std::move(pending)));
+  for (size_t i = 0; i < tx_hashes.size(); ++i) {
+    Request(
+        eth_getTransactionReceipt(tx_hashes[i]), true,
+        base::BindOnce(
+            [](PendingReceipts* pending, size_t index,
+               base::RepeatingClosure barrier, const int status,
+               const std::string& body,
+               const base::flat_map<std::string, std::string>& headers) {
+              // Like in a batch, a null or unreadable result only means
+              // there is no receipt for this transaction.
+              base::Value result;
+              TransactionReceipt receipt;
+              if (status < 200 || status > 299) {
+                pending->failed = true;
+              } else if (ParseResult(body, &result) && !result.is_none() &&
+                         ParseTransactionReceiptResult(result, &receipt)) {
+                pending->receipts[index] = std::move(receipt);
+              }
+              barrier.Run();
+            },
+            pending_ptr, i, barrier));
+  }
+}
+
 void EthJsonRpcController::SendRawTransaction(const std::string& signed_tx,
                                               SendRawTxCallback callback) {
   auto internal_callback =
@@ -567,9 +718,21 @@ void EthJsonRpcController::EnsResolverGetContentHash(
     const std::string& chain_id,
     const std::string& domain,
     StringResultCallback callback) {
+  domain_resolution_cache_.Resolve(
+      chain_id, kEnsContentHashRecord, domain,
+      base::BindOnce(&EthJsonRpcController::ResolveEnsContentHash,
+                     weak_ptr_factory_.GetWeakPtr(), chain_id, domain),
+      base::BindOnce(&RunWithSingleValue, std::move(callback)));
+}
+
+void EthJsonRpcController::ResolveEnsContentHash(
+    const std::string& chain_id,
+    const std::string& domain,
+    DomainResolutionCache::ResolveCallback callback) {
   auto internal_callback = base::BindOnce(
       &EthJsonRpcController::ContinueEnsResolverGetContentHash,
-      weak_ptr_factory_.GetWeakPtr(), chain_id, domain, std::move(callback));
+      weak_ptr_factory_.GetWeakPtr(), chain_id, domain,
+      base::BindOnce(&RunWithValueList, std::move(callback)));
   EnsRegistryGetResolver(chain_id, domain, std::move(internal_callback));
 }
 
@@ -685,6 +848,18 @@ void EthJsonRpcController::UnstoppableDomainsProxyReaderGetMany(
     const std::string& domain,
     const std::vector<std::string>& keys,
     UnstoppableDomainsProxyReaderGetManyCallback callback) {
+  domain_resolution_cache_.Resolve(
+      chain_id, base::StrCat({"ud:", base::JoinString(keys, ",")}), domain,
+      base::BindOnce(&EthJsonRpcController::ResolveUnstoppableDomainsRecords,
+                     weak_ptr_factory_.GetWeakPtr(), chain_id, domain, keys),
+      std::move(callback));
+}
+
+void EthJsonRpcController::ResolveUnstoppableDomainsRecords(
+    const std::string& chain_id,
+    const std::string& domain,
+    const std::vector<std::string>& keys,
+    UnstoppableDomainsProxyReaderGetManyCallback callback) {
   const std::string contract_address =
       GetUnstoppableDomainsProxyReaderContractAddress(chain_id);
   if (contract_address.empty()) {
@@ -18,6 +18,7 @@
 #include "base/observer_list_threadsafe.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
+#include "brave/components/brave_wallet/browser/domain_resolution_cache.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "brave/components/brave_wallet/common/brave_wallet_types.h"
 #include "components/keyed_service/core/keyed_service.h"
@@ -25,6 +26,7 @@
 #include "mojo/public/cpp/bindings/receiver_set.h"
 #include "mojo/public/cpp/bindings/remote.h"
 #include "mojo/public/cpp/bindings/remote_set.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "url/gurl.h"
 
 namespace network {
@@ -66,6 +68,13 @@ class EthJsonRpcController : public KeyedService,
                bool auto_retry_on_network_change,
                RequestCallback callback) override;
 
+  // Sends the JSON-RPC batch |json_payload|. |method| is sent in the
+  // X-Eth-Method header, like the method of a single request is, and should
+  // be the one the batch is mostly made of.
+  void RequestBatch(const std::string& method,
+                    const std::string& json_payload,
+                    RequestCallback callback);
+
   void GetBalance(const std::string& address,
                   GetBalanceCallback callback) override;
 
@@ -79,6 +88,16 @@ class EthJsonRpcController : public KeyedService,
   void GetTransactionReceipt(const std::string& tx_hash,
                              GetTxReceiptCallback callback);
 
+  // Fetches the receipts of |tx_hashes| with a single JSON-RPC batch request,
+  // or with one request per hash if the node doesn't accept batches.
+  // |receipts| is index-aligned with |tx_hashes| and holds no value for
+  // transactions which are not mined yet.
+  using GetTxReceiptsCallback = base::OnceCallback<void(
+      bool status,
+      std::vector<absl::optional<TransactionReceipt>> receipts)>;
+  void GetTransactionReceipts(const std::vector<std::string>& tx_hashes,
+                              GetTxReceiptsCallback callback);
+
   using SendRawTxCallback =
       base::OnceCallback<void(bool status, const std::string& tx_hash)>;
   void SendRawTransaction(const std::string& signed_tx,
@@ -96,6 +115,7 @@ class EthJsonRpcController : public KeyedService,
       base::OnceCallback<void(bool success,
                               const std::vector<std::string>& values)>;
   // Call getMany function of ProxyReader contract from Unstoppable Domains.
+  // Results are served from |domain_resolution_cache_| when possible.
   void UnstoppableDomainsProxyReaderGetMany(
       const std::string& chain_id,
       const std::string& domain,
@@ -106,6 +126,7 @@ class EthJsonRpcController : public KeyedService,
       const std::string& domain,
       UnstoppableDomainsGetEthAddrCallback callback) override;
 
+  // Results are served from |domain_resolution_cache_| when possible.
   void EnsResolverGetContentHash(const std::string& chain_id,
                                  const std::string& domain,
                                  StringResultCallback callback);
@@ -140,6 +161,12 @@ class EthJsonRpcController : public KeyedService,
       mojom::EthJsonRpcController::GetNetworkUrlCallback callback) override;
   void SetCustomNetworkForTesting(const std::string& chain_id,
                                   const GURL& provider_url) override;
+  // Drops the resolved decentralized domains, e.g. when the history or the
+  // cache is cleared, as they tell which sites were visited.
+  void ClearDomainResolutionCache();
+  DomainResolutionCache* domain_resolution_cache_for_testing() {
+    return &domain_resolution_cache_;
+  }
 
   void AddObserver(::mojo::PendingRemote<mojom::EthJsonRpcControllerObserver>
                        observer) override;
@@ -194,6 +221,7 @@ class EthJsonRpcController : public KeyedService,
   bool HasRequestFromOrigin(const GURL& origin) const;
   void RemoveChainIdRequest(const std::string& chain_id);
   void OnGetBlockNumber(
+      const std::string& chain_id,
       GetBlockNumberCallback callback,
       const int status,
       const std::string& body,
@@ -212,6 +240,14 @@ class EthJsonRpcController : public KeyedService,
       const int status,
       const std::string& body,
       const base::flat_map<std::string, std::string>& headers);
+  void OnGetTransactionReceipts(
+      const std::vector<std::string>& tx_hashes,
+      GetTxReceiptsCallback callback,
+      const int status,
+      const std::string& body,
+      const base::flat_map<std::string, std::string>& headers);
+  void GetTransactionReceiptsOneByOne(const std::vector<std::string>& tx_hashes,
+                                      GetTxReceiptsCallback callback);
   void OnSendRawTransaction(
       SendRawTxCallback callback,
       const int status,
@@ -228,6 +264,12 @@ class EthJsonRpcController : public KeyedService,
       const std::string& body,
       const base::flat_map<std::string, std::string>& headers);
 
+  void ResolveUnstoppableDomainsRecords(
+      const std::string& chain_id,
+      const std::string& domain,
+      const std::vector<std::string>& keys,
+      UnstoppableDomainsProxyReaderGetManyCallback callback);
+
   void OnUnstoppableDomainsProxyReaderGetMany(
       UnstoppableDomainsProxyReaderGetManyCallback callback,
       const int status,
@@ -250,6 +292,10 @@ class EthJsonRpcController : public KeyedService,
       const std::string& body,
       const base::flat_map<std::string, std::string>& headers);
 
+  void ResolveEnsContentHash(const std::string& chain_id,
+                             const std::string& domain,
+                             DomainResolutionCache::ResolveCallback callback);
+
   void ContinueEnsResolverGetContentHash(const std::string& chain_id,
                                          const std::string& domain,
                                          StringResultCallback callback,
@@ -297,6 +343,11 @@ class EthJsonRpcController : public KeyedService,
                        bool auto_retry_on_network_change,
                        const GURL& network_url,
                        RequestCallback callback);
+  void SendRequest(const std::string& json_payload,
+                   bool auto_retry_on_network_change,
+                   const GURL& network_url,
+                   base::flat_map<std::string, std::string> request_headers,
+                   RequestCallback callback);
 
   FRIEND_TEST_ALL_PREFIXES(EthJsonRpcControllerUnitTest, IsValidDomain);
   bool IsValidDomain(const std::string& domain);
@@ -331,6 +382,7 @@ class EthJsonRpcController : public KeyedService,
 
   mojo::ReceiverSet<mojom::EthJsonRpcController> receivers_;
   PrefService* prefs_ = nullptr;
+  DomainResolutionCache domain_resolution_cache_;
   base::WeakPtrFactory<EthJsonRpcController> weak_ptr_factory_;
 };
 
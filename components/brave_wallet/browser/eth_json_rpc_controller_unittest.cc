@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "base/callback.h"
+#include "base/strings/string_util.h"
 #include "base/test/bind.h"
 #include "base/test/task_environment.h"
 #include "base/values.h"
@@ -476,8 +477,20 @@ TEST_F(EthJsonRpcControllerUnitTest, EnsResolverGetContentHash) {
   base::RunLoop().RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
+  // Served from the domain resolution cache.
   callback_called = false;
   SetErrorInterceptor();
+  rpc_controller_->EnsResolverGetContentHash(
+      mojom::kMainnetChainId, "brantly.eth",
+      base::BindLambdaForTesting([&](bool status, const std::string& result) {
+        callback_called = true;
+        EXPECT_TRUE(status);
+        EXPECT_FALSE(result.empty());
+      }));
+  EXPECT_TRUE(callback_called);
+
+  callback_called = false;
+  rpc_controller_->ClearDomainResolutionCache();
   rpc_controller_->EnsResolverGetContentHash(
       mojom::kMainnetChainId, "brantly.eth",
       base::BindOnce(&OnStringResponse, &callback_called, false, ""));
@@ -741,6 +754,128 @@ TEST_F(EthJsonRpcControllerUnitTest, GetBalance) {
   EXPECT_TRUE(callback_called);
 }
 
+TEST_F(EthJsonRpcControllerUnitTest, GetTransactionReceipts) {
+  size_t requests = 0;
+  url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+      [&](const network::ResourceRequest& request) {
+        ++requests;
+        std::string header_value;
+        EXPECT_TRUE(request.headers.GetHeader("X-Eth-Method", &header_value));
+        EXPECT_EQ(header_value, "eth_getTransactionReceipt");
+        EXPECT_TRUE(request.headers.GetHeader("x-brave-key", &header_value));
+        url_loader_factory_.ClearResponses();
+        url_loader_factory_.AddResponse(request.url.spec(), R"([
+          {"jsonrpc": "2.0", "id": 1, "result": null},
+          {"jsonrpc": "2.0", "id": 0, "result": {
+            "transactionHash": "0xb903239f8543d04b5dc1ba6579132b143087c68db1b2168786408fcbce568238",
+            "transactionIndex":  "0x1",
+            "blockNumber": "0xb",
+            "blockHash": "0xc6ef2fc5426d6ad6fd9e2a26abeab0aa2411b7ab17f30a99d3cb96aed1d1055b",
+            "cumulativeGasUsed": "0x33bc",
+            "gasUsed": "0x4dc",
+            "contractAddress": null,
+            "logs": [],
+            "logsBloom": "0x00...0",
+            "status": "0x1"
+          }}])");
+      }));
+
+  bool callback_called = false;
+  rpc_controller_->GetTransactionReceipts(
+      {"0xb903239f8543d04b5dc1ba6579132b143087c68db1b2168786408fcbce568238",
+       "0x1111111111111111111111111111111111111111111111111111111111111111"},
+      base::BindLambdaForTesting(
+          [&](bool status,
+              std::vector<absl::optional<TransactionReceipt>> receipts) {
+            callback_called = true;
+            EXPECT_TRUE(status);
+            ASSERT_EQ(receipts.size(), 2u);
+            ASSERT_TRUE(receipts[0]);
+            EXPECT_TRUE(receipts[0]->status);
+            EXPECT_FALSE(receipts[1]);
+          }));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(callback_called);
+  EXPECT_EQ(requests, 1u);
+
+  callback_called = false;
+  SetErrorInterceptor();
+  rpc_controller_->GetTransactionReceipts(
+      {"0xb903239f8543d04b5dc1ba6579132b143087c68db1b2168786408fcbce568238"},
+      base::BindLambdaForTesting(
+          [&](bool status,
+              std::vector<absl::optional<TransactionReceipt>> receipts) {
+            callback_called = true;
+            EXPECT_FALSE(status);
+            EXPECT_TRUE(receipts.empty());
+          }));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(callback_called);
+}
+
+TEST_F(EthJsonRpcControllerUnitTest, GetTransactionReceiptsWithoutBatches) {
+  const std::string mined_hash =
+      "0xb903239f8543d04b5dc1ba6579132b143087c68db1b2168786408fcbce568238";
+  std::vector<std::string> requests;
+  url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+      [&](const network::ResourceRequest& request) {
+        base::StringPiece request_string(request.request_body->elements()
+                                             ->at(0)
+                                             .As<network::DataElementBytes>()
+                                             .AsStringPiece());
+        requests.push_back(std::string(request_string));
+        std::string header_value;
+        EXPECT_TRUE(request.headers.GetHeader("X-Eth-Method", &header_value));
+        EXPECT_EQ(header_value, "eth_getTransactionReceipt");
+        url_loader_factory_.ClearResponses();
+        if (base::StartsWith(request_string, "[")) {
+          url_loader_factory_.AddResponse(request.url.spec(), R"({
+            "jsonrpc": "2.0", "id": null,
+            "error": {"code": -32600, "message": "Batches not supported"}})");
+        } else if (request_string.find(mined_hash) != std::string::npos) {
+          url_loader_factory_.AddResponse(request.url.spec(), R"({
+            "jsonrpc": "2.0", "id": 1, "result": {
+            "transactionHash": "0xb903239f8543d04b5dc1ba6579132b143087c68db1b2168786408fcbce568238",
+            "transactionIndex":  "0x1",
+            "blockNumber": "0xb",
+            "blockHash": "0xc6ef2fc5426d6ad6fd9e2a26abeab0aa2411b7ab17f30a99d3cb96aed1d1055b",
+            "cumulativeGasUsed": "0x33bc",
+            "gasUsed": "0x4dc",
+            "contractAddress": null,
+            "logs": [],
+            "logsBloom": "0x00...0",
+            "status": "0x1"
+          }})");
+        } else {
+          url_loader_factory_.AddResponse(
+              request.url.spec(),
+              R"({"jsonrpc": "2.0", "id": 1, "result": null})");
+        }
+      }));
+
+  bool callback_called = false;
+  rpc_controller_->GetTransactionReceipts(
+      {mined_hash,
+       "0x1111111111111111111111111111111111111111111111111111111111111111"},
+      base::BindLambdaForTesting(
+          [&](bool status,
+              std::vector<absl::optional<TransactionReceipt>> receipts) {
+            callback_called = true;
+            EXPECT_TRUE(status);
+            ASSERT_EQ(receipts.size(), 2u);
+            ASSERT_TRUE(receipts[0]);
+            EXPECT_TRUE(receipts[0]->status);
+            EXPECT_FALSE(receipts[1]);
+          }));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(callback_called);
+  // The rejected batch, then one request per transaction.
+  ASSERT_EQ(requests.size(), 3u);
+  EXPECT_TRUE(base::StartsWith(requests[0], "["));
+  EXPECT_FALSE(base::StartsWith(requests[1], "["));
+  EXPECT_FALSE(base::StartsWith(requests[2], "["));
+}
+
 TEST_F(EthJsonRpcControllerUnitTest, GetERC20TokenBalance) {
   bool callback_called = false;
   SetInterceptor(
@@ -868,8 +1003,19 @@ TEST_F(EthJsonRpcControllerUnitTest, UnstoppableDomainsProxyReaderGetMany) {
   base::RunLoop().RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
+  // Served from the domain resolution cache.
   callback_called = false;
   SetErrorInterceptor();
+  rpc_controller_->UnstoppableDomainsProxyReaderGetMany(
+      mojom::kMainnetChainId, "brave.crypto" /* domain */,
+      {"dweb.ipfs.hash", "ipfs.html.value", "browser.redirect_url",
+       "ipfs.redirect_domain.value"} /* keys */,
+      base::BindOnce(&OnStringsResponse, &callback_called, true,
+                     expected_values));
+  EXPECT_TRUE(callback_called);
+
+  callback_called = false;
+  rpc_controller_->ClearDomainResolutionCache();
   rpc_controller_->UnstoppableDomainsProxyReaderGetMany(
       mojom::kMainnetChainId, "brave.crypto" /* domain */,
       {"dweb.ipfs.hash", "ipfs.html.value", "browser.redirect_url",
@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "base/logging.h"
 #include "base/synchronization/lock.h"
@@ -33,16 +34,22 @@ bool EthPendingTxTracker::UpdatePendingTransactions(size_t* num_pending) {
 
   auto pending_transactions = tx_state_manager_->GetTransactionsByStatus(
       mojom::TransactionStatus::Submitted, absl::nullopt);
+  std::vector<std::string> ids;
+  std::vector<std::string> tx_hashes;
   for (const auto& pending_transaction : pending_transactions) {
     if (IsNonceTaken(*pending_transaction)) {
       DropTransaction(pending_transaction.get());
       continue;
     }
-    std::string id = pending_transaction->id;
-    rpc_controller_->GetTransactionReceipt(
-        pending_transaction->tx_hash,
-        base::BindOnce(&EthPendingTxTracker::OnGetTxReceipt,
-                       weak_factory_.GetWeakPtr(), std::move(id)));
+    ids.push_back(pending_transaction->id);
+    tx_hashes.push_back(pending_transaction->tx_hash);
+  }
+  // All receipts are checked with one batch request per block instead of one
+  // request per pending transaction.
+  if (!tx_hashes.empty()) {
+    rpc_controller_->GetTransactionReceipts(
+        tx_hashes, base::BindOnce(&EthPendingTxTracker::OnGetTxReceipts,
+                                  weak_factory_.GetWeakPtr(), std::move(ids)));
   }
 
   nonce_lock->Release();
@@ -65,28 +72,32 @@ void EthPendingTxTracker::ResubmitPendingTransactions() {
   }
 }
 
-void EthPendingTxTracker::OnGetTxReceipt(std::string id,
-                                         bool status,
-                                         TransactionReceipt receipt) {
-  if (!status)
+void EthPendingTxTracker::OnGetTxReceipts(
+    std::vector<std::string> ids,
+    bool status,
+    std::vector<absl::optional<TransactionReceipt>> receipts) {
+  if (!status || receipts.size() != ids.size())
     return;
   base::Lock* nonce_lock = nonce_tracker_->GetLock();
   if (!nonce_lock->Try())
     return;
 
-  std::unique_ptr<EthTxStateManager::TxMeta> meta =
-      tx_state_manager_->GetTx(id);
-  if (!meta) {
-    nonce_lock->Release();
-    return;
-  }
-  if (receipt.status) {
-    meta->tx_receipt = receipt;
-    meta->status = mojom::TransactionStatus::Confirmed;
-    meta->confirmed_time = base::Time::Now();
-    tx_state_manager_->AddOrUpdateTx(*meta);
-  } else if (ShouldTxDropped(*meta)) {
-    DropTransaction(meta.get());
+  for (size_t i = 0; i < ids.size(); ++i) {
+    // Not mined yet.
+    if (!receipts[i])
+      continue;
+    std::unique_ptr<EthTxStateManager::TxMeta> meta =
+        tx_state_manager_->GetTx(ids[i]);
+    if (!meta)
+      continue;
+    if (receipts[i]->status) {
+      meta->tx_receipt = *receipts[i];
+      meta->status = mojom::TransactionStatus::Confirmed;
+      meta->confirmed_time = base::Time::Now();
+      tx_state_manager_->AddOrUpdateTx(*meta);
+    } else if (ShouldTxDropped(*meta)) {
+      DropTransaction(meta.get());
+    }
   }
 
   nonce_lock->Release();
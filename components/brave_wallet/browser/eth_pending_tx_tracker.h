@@ -7,12 +7,14 @@
 #define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ETH_PENDING_TX_TRACKER_H_
 
 #include <string>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/gtest_prod_util.h"
 #include "base/memory/weak_ptr.h"
 #include "brave/components/brave_wallet/browser/eth_tx_state_manager.h"
 #include "brave/components/brave_wallet/common/brave_wallet_types.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace brave_wallet {
 
@@ -36,7 +38,9 @@ class EthPendingTxTracker {
   FRIEND_TEST_ALL_PREFIXES(EthPendingTxTrackerUnitTest, ShouldTxDropped);
   FRIEND_TEST_ALL_PREFIXES(EthPendingTxTrackerUnitTest, DropTransaction);
 
-  void OnGetTxReceipt(std::string id, bool status, TransactionReceipt receipt);
+  void OnGetTxReceipts(std::vector<std::string> ids,
+                       bool status,
+                       std::vector<absl::optional<TransactionReceipt>> receipts);
   void OnGetNetworkNonce(std::string address, bool status, uint256_t result);
   void OnSendRawTransaction(bool status, const std::string& tx_hash);
 
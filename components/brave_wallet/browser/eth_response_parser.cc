@@ -138,6 +138,43 @@ bool ParseEthGetTransactionReceipt(const std::string& json,
   base::Value result;
   if (!ParseResult(json, &result))
     return false;
+  return ParseTransactionReceiptResult(result, receipt);
+}
+
+bool ParseEthGetTransactionReceipts(
+    const std::string& json,
+    size_t count,
+    std::vector<absl::optional<TransactionReceipt>>* receipts) {
+  DCHECK(receipts);
+
+  absl::optional<base::Value> response =
+      base::JSONReader::Read(json, base::JSON_PARSE_RFC);
+  if (!response || !response->is_list())
+    return false;
+
+  std::vector<absl::optional<TransactionReceipt>> parsed(count);
+  for (const auto& item : response->GetList()) {
+    absl::optional<int> id = item.FindIntKey("id");
+    if (!id || *id < 0 || static_cast<size_t>(*id) >= count)
+      return false;
+    // A null result means the transaction is not mined yet, and a per-item
+    // error should not discard the receipts of the other transactions.
+    const base::Value* result = item.FindKey("result");
+    if (!result)
+      continue;
+    TransactionReceipt receipt;
+    if (ParseTransactionReceiptResult(*result, &receipt))
+      parsed[*id] = std::move(receipt);
+  }
+
+  *receipts = std::move(parsed);
+  return true;
+}
+
+bool ParseTransactionReceiptResult(const base::Value& result,
+                                   TransactionReceipt* receipt) {
+  DCHECK(receipt);
+
   const base::DictionaryValue* result_dict = nullptr;
   if (!result.GetAsDictionary(&result_dict))
     return false;
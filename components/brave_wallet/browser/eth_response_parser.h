@@ -11,6 +11,7 @@
 
 #include "base/values.h"
 #include "brave/components/brave_wallet/common/brave_wallet_types.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace brave_wallet {
 
@@ -23,6 +24,15 @@ bool ParseEthGetBalance(const std::string& json, std::string* hex_balance);
 bool ParseEthGetTransactionCount(const std::string& json, uint256_t* count);
 bool ParseEthGetTransactionReceipt(const std::string& json,
                                    TransactionReceipt* receipt);
+// Parses a JSON-RPC batch of eth_getTransactionReceipt responses whose ids are
+// 0..count-1. Entries for transactions that are not mined yet are left empty.
+bool ParseEthGetTransactionReceipts(
+    const std::string& json,
+    size_t count,
+    std::vector<absl::optional<TransactionReceipt>>* receipts);
+// Parses the result object of a single eth_getTransactionReceipt response.
+bool ParseTransactionReceiptResult(const base::Value& result,
+                                   TransactionReceipt* receipt);
 bool ParseEthSendRawTransaction(const std::string& json, std::string* tx_hash);
 bool ParseEthCall(const std::string& json, std::string* result);
 bool ParseEthEstimateGas(const std::string& json, std::string* result);
@@ -103,6 +103,47 @@ TEST(EthResponseParserUnitTest, ParseEthGetTransactionReceipt) {
   EXPECT_TRUE(receipt.status);
 }
 
+TEST(EthResponseParserUnitTest, ParseEthGetTransactionReceipts) {
+  // Out of order, with a pending transaction and a per-item error.
+  std::string json(
+      R"([{
+      "id": 2,
+      "jsonrpc": "2.0",
+      "result": {
+        "transactionHash": "0xb903239f8543d04b5dc1ba6579132b143087c68db1b2168786408fcbce568238",
+        "transactionIndex":  "0x1",
+        "blockNumber": "0xb",
+        "blockHash": "0xc6ef2fc5426d6ad6fd9e2a26abeab0aa2411b7ab17f30a99d3cb96aed1d1055b",
+        "cumulativeGasUsed": "0x33bc",
+        "gasUsed": "0x4dc",
+        "contractAddress": null,
+        "logs": [],
+        "logsBloom": "0x00...0",
+        "status": "0x0"
+      }
+    },
+    {"id": 0, "jsonrpc": "2.0", "result": null},
+    {"id": 1, "jsonrpc": "2.0", "error": {"code": -32000, "message": "x"}}])");
+  std::vector<absl::optional<TransactionReceipt>> receipts;
+  ASSERT_TRUE(ParseEthGetTransactionReceipts(json, 3, &receipts));
+  ASSERT_EQ(receipts.size(), 3u);
+  EXPECT_FALSE(receipts[0]);
+  EXPECT_FALSE(receipts[1]);
+  ASSERT_TRUE(receipts[2]);
+  EXPECT_EQ(
+      receipts[2]->transaction_hash,
+      "0xb903239f8543d04b5dc1ba6579132b143087c68db1b2168786408fcbce568238");
+  EXPECT_EQ(receipts[2]->block_number, (uint256_t)11);
+  EXPECT_FALSE(receipts[2]->status);
+
+  // Not a batch response
+  EXPECT_FALSE(ParseEthGetTransactionReceipts(
+      R"({"id": 0, "jsonrpc": "2.0", "result": null})", 1, &receipts));
+  // Unknown id
+  EXPECT_FALSE(ParseEthGetTransactionReceipts(
+      R"([{"id": 1, "jsonrpc": "2.0", "result": null}])", 1, &receipts));
+}
+
 TEST(EthResponseParserUnitTest, ParseEthGetTransactionReceiptNullContractAddr) {
   std::string json(
       R"({
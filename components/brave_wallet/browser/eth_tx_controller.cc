@@ -12,9 +12,11 @@
 #include <vector>
 
 #include "base/bind.h"
+#include "base/callback_helpers.h"
 #include "base/logging.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
+#include "brave/components/brave_wallet/browser/account_discovery_manager.h"
 #include "brave/components/brave_wallet/browser/asset_ratio_controller.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/browser/eip1559_transaction.h"
@@ -119,6 +121,9 @@ EthTxController::EthTxController(
       nonce_tracker_(std::move(nonce_tracker)),
       pending_tx_tracker_(std::move(pending_tx_tracker)),
       eth_block_tracker_(std::make_unique<EthBlockTracker>(rpc_controller)),
+      account_discovery_manager_(
+          std::make_unique<AccountDiscoveryManager>(rpc_controller,
+                                                    keyring_controller)),
       weak_factory_(this) {
   DCHECK(rpc_controller_);
   DCHECK(keyring_controller_);
@@ -864,6 +869,7 @@ void EthTxController::UpdatePendingTransactions() {
 }
 
 void EthTxController::Locked() {
+  account_discovery_manager_->Stop();
   CheckIfBlockTrackerShouldRun();
 }
 
@@ -878,6 +884,7 @@ void EthTxController::KeyringCreated() {
 
 void EthTxController::KeyringRestored() {
   UpdatePendingTransactions();
+  account_discovery_manager_->StartDiscovery(base::DoNothing());
 }
 
 void EthTxController::SpeedupOrCancelTransaction(
@@ -31,6 +31,7 @@ namespace brave_wallet {
 
 class EthTxControllerUnitTest;
 
+class AccountDiscoveryManager;
 class AssetRatioController;
 class EthJsonRpcController;
 class KeyringController;
@@ -220,6 +221,7 @@ class EthTxController : public KeyedService,
   std::unique_ptr<EthNonceTracker> nonce_tracker_;
   std::unique_ptr<EthPendingTxTracker> pending_tx_tracker_;
   std::unique_ptr<EthBlockTracker> eth_block_tracker_;
+  std::unique_ptr<AccountDiscoveryManager> account_discovery_manager_;
   bool known_no_pending_tx = false;
 
   mojo::RemoteSet<mojom::EthTxControllerObserver> observers_;
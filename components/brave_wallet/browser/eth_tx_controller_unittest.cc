@@ -1390,7 +1390,6 @@ TEST_F(EthTxControllerUnitTest, TestSubmittedToConfirmed) {
         url_loader_factory_.ClearResponses();
         std::string header_value;
         EXPECT_TRUE(request.headers.GetHeader("X-Eth-Method", &header_value));
-        LOG(ERROR) << "Header value is: " << header_value;
         if (header_value == "eth_blockNumber") {
           url_loader_factory_.AddResponse(request.url.spec(), R"(
             {
@@ -1399,11 +1398,7 @@ TEST_F(EthTxControllerUnitTest, TestSubmittedToConfirmed) {
               "id":1
             })");
         } else if (header_value == "eth_getTransactionReceipt") {
-          url_loader_factory_.AddResponse(request.url.spec(), R"(
-            {
-              "jsonrpc": "2.0",
-              "id":1,
-              "result": {
+          const std::string receipt = R"({
                 "transactionHash": "0xb903239f8543d04b5dc1ba6579132b143087c68db1b2168786408fcbce568238",
                 "transactionIndex":  "0x1",
                 "blockNumber": "0xb",
@@ -1414,8 +1409,12 @@ TEST_F(EthTxControllerUnitTest, TestSubmittedToConfirmed) {
                 "logs": [],
                 "logsBloom": "0x00...0",
                 "status": "0x1"
-              }
-            })");
+              })";
+          url_loader_factory_.AddResponse(
+              request.url.spec(),
+              R"([{"jsonrpc": "2.0", "id": 0, "result": )" + receipt +
+                  R"(}, {"jsonrpc": "2.0", "id": 1, "result": )" + receipt +
+                  "}]");
         }
       }));
 
@@ -14,6 +14,23 @@
 
 namespace brave_wallet {
 
+namespace {
+
+std::string GetAddressFromHDKey(const HDKey* hd_key) {
+  if (!hd_key)
+    return std::string();
+  const std::vector<uint8_t> public_key = hd_key->GetUncompressedPublicKey();
+  // trim the header byte 0x04
+  const std::vector<uint8_t> pubkey_no_header(public_key.begin() + 1,
+                                              public_key.end());
+  EthAddress addr = EthAddress::FromPublicKey(pubkey_no_header);
+
+  // TODO(darkdh): chain id op code
+  return addr.ToChecksumAddress();
+}
+
+}  // namespace
+
 HDKeyring::HDKeyring() = default;
 HDKeyring::~HDKeyring() = default;
 
@@ -36,6 +53,7 @@ void HDKeyring::AddAccounts(size_t number) {
   for (size_t i = cur_accounts_number; i < cur_accounts_number + number; ++i) {
     if (root_) {
       accounts_.push_back(root_->DeriveChild(i));
+      account_addresses_.push_back(GetAddressInternal(accounts_.back().get()));
     }
   }
 }
@@ -64,6 +82,7 @@ size_t HDKeyring::GetAccountsNumber() const {
 
 void HDKeyring::RemoveAccount() {
   accounts_.pop_back();
+  account_addresses_.pop_back();
 }
 
 std::string HDKeyring::ImportAccount(const std::vector<uint8_t>& private_key) {
@@ -94,22 +113,40 @@ bool HDKeyring::RemoveImportedAccount(const std::string& address) {
 }
 
 std::string HDKeyring::GetAddress(size_t index) const {
-  if (accounts_.empty() || index >= accounts_.size())
+  if (account_addresses_.empty() || index >= account_addresses_.size())
     return std::string();
-  return GetAddressInternal(accounts_[index].get());
+  return account_addresses_[index];
 }
 
-std::string HDKeyring::GetAddressInternal(const HDKey* hd_key) const {
-  if (!hd_key)
+std::string HDKeyring::GetRootPublicExtendedKey() const {
+  if (!root_)
     return std::string();
-  const std::vector<uint8_t> public_key = hd_key->GetUncompressedPublicKey();
-  // trim the header byte 0x04
-  const std::vector<uint8_t> pubkey_no_header(public_key.begin() + 1,
-                                              public_key.end());
-  EthAddress addr = EthAddress::FromPublicKey(pubkey_no_header);
+  return root_->GetPublicExtendedKey();
+}
 
-  // TODO(darkdh): chain id op code
-  return addr.ToChecksumAddress();
+// static
+std::vector<std::string> HDKeyring::DeriveAddressesFromPublicExtendedKey(
+    const std::string& public_extended_key,
+    size_t start,
+    size_t count) {
+  std::vector<std::string> addresses;
+  std::unique_ptr<HDKey> root =
+      HDKey::GenerateFromExtendedKey(public_extended_key);
+  if (!root)
+    return addresses;
+
+  addresses.reserve(count);
+  for (size_t i = start; i < start + count; ++i) {
+    std::unique_ptr<HDKey> child = root->DeriveChild(i);
+    if (!child)
+      return std::vector<std::string>();
+    addresses.push_back(GetAddressFromHDKey(child.get()));
+  }
+  return addresses;
+}
+
+std::string HDKeyring::GetAddressInternal(const HDKey* hd_key) const {
+  return GetAddressFromHDKey(hd_key);
 }
 
 void HDKeyring::SignTransaction(const std::string& address,
@@ -48,6 +48,17 @@ class HDKeyring {
   // Bitcoin keyring can override this for different address calculation
   virtual std::string GetAddress(size_t index) const;
 
+  // Serialized public extended key of the account root, it doesn't contain any
+  // private material so it is safe to hand over to other sequences.
+  std::string GetRootPublicExtendedKey() const;
+
+  // Derive |count| addresses starting from |start| using only the public
+  // extended key of the root. This can be run on any sequence.
+  static std::vector<std::string> DeriveAddressesFromPublicExtendedKey(
+      const std::string& public_extended_key,
+      size_t start,
+      size_t count);
+
   // TODO(darkdh): Abstract Transacation class
   // eth_signTransaction
   virtual void SignTransaction(const std::string& address,
@@ -67,6 +78,8 @@ class HDKeyring {
   std::unique_ptr<HDKey> root_;
   std::unique_ptr<HDKey> master_key_;
   std::vector<std::unique_ptr<HDKey>> accounts_;
+  // Addresses of |accounts_| computed once when accounts are derived
+  std::vector<std::string> account_addresses_;
   // (address, key)
   base::flat_map<std::string, std::unique_ptr<HDKey>> imported_accounts_;
 
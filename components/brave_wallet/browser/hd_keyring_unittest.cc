@@ -81,6 +81,31 @@ TEST(HDKeyringUnitTest, Accounts) {
   EXPECT_TRUE(keyring2.GetAddress(0).empty());
 }
 
+TEST(HDKeyringUnitTest, DeriveAddressesFromPublicExtendedKey) {
+  HDKeyring keyring;
+  EXPECT_TRUE(keyring.GetRootPublicExtendedKey().empty());
+  std::vector<uint8_t> seed;
+  EXPECT_TRUE(base::HexStringToBytes(
+      "13ca6c28d26812f82db27908de0b0b7b18940cc4e9d96ebd7de190f706741489907ef65b"
+      "8f9e36c31dc46e81472b6a5e40a4487e725ace445b8203f243fb8958",
+      &seed));
+  keyring.ConstructRootHDKey(seed, "m/44'/60'/0'/0");
+  const std::string xpub = keyring.GetRootPublicExtendedKey();
+  EXPECT_EQ(xpub,
+            "xpub6EXd1H5eKChcaTUQGEwf4irLZx6bruKDhpwEjw1Y2T2yqyBFzw1yhJ7nA5EeBK"
+            "ozqYKB8jHxmhe7bEqyBEdPNWyPgCm2aZfs9tbLVYujvL3");
+
+  std::vector<std::string> addresses =
+      HDKeyring::DeriveAddressesFromPublicExtendedKey(xpub, 1, 2);
+  ASSERT_EQ(addresses.size(), 2u);
+  EXPECT_EQ(addresses[0], "0x2A22ad45446E8b34Da4da1f4ADd7B1571Ab4e4E7");
+  EXPECT_EQ(addresses[1], "0x02e77f0e2fa06F95BDEa79Fad158477723145838");
+
+  keyring.AddAccounts(3);
+  EXPECT_EQ(HDKeyring::DeriveAddressesFromPublicExtendedKey(xpub, 0, 3),
+            keyring.GetAccounts());
+}
+
 TEST(HDKeyringUnitTest, SignTransaction) {
   // Specific signature check is in eth_transaction_unittest.cc
   HDKeyring keyring;
@@ -13,6 +13,7 @@
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
 #include "base/value_iterators.h"
 #include "base/values.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
@@ -26,6 +27,7 @@
 #include "components/prefs/pref_change_registrar.h"
 #include "components/prefs/pref_service.h"
 #include "components/prefs/scoped_user_pref_update.h"
+#include "crypto/hmac.h"
 #include "crypto/random.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 #include "ui/base/l10n/l10n_util.h"
@@ -87,6 +89,9 @@ namespace brave_wallet {
 namespace {
 const size_t kSaltSize = 32;
 const size_t kNonceSize = 12;
+const size_t kPbkdf2Iterations = 100000;
+const size_t kPbkdf2KeySize = 256;
+const size_t kPasswordDigestKeySize = 32;
 const char kRootPath[] = "m/44'/60'/0'/0";
 const char kDefaultKeyringId[] = "default";
 const char kPasswordEncryptorSalt[] = "password_encryptor_salt";
@@ -112,6 +117,15 @@ std::string GetAccountName(size_t number) {
                                    base::NumberToString16(number));
 }
 
+// Runs on the thread pool, PBKDF2 with 100k iterations takes hundreds of
+// milliseconds on slower devices.
+std::unique_ptr<PasswordEncryptor> DeriveEncryptorFromPassword(
+    const std::string& password,
+    const std::vector<uint8_t>& salt) {
+  return PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
+      password, salt, kPbkdf2Iterations, kPbkdf2KeySize);
+}
+
 void SerializeHardwareAccounts(const std::string& device_id,
                                const base::Value* account_value,
                                std::vector<mojom::AccountInfoPtr>* accounts) {
@@ -142,8 +156,16 @@ void SerializeHardwareAccounts(const std::string& device_id,
 
 }  // namespace
 
-KeyringController::KeyringController(PrefService* prefs) : prefs_(prefs) {
+KeyringController::PendingUnlock::PendingUnlock() = default;
+KeyringController::PendingUnlock::~PendingUnlock() = default;
+
+KeyringController::KeyringController(PrefService* prefs)
+    : password_digest_key_(kPasswordDigestKeySize),
+      prefs_(prefs),
+      weak_ptr_factory_(this),
+      unlock_weak_ptr_factory_(this) {
   DCHECK(prefs);
+  crypto::RandBytes(password_digest_key_);
   auto_lock_timer_ = std::make_unique<base::OneShotTimer>();
 
   pref_change_registrar_ = std::make_unique<PrefChangeRegistrar>();
@@ -450,6 +472,11 @@ HDKeyring* KeyringController::ResumeDefaultKeyring(
     return nullptr;
   }
 
+  return ResumeDefaultKeyringWithEncryptor();
+}
+
+HDKeyring* KeyringController::ResumeDefaultKeyringWithEncryptor() {
+  DCHECK(encryptor_);
   const std::string mnemonic = GetMnemonicForDefaultKeyringImpl();
   bool is_legacy_brave_wallet = false;
   const base::Value* value =
@@ -467,9 +494,15 @@ HDKeyring* KeyringController::ResumeDefaultKeyring(
   // TODO(bbondy):
   // We can remove this some months after the initial wallet launch
   // We didn't store account address in meta pref originally.
+  // Only touch the pref when the persisted address is missing or stale so
+  // unlocking doesn't rewrite the whole keyrings dictionary.
   for (size_t i = 0; i < account_no; ++i) {
-    SetAccountMetaForKeyring(prefs_, GetAccountPathByIndex(i), absl::nullopt,
-                             default_keyring_->GetAddress(i),
+    const std::string account_path = GetAccountPathByIndex(i);
+    const std::string address = default_keyring_->GetAddress(i);
+    if (GetAccountAddressForKeyring(prefs_, account_path, kDefaultKeyringId) ==
+        address)
+      continue;
+    SetAccountMetaForKeyring(prefs_, account_path, absl::nullopt, address,
                              kDefaultKeyringId);
   }
 
@@ -572,7 +605,8 @@ void KeyringController::RestoreWallet(const std::string& mnemonic,
   if (keyring && !keyring->GetAccountsNumber()) {
     AddAccountForDefaultKeyring(GetAccountName(1));
   }
-  // TODO(darkdh): add account discovery mechanism
+  // Accounts with on-chain activity are added by AccountDiscoveryManager once
+  // KeyringRestored is observed.
 
   std::move(callback).Run(keyring);
 }
@@ -659,8 +693,24 @@ void KeyringController::ImportAccountFromJson(const std::string& account_name,
     std::move(callback).Run(false, "");
     return;
   }
-  std::unique_ptr<HDKey> hd_key = HDKey::GenerateFromV3UTC(password, json);
-  if (!hd_key) {
+  // Keystore files use scrypt or pbkdf2 which are deliberately slow, so the
+  // key is derived on the thread pool.
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::TaskPriority::USER_BLOCKING,
+       base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
+      base::BindOnce(&HDKey::GenerateFromV3UTC, password, json),
+      base::BindOnce(&KeyringController::OnImportAccountFromJsonKeyDerived,
+                     weak_ptr_factory_.GetWeakPtr(), account_name,
+                     std::move(callback)));
+}
+
+void KeyringController::OnImportAccountFromJsonKeyDerived(
+    const std::string& account_name,
+    ImportAccountCallback callback,
+    std::unique_ptr<HDKey> hd_key) {
+  // Wallet could be locked while the key was being derived
+  if (!hd_key || !encryptor_) {
     std::move(callback).Run(false, "");
     return;
   }
@@ -794,13 +844,24 @@ std::vector<mojom::AccountInfoPtr> KeyringController::GetAccountInfosForKeyring(
     const std::string& id) {
   std::vector<mojom::AccountInfoPtr> result;
 
-  size_t account_no = GetAccountMetasNumberForKeyring(kDefaultKeyringId);
+  // Addresses are persisted in account metas when accounts are derived, so
+  // read them in a single pass instead of re-deriving or re-walking the
+  // keyring dictionary for each account.
+  const base::Value* account_metas =
+      GetPrefForKeyring(prefs_, kAccountMetas, id);
+  size_t account_no = account_metas ? account_metas->DictSize() : 0;
   for (size_t i = 0; i < account_no; ++i) {
     mojom::AccountInfoPtr account_info = mojom::AccountInfo::New();
-    account_info->address =
-        GetAccountAddressForKeyring(prefs_, GetAccountPathByIndex(i), id);
-    account_info->name =
-        GetAccountNameForKeyring(prefs_, GetAccountPathByIndex(i), id);
+    const base::Value* account_meta =
+        account_metas->FindDictKey(GetAccountPathByIndex(i));
+    if (account_meta) {
+      const std::string* address = account_meta->FindStringKey(kAccountAddress);
+      if (address)
+        account_info->address = *address;
+      const std::string* name = account_meta->FindStringKey(kAccountName);
+      if (name)
+        account_info->name = *name;
+    }
     account_info->is_imported = false;
     result.push_back(std::move(account_info));
   }
@@ -970,16 +1031,36 @@ void KeyringController::AddAccountsWithDefaultName(size_t number) {
   }
 }
 
+std::string KeyringController::GetDefaultKeyringPublicExtendedKey() const {
+  if (!default_keyring_)
+    return std::string();
+  return default_keyring_->GetRootPublicExtendedKey();
+}
+
+void KeyringController::AddDiscoveredAccountsForDefaultKeyring(
+    size_t accounts_number) {
+  if (!default_keyring_)
+    return;
+
+  size_t current_num = default_keyring_->GetAccountsNumber();
+  if (accounts_number <= current_num)
+    return;
+  AddAccountsWithDefaultName(accounts_number - current_num);
+  NotifyAccountsChanged();
+}
+
 bool KeyringController::IsLocked() const {
   return encryptor_ == nullptr;
 }
 
 void KeyringController::Lock() {
+  CancelPendingUnlock();
   if (IsLocked() || !default_keyring_)
     return;
   default_keyring_.reset();
 
   encryptor_.reset();
+  session_password_digest_.clear();
   for (const auto& observer : observers_) {
     observer->Locked();
   }
@@ -997,19 +1078,96 @@ bool KeyringController::IsHardwareAccount(const std::string& account) const {
 
 void KeyringController::Unlock(const std::string& password,
                                UnlockCallback callback) {
-  if (!ResumeDefaultKeyring(password)) {
-    encryptor_.reset();
+  if (password.empty()) {
     std::move(callback).Run(false);
     return;
   }
 
+  const std::string password_digest = GetPasswordDigest(password);
+  // Encryptor derived from the same password is kept until auto lock so
+  // there is no need to derive it again.
+  if (!IsLocked() && default_keyring_ &&
+      password_digest == session_password_digest_) {
+    OnUnlockSucceeded();
+    std::move(callback).Run(true);
+    return;
+  }
+
+  // Coalesce repeated attempts with the same password into the one in flight
+  if (pending_unlock_ && pending_unlock_->password_digest == password_digest) {
+    pending_unlock_->callbacks.push_back(std::move(callback));
+    return;
+  }
+  CancelPendingUnlock();
+
+  std::vector<uint8_t> salt(kSaltSize);
+  if (!GetPrefInBytesForKeyring(kPasswordEncryptorSalt, &salt,
+                                kDefaultKeyringId)) {
+    std::move(callback).Run(false);
+    return;
+  }
+
+  pending_unlock_ = std::make_unique<PendingUnlock>();
+  pending_unlock_->password_digest = password_digest;
+  pending_unlock_->callbacks.push_back(std::move(callback));
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::TaskPriority::USER_BLOCKING,
+       base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
+      base::BindOnce(&DeriveEncryptorFromPassword, password, std::move(salt)),
+      base::BindOnce(&KeyringController::OnUnlockEncryptorDerived,
+                     unlock_weak_ptr_factory_.GetWeakPtr()));
+}
+
+void KeyringController::OnUnlockEncryptorDerived(
+    std::unique_ptr<PasswordEncryptor> encryptor) {
+  DCHECK(pending_unlock_);
+  std::unique_ptr<PendingUnlock> pending_unlock = std::move(pending_unlock_);
+
+  bool success = false;
+  if (encryptor) {
+    encryptor_ = std::move(encryptor);
+    success = ResumeDefaultKeyringWithEncryptor() != nullptr;
+  }
+
+  if (success) {
+    session_password_digest_ = pending_unlock->password_digest;
+    OnUnlockSucceeded();
+  } else {
+    encryptor_.reset();
+    session_password_digest_.clear();
+  }
+
+  for (auto& callback : pending_unlock->callbacks)
+    std::move(callback).Run(success);
+}
+
+void KeyringController::OnUnlockSucceeded() {
   UpdateLastUnlockPref(prefs_);
   for (const auto& observer : observers_) {
     observer->Unlocked();
   }
   ResetAutoLockTimer();
+}
 
-  std::move(callback).Run(true);
+void KeyringController::CancelPendingUnlock() {
+  unlock_weak_ptr_factory_.InvalidateWeakPtrs();
+  if (!pending_unlock_)
+    return;
+  std::unique_ptr<PendingUnlock> pending_unlock = std::move(pending_unlock_);
+  for (auto& callback : pending_unlock->callbacks)
+    std::move(callback).Run(false);
+}
+
+std::string KeyringController::GetPasswordDigest(
+    const std::string& password) const {
+  crypto::HMAC hmac(crypto::HMAC::SHA256);
+  std::vector<uint8_t> digest(hmac.DigestLength());
+  if (!hmac.Init(password_digest_key_) ||
+      !hmac.Sign(password, digest.data(), digest.size())) {
+    return std::string();
+  }
+  return std::string(digest.begin(), digest.end());
 }
 
 void KeyringController::OnAutoLockFired() {
@@ -1021,9 +1179,11 @@ void KeyringController::IsLocked(IsLockedCallback callback) {
 }
 
 void KeyringController::Reset() {
+  CancelPendingUnlock();
   StopAutoLockTimer();
   encryptor_.reset();
   default_keyring_.reset();
+  session_password_digest_.clear();
 
   ClearProfilePrefs(prefs_);
 }
@@ -1088,14 +1248,20 @@ bool KeyringController::CreateEncryptorForKeyring(const std::string& password,
                                                   const std::string& id) {
   if (password.empty())
     return false;
+  // An unlock still deriving its encryptor would replace this one once done.
+  CancelPendingUnlock();
   std::vector<uint8_t> salt(kSaltSize);
   if (!GetPrefInBytesForKeyring(kPasswordEncryptorSalt, &salt, id)) {
     crypto::RandBytes(salt);
     SetPrefInBytesForKeyring(kPasswordEncryptorSalt, salt, id);
   }
-  encryptor_ = PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
-      password, salt, 100000, 256);
-  return encryptor_ != nullptr;
+  encryptor_ = DeriveEncryptorFromPassword(password, salt);
+  if (!encryptor_) {
+    session_password_digest_.clear();
+    return false;
+  }
+  session_password_digest_ = GetPasswordDigest(password);
+  return true;
 }
 
 bool KeyringController::CreateDefaultKeyringInternal(
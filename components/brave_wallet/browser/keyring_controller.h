@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "base/gtest_prod_util.h"
+#include "base/memory/weak_ptr.h"
 #include "base/values.h"
 #include "brave/components/brave_wallet/browser/password_encryptor.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
@@ -30,9 +31,11 @@ class OneShotTimer;
 
 namespace brave_wallet {
 
+class HDKey;
 class HDKeyring;
 class EthTransaction;
 class KeyringControllerUnitTest;
+class AccountDiscoveryManagerUnitTest;
 class BraveWalletProviderImplUnitTest;
 
 // This class is not thread-safe and should have single owner
@@ -105,6 +108,9 @@ class KeyringController : public KeyedService, public mojom::KeyringController {
                      const std::string& password,
                      bool is_legacy_brave_wallet,
                      RestoreWalletCallback callback) override;
+  // Password based key derivation runs on the thread pool. Concurrent attempts
+  // with the same password share one derivation, a different password
+  // cancels the attempt in flight and so does Lock.
   void Unlock(const std::string& password, UnlockCallback callback) override;
   void Lock() override;
   void IsLocked(IsLockedCallback callback) override;
@@ -169,6 +175,12 @@ class KeyringController : public KeyedService, public mojom::KeyringController {
 
   void AddAccountsWithDefaultName(size_t number);
 
+  // Public extended key of the default keyring account root, empty when
+  // locked. Used to derive addresses off the UI sequence for discovery.
+  std::string GetDefaultKeyringPublicExtendedKey() const;
+  // Grows the default keyring so it holds |accounts_number| derived accounts.
+  void AddDiscoveredAccountsForDefaultKeyring(size_t accounts_number);
+
   bool IsLocked() const;
 
   void AddObserver(::mojo::PendingRemote<mojom::KeyringControllerObserver>
@@ -214,8 +226,27 @@ class KeyringController : public KeyedService, public mojom::KeyringController {
   FRIEND_TEST_ALL_PREFIXES(KeyringControllerUnitTest, RestoreLegacyBraveWallet);
   FRIEND_TEST_ALL_PREFIXES(KeyringControllerUnitTest, AutoLock);
   FRIEND_TEST_ALL_PREFIXES(KeyringControllerUnitTest, SetSelectedAccount);
+  FRIEND_TEST_ALL_PREFIXES(KeyringControllerUnitTest, UnlockCoalescing);
   friend class BraveWalletProviderImplUnitTest;
   friend class EthTxControllerUnitTest;
+  friend class AccountDiscoveryManagerUnitTest;
+
+  struct PendingUnlock {
+    PendingUnlock();
+    ~PendingUnlock();
+    std::string password_digest;
+    std::vector<UnlockCallback> callbacks;
+  };
+
+  void OnUnlockEncryptorDerived(std::unique_ptr<PasswordEncryptor> encryptor);
+  void OnUnlockSucceeded();
+  void CancelPendingUnlock();
+  // Keyed digest of password, used to recognize the password of current
+  // session without keeping the password itself around.
+  std::string GetPasswordDigest(const std::string& password) const;
+  void OnImportAccountFromJsonKeyDerived(const std::string& account_name,
+                                         ImportAccountCallback callback,
+                                         std::unique_ptr<HDKey> hd_key);
 
   void AddAccountForDefaultKeyring(const std::string& account_name);
   void OnAutoLockFired();
@@ -255,6 +286,8 @@ class KeyringController : public KeyedService, public mojom::KeyringController {
                                    bool is_legacy_brave_wallet);
   // It's used to reconstruct same default keyring between browser relaunch
   HDKeyring* ResumeDefaultKeyring(const std::string& password);
+  // Same as above but uses |encryptor_| which must already be derived
+  HDKeyring* ResumeDefaultKeyringWithEncryptor();
 
   void NotifyAccountsChanged();
   void StopAutoLockTimer();
@@ -266,6 +299,9 @@ class KeyringController : public KeyedService, public mojom::KeyringController {
   std::unique_ptr<HDKeyring> default_keyring_;
   std::unique_ptr<base::OneShotTimer> auto_lock_timer_;
   std::unique_ptr<PrefChangeRegistrar> pref_change_registrar_;
+  std::unique_ptr<PendingUnlock> pending_unlock_;
+  std::vector<uint8_t> password_digest_key_;
+  std::string session_password_digest_;
 
   // TODO(darkdh): For other keyrings support
   // std::vector<std::unique_ptr<HDKeyring>> keyrings_;
@@ -275,6 +311,10 @@ class KeyringController : public KeyedService, public mojom::KeyringController {
   mojo::RemoteSet<mojom::KeyringControllerObserver> observers_;
   mojo::ReceiverSet<mojom::KeyringController> receivers_;
 
+  base::WeakPtrFactory<KeyringController> weak_ptr_factory_;
+  // Invalidated to cancel an unlock attempt in flight
+  base::WeakPtrFactory<KeyringController> unlock_weak_ptr_factory_;
+
   KeyringController(const KeyringController&) = delete;
   KeyringController& operator=(const KeyringController&) = delete;
 };
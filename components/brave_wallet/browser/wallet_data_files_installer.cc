@@ -139,6 +139,11 @@ void WalletDataFilesInstallerPolicy::ComponentReady(
     const base::Version& version,
     const base::FilePath& path,
     base::Value manifest) {
+  // The token list of a version is immutable, don't parse it again when the
+  // same version is reported ready more than once.
+  if (last_installed_wallet_version &&
+      *last_installed_wallet_version == version)
+    return;
   last_installed_wallet_version = version;
   base::ThreadPool::PostTaskAndReplyWithResult(
       FROM_HERE, {base::MayBlock(), base::TaskPriority::BEST_EFFORT},
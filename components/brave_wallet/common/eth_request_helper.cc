@@ -222,22 +222,52 @@ bool NormalizeEthRequest(const std::string& input_json,
   if (!records_v)
     return false;
 
-  base::DictionaryValue* out_dict;
-  if (!records_v->GetAsDictionary(&out_dict))
+  if (!NormalizeEthRequest(&records_v.value()))
     return false;
+  base::JSONWriter::Write(*records_v, output_json);
 
-  const base::Value* found_id = out_dict->FindPath(kId);
-  if (!found_id) {
-    ALLOW_UNUSED_LOCAL(
-        out_dict->SetPath("id", kDefaultRequestIdWhenUnspecified.Clone()));
-  }
+  return true;
+}
+
+bool NormalizeEthRequest(base::Value* request) {
+  CHECK(request);
+  if (!request->is_dict())
+    return false;
 
-  ALLOW_UNUSED_LOCAL(out_dict->SetStringPath("jsonrpc", kRequestJsonRPC));
-  base::JSONWriter::Write(*out_dict, output_json);
+  const base::Value* found_id = request->FindPath(kId);
+  if (!found_id)
+    request->SetKey(kId, kDefaultRequestIdWhenUnspecified.Clone());
+
+  request->SetStringKey("jsonrpc", kRequestJsonRPC);
 
   return true;
 }
 
+bool IsReadOnlyEthMethod(const std::string& method) {
+  static constexpr const char* kReadOnlyMethods[] = {
+      "eth_blockNumber",
+      "eth_call",
+      "eth_chainId",
+      "eth_estimateGas",
+      "eth_gasPrice",
+      "eth_getBalance",
+      "eth_getBlockByHash",
+      "eth_getBlockByNumber",
+      "eth_getCode",
+      "eth_getLogs",
+      "eth_getStorageAt",
+      "eth_getTransactionByHash",
+      "eth_getTransactionCount",
+      "eth_getTransactionReceipt",
+      "net_version",
+  };
+  for (const char* read_only_method : kReadOnlyMethods) {
+    if (method == read_only_method)
+      return true;
+  }
+  return false;
+}
+
 bool ParseEthSignParams(const std::string& json,
                         std::string* address,
                         std::string* message) {
@@ -30,6 +30,13 @@ bool ShouldCreate1559Tx(mojom::TxData1559Ptr tx_data_1559,
 
 bool NormalizeEthRequest(const std::string& input_json,
                          std::string* output_json);
+// Same as above but normalizes an already parsed request in place, which
+// avoids a JSON round trip for values coming straight from V8.
+bool NormalizeEthRequest(base::Value* request);
+
+// Methods which only read chain state and can be pipelined with other
+// requests without user interaction.
+bool IsReadOnlyEthMethod(const std::string& method);
 
 bool ParseEthSignParams(const std::string& json,
                         std::string* address,
@@ -10,6 +10,7 @@
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "brave/components/brave_wallet/common/eth_request_helper.h"
+#include "brave/components/brave_wallet/common/web3_provider_constants.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace brave_wallet {
@@ -453,6 +454,34 @@ TEST(EthResponseHelperUnitTest, NormalizeEthRequest) {
       "There is only one thing we say to death: Not today.", &output_json));
 }
 
+TEST(EthResponseHelperUnitTest, NormalizeEthRequestValue) {
+  base::Value request(base::Value::Type::DICTIONARY);
+  request.SetStringKey("method", "eth_call");
+  request.SetKey("params", base::Value(base::Value::Type::LIST));
+  EXPECT_TRUE(NormalizeEthRequest(&request));
+  EXPECT_EQ(*request.FindKey("id"), base::Value("1"));
+  EXPECT_EQ(*request.FindStringKey("jsonrpc"), "2.0");
+
+  // Existing id is kept
+  request.SetIntKey("id", 5);
+  EXPECT_TRUE(NormalizeEthRequest(&request));
+  EXPECT_EQ(*request.FindKey("id"), base::Value(5));
+
+  base::Value list(base::Value::Type::LIST);
+  EXPECT_FALSE(NormalizeEthRequest(&list));
+}
+
+TEST(EthResponseHelperUnitTest, IsReadOnlyEthMethod) {
+  EXPECT_TRUE(IsReadOnlyEthMethod("eth_call"));
+  EXPECT_TRUE(IsReadOnlyEthMethod("eth_getBalance"));
+  EXPECT_TRUE(IsReadOnlyEthMethod("eth_blockNumber"));
+  EXPECT_FALSE(IsReadOnlyEthMethod(kEthSendTransaction));
+  EXPECT_FALSE(IsReadOnlyEthMethod(kEthAccounts));
+  EXPECT_FALSE(IsReadOnlyEthMethod(kPersonalSign));
+  EXPECT_FALSE(IsReadOnlyEthMethod("eth_sendRawTransaction"));
+  EXPECT_FALSE(IsReadOnlyEthMethod(""));
+}
+
 TEST(EthResponseHelperUnitTest, ParseSwitchEthereumChainParams) {
   std::string chain_id;
   EXPECT_TRUE(ParseSwitchEthereumChainParams(
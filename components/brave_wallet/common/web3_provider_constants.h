@@ -36,6 +36,8 @@ constexpr char kEthRequestAccounts[] = "eth_requestAccounts";
 constexpr char kEthSendTransaction[] = "eth_sendTransaction";
 constexpr char kEthGetBlockByNumber[] = "eth_getBlockByNumber";
 constexpr char kEthBlockNumber[] = "eth_blockNumber";
+constexpr char kEthGetTransactionCount[] = "eth_getTransactionCount";
+constexpr char kEthGetTransactionReceipt[] = "eth_getTransactionReceipt";
 constexpr char kEthSign[] = "eth_sign";
 constexpr char kPersonalSign[] = "personal_sign";
 // We currently don't handle it until MetaMask point it to v3 or v4 other than
@@ -9,6 +9,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/json/json_writer.h"
 #include "base/no_destructor.h"
 #include "base/strings/string_number_conversions.h"
@@ -23,6 +24,7 @@
 #include "gin/function_template.h"
 #include "third_party/blink/public/common/browser_interface_broker_proxy.h"
 #include "third_party/blink/public/mojom/devtools/console_message.mojom.h"
+#include "third_party/blink/public/platform/task_type.h"
 #include "third_party/blink/public/web/blink.h"
 #include "third_party/blink/public/web/web_console_message.h"
 #include "third_party/blink/public/web/web_local_frame.h"
@@ -44,6 +46,9 @@ const char kEthereumNonWritable[] =
 
 static base::NoDestructor<std::string> g_provider_script("");
 
+// Upper bound of read-only requests sent to the browser in one message.
+constexpr size_t kMaxPipelinedRequests = 50;
+
 std::string LoadDataResource(const int id) {
   auto& resource_bundle = ui::ResourceBundle::GetSharedInstance();
   if (resource_bundle.IsGzipped(id)) {
@@ -118,6 +123,27 @@ std::unique_ptr<base::Value> GetJsonRpcRequest(
 
 namespace brave_wallet {
 
+BraveWalletJSHandler::PipelinedRequest::PipelinedRequest(
+    std::string json_payload,
+    base::Value id,
+    v8::Global<v8::Context> global_context,
+    std::unique_ptr<v8::Global<v8::Function>> global_callback,
+    v8::Global<v8::Promise::Resolver> promise_resolver,
+    v8::Isolate* isolate,
+    bool force_json_response)
+    : json_payload(std::move(json_payload)),
+      id(std::move(id)),
+      global_context(std::move(global_context)),
+      global_callback(std::move(global_callback)),
+      promise_resolver(std::move(promise_resolver)),
+      isolate(isolate),
+      force_json_response(force_json_response) {}
+BraveWalletJSHandler::PipelinedRequest::PipelinedRequest(PipelinedRequest&&) =
+    default;
+BraveWalletJSHandler::PipelinedRequest&
+BraveWalletJSHandler::PipelinedRequest::operator=(PipelinedRequest&&) = default;
+BraveWalletJSHandler::PipelinedRequest::~PipelinedRequest() = default;
+
 void BraveWalletJSHandler::OnEthereumPermissionRequested(
     base::Value id,
     v8::Global<v8::Context> global_context,
@@ -563,17 +589,18 @@ bool BraveWalletJSHandler::CommonRequestOrSendAsync(
   if (!EnsureConnected() || !input_value)
     return false;
 
-  std::string input_json;
-  if (!base::JSONWriter::Write(*input_value, &input_json))
+  // The value converted from V8 is normalized in place and serialized once,
+  // instead of going through a JSON string to be parsed again.
+  if (!NormalizeEthRequest(input_value.get()))
     return false;
-
-  std::string normalized_json_request;
-  if (!NormalizeEthRequest(input_json, &normalized_json_request))
+  const std::string* method_str = input_value->FindStringKey(kMethod);
+  if (!method_str)
     return false;
+  const std::string method = *method_str;
+  base::Value id = input_value->FindKey(kId)->Clone();
 
-  base::Value id;
-  std::string method;
-  if (!GetEthJsonRequestInfo(normalized_json_request, &id, &method, nullptr))
+  std::string normalized_json_request;
+  if (!base::JSONWriter::Write(*input_value, &normalized_json_request))
     return false;
 
   if (method == kEthAccounts) {
@@ -655,6 +682,11 @@ bool BraveWalletJSHandler::CommonRequestOrSendAsync(
                        std::move(global_context), std::move(global_callback),
                        std::move(promise_resolver), isolate,
                        force_json_response));
+  } else if (IsReadOnlyEthMethod(method)) {
+    QueuePipelinedRequest(PipelinedRequest(
+        std::move(normalized_json_request), std::move(id),
+        std::move(global_context), std::move(global_callback),
+        std::move(promise_resolver), isolate, force_json_response));
   } else {
     brave_wallet_provider_->Request(
         normalized_json_request, true,
@@ -668,6 +700,83 @@ bool BraveWalletJSHandler::CommonRequestOrSendAsync(
   return true;
 }
 
+void BraveWalletJSHandler::QueuePipelinedRequest(PipelinedRequest request) {
+  pipelined_requests_.push_back(std::move(request));
+  if (pipelined_requests_.size() >= kMaxPipelinedRequests) {
+    FlushPipelinedRequests();
+    return;
+  }
+  // Requests made by the page in the current task, e.g. a Promise.all() over
+  // a list of eth_calls, are sent together once the task is done.
+  if (pipelined_requests_.size() == 1) {
+    render_frame_->GetTaskRunner(blink::TaskType::kInternalDefault)
+        ->PostTask(FROM_HERE,
+                   base::BindOnce(&BraveWalletJSHandler::FlushPipelinedRequests,
+                                  weak_ptr_factory_.GetWeakPtr()));
+  }
+}
+
+void BraveWalletJSHandler::FlushPipelinedRequests() {
+  if (pipelined_requests_.empty())
+    return;
+
+  std::vector<PipelinedRequest> requests;
+  requests.swap(pipelined_requests_);
+  if (!EnsureConnected()) {
+    OnRequestBatch(std::move(requests), {});
+    return;
+  }
+  if (requests.size() == 1) {
+    PipelinedRequest& request = requests.front();
+    brave_wallet_provider_->Request(
+        request.json_payload, true,
+        base::BindOnce(&BraveWalletJSHandler::OnCommonRequestOrSendAsync,
+                       weak_ptr_factory_.GetWeakPtr(), std::move(request.id),
+                       std::move(request.global_context),
+                       std::move(request.global_callback),
+                       std::move(request.promise_resolver), request.isolate,
+                       request.force_json_response));
+    return;
+  }
+
+  std::vector<std::string> json_payloads;
+  json_payloads.reserve(requests.size());
+  for (auto& request : requests)
+    json_payloads.push_back(std::move(request.json_payload));
+  brave_wallet_provider_->RequestBatch(
+      json_payloads,
+      base::BindOnce(&BraveWalletJSHandler::OnRequestBatch,
+                     weak_ptr_factory_.GetWeakPtr(), std::move(requests)));
+}
+
+void BraveWalletJSHandler::OnRequestBatch(
+    std::vector<PipelinedRequest> requests,
+    std::vector<mojom::ProviderResponsePtr> responses) {
+  const bool valid_responses = responses.size() == requests.size();
+  for (size_t i = 0; i < requests.size(); ++i) {
+    PipelinedRequest& request = requests[i];
+    if (valid_responses && responses[i]) {
+      OnCommonRequestOrSendAsync(
+          std::move(request.id), std::move(request.global_context),
+          std::move(request.global_callback),
+          std::move(request.promise_resolver), request.isolate,
+          request.force_json_response, responses[i]->http_code,
+          responses[i]->response, {});
+      continue;
+    }
+    v8::HandleScope handle_scope(request.isolate);
+    v8::MicrotasksScope microtasks(request.isolate,
+                                   v8::MicrotasksScope::kDoNotRunMicrotasks);
+    auto formed_response = GetProviderErrorDictionary(
+        ProviderErrors::kInternalError, "Internal JSON-RPC error");
+    SendResponse(std::move(request.id), std::move(request.global_context),
+                 std::move(request.global_callback),
+                 std::move(request.promise_resolver), request.isolate,
+                 request.force_json_response, std::move(formed_response),
+                 false);
+  }
+}
+
 // There are 3 supported signatures for send:
 //
 // 1) ethereum.send(payload: JsonRpcRequest, callback: JsonRpcCallback): void;
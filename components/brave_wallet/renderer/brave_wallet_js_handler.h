@@ -38,6 +38,29 @@ class BraveWalletJSHandler : public mojom::EventsListener {
   void ChainChangedEvent(const std::string& chain_id) override;
 
  private:
+  // A read-only request waiting to be sent with the other requests issued by
+  // the page in the same task.
+  struct PipelinedRequest {
+    PipelinedRequest(std::string json_payload,
+                     base::Value id,
+                     v8::Global<v8::Context> global_context,
+                     std::unique_ptr<v8::Global<v8::Function>> global_callback,
+                     v8::Global<v8::Promise::Resolver> promise_resolver,
+                     v8::Isolate* isolate,
+                     bool force_json_response);
+    PipelinedRequest(PipelinedRequest&&);
+    PipelinedRequest& operator=(PipelinedRequest&&);
+    ~PipelinedRequest();
+
+    std::string json_payload;
+    base::Value id;
+    v8::Global<v8::Context> global_context;
+    std::unique_ptr<v8::Global<v8::Function>> global_callback;
+    v8::Global<v8::Promise::Resolver> promise_resolver;
+    v8::Isolate* isolate;
+    bool force_json_response;
+  };
+
   void BindFunctionsToObject(v8::Isolate* isolate,
                              v8::Local<v8::Context> context,
                              v8::Local<v8::Object> ethereum_object,
@@ -90,6 +113,10 @@ class BraveWalletJSHandler : public mojom::EventsListener {
       const int http_code,
       const std::string& response,
       const base::flat_map<std::string, std::string>& headers);
+  void QueuePipelinedRequest(PipelinedRequest request);
+  void FlushPipelinedRequests();
+  void OnRequestBatch(std::vector<PipelinedRequest> requests,
+                      std::vector<mojom::ProviderResponsePtr> responses);
   void OnSendAsync(base::Value id,
                    v8::Global<v8::Context> global_context,
                    std::unique_ptr<v8::Global<v8::Function>> callback,
@@ -172,6 +199,7 @@ class BraveWalletJSHandler : public mojom::EventsListener {
   bool is_connected_;
   std::string chain_id_;
   std::string first_allowed_account_;
+  std::vector<PipelinedRequest> pipelined_requests_;
   base::WeakPtrFactory<BraveWalletJSHandler> weak_ptr_factory_{this};
 };
 
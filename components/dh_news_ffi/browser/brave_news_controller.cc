@@ -12,13 +12,15 @@
 #include <vector>
 
 #include "base/bind.h"
+#include "base/files/file_path.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/time/time.h"
 #include "base/values.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/brave_ads/browser/ads_service.h"
-#include "brave/components/brave_private_cdn/headers.h"
-#include "brave/components/brave_private_cdn/private_cdn_helper.h"
+#include "brave/components/brave_today/browser/feed_building.h"
+#include "brave/components/brave_today/browser/feed_cache.h"
+#include "brave/components/brave_today/browser/image_cache.h"
 #include "brave/components/brave_today/browser/network.h"
 #include "brave/components/brave_today/common/brave_news.mojom-forward.h"
 #include "brave/components/brave_today/common/brave_news.mojom-shared.h"
@@ -61,14 +63,18 @@ BraveNewsController::BraveNewsController(
     PrefService* prefs,
     brave_ads::AdsService* ads_service,
     history::HistoryService* history_service,
-    scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory)
+    scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory,
+    const base::FilePath& profile_path)
     : prefs_(prefs),
       ads_service_(ads_service),
       api_request_helper_(GetNetworkTrafficAnnotationTag(), url_loader_factory),
       publishers_controller_(prefs, &api_request_helper_),
       feed_controller_(&publishers_controller_,
                        history_service,
-                       &api_request_helper_),
+                       &api_request_helper_,
+                       profile_path.Append(kFeedCacheFilename)),
+      image_controller_(&api_request_helper_,
+                        profile_path.Append(kImageCacheDirname)),
       weak_ptr_factory_(this) {
   DCHECK(prefs);
   // Set up preference listeners
@@ -94,8 +100,9 @@ void BraveNewsController::Bind(
 }
 
 void BraveNewsController::ClearHistory() {
-  // TODO(petemill): Clear history once/if we actually store
-  // feed cache somewhere.
+  // The feed is ranked using browsing history, so remove it from both memory
+  // and disk.
+  feed_controller_.ClearCache();
 }
 
 mojo::PendingRemote<mojom::BraveNewsController>
@@ -106,7 +113,18 @@ BraveNewsController::MakeRemote() {
 }
 
 void BraveNewsController::GetFeed(GetFeedCallback callback) {
-  feed_controller_.GetOrFetchFeed(std::move(callback));
+  feed_controller_.GetOrFetchFeed(base::BindOnce(
+      [](BraveNewsController* controller, GetFeedCallback callback,
+         mojom::FeedPtr feed) {
+        // The UI asks for the first page's images straight away, so have the
+        // next page's ready for when the user scrolls.
+        if (feed) {
+          controller->image_controller_.PrefetchImages(
+              GetPaddedImageUrlsForNextPage(*feed, 0));
+        }
+        std::move(callback).Run(std::move(feed));
+      },
+      base::Unretained(this), std::move(callback)));
 }
 
 void BraveNewsController::GetPublishers(GetPublishersCallback callback) {
@@ -115,30 +133,7 @@ void BraveNewsController::GetPublishers(GetPublishersCallback callback) {
 
 void BraveNewsController::GetImageData(const GURL& padded_image_url,
                                        GetImageDataCallback callback) {
-  // Handler url download response
-  auto onPaddedImageResponse = base::BindOnce(
-      [](GetImageDataCallback callback, const int status,
-         const std::string& body,
-         const base::flat_map<std::string, std::string>& headers) {
-        // Attempt to remove byte padding
-        base::StringPiece body_payload(body.data(), body.size());
-        if (status < 200 || status >= 300 ||
-            !brave::PrivateCdnHelper::GetInstance()->RemovePadding(
-                &body_payload)) {
-          // Byte padding removal failed
-          absl::optional<std::vector<uint8_t>> args;
-          std::move(callback).Run(std::move(args));
-        }
-        // Unpadding was successful, uint8Array will be easier to move over
-        // mojom
-        std::vector<uint8_t> image_bytes(body_payload.begin(),
-                                         body_payload.end());
-        std::move(callback).Run(image_bytes);
-      },
-      std::move(callback));
-  api_request_helper_.Request("GET", padded_image_url, "", "", true,
-                              std::move(onPaddedImageResponse),
-                              brave::private_cdn_headers);
+  image_controller_.GetImageData(padded_image_url, std::move(callback));
 }
 
 void BraveNewsController::SetPublisherPref(const std::string& publisher_id,
@@ -278,6 +273,9 @@ void BraveNewsController::OnSessionCardViewsCountChanged(
   int answer = it_count - kBuckets;
   UMA_HISTOGRAM_EXACT_LINEAR("Brave.Today.WeeklyMaxCardViewsCount", answer,
                              base::size(kBuckets) + 1);
+  // Keep the images of the next page one step ahead of the user.
+  image_controller_.PrefetchImages(
+      feed_controller_.GetImagesToPrefetch(cards_viewed_session_total_count));
 }
 
 void BraveNewsController::OnDisplayAdVisit(
@@ -359,6 +357,9 @@ void BraveNewsController::ConditionallyStartOrStopTimer() {
   bool opted_in = prefs_->GetBoolean(prefs::kBraveTodayOptedIn);
   bool is_enabled = (should_show && opted_in);
   if (is_enabled) {
+    // Show the last session's feed straight away rather than waiting for a
+    // fetch.
+    feed_controller_.LoadFromDiskCache();
     VLOG(1) << "STARTING TIMERS";
     if (!timer_feed_update_.IsRunning()) {
       timer_feed_update_.Start(FROM_HERE, base::TimeDelta::FromHours(3), this,
@@ -381,6 +382,7 @@ void BraveNewsController::ConditionallyStartOrStopTimer() {
     VLOG(1) << "REMOVING DATA FROM MEMORY";
     feed_controller_.ClearCache();
     publishers_controller_.ClearCache();
+    image_controller_.ClearCache();
   }
 }
 
@@ -14,6 +14,7 @@
 #include "base/timer/timer.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/brave_today/browser/feed_controller.h"
+#include "brave/components/brave_today/browser/image_controller.h"
 #include "brave/components/brave_today/browser/publishers_controller.h"
 #include "brave/components/brave_today/common/brave_news.mojom-forward.h"
 #include "brave/components/brave_today/common/brave_news.mojom.h"
@@ -27,6 +28,10 @@
 class PrefRegistrySimple;
 class PrefService;
 
+namespace base {
+class FilePath;
+}  // namespace base
+
 namespace brave_ads {
 class AdsService;
 }  // namespace brave_ads
@@ -50,7 +55,8 @@ class BraveNewsController : public KeyedService,
       PrefService* prefs,
       brave_ads::AdsService* ads_service,
       history::HistoryService* history_service,
-      scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
+      scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory,
+      const base::FilePath& profile_path);
   ~BraveNewsController() override;
   BraveNewsController(const BraveNewsController&) = delete;
   BraveNewsController& operator=(const BraveNewsController&) = delete;
@@ -97,6 +103,7 @@ class BraveNewsController : public KeyedService,
   api_request_helper::APIRequestHelper api_request_helper_;
   PublishersController publishers_controller_;
   FeedController feed_controller_;
+  ImageController image_controller_;
 
   PrefChangeRegistrar pref_change_registrar_;
   base::OneShotTimer timer_prefetch_;
@@ -434,4 +434,31 @@ bool BuildFeed(const std::string& json,
   return true;
 }
 
+std::vector<GURL> GetPaddedImageUrlsForNextPage(const mojom::Feed& feed,
+                                                size_t cards_viewed) {
+  std::vector<GURL> image_urls;
+  // Find the page containing the last viewed card.
+  size_t cards_count = feed.featured_item ? 1u : 0u;
+  size_t page_index = 0;
+  for (; page_index < feed.pages.size(); page_index++) {
+    cards_count += feed.pages[page_index]->items.size();
+    if (cards_count > cards_viewed) {
+      break;
+    }
+  }
+  const size_t next_page_index = page_index + 1;
+  if (next_page_index >= feed.pages.size()) {
+    return image_urls;
+  }
+  for (const auto& page_item : feed.pages[next_page_index]->items) {
+    for (const auto& item : page_item->items) {
+      const auto& image = MetadataFromFeedItem(item)->image;
+      if (image && image->is_padded_image_url()) {
+        image_urls.push_back(image->get_padded_image_url());
+      }
+    }
+  }
+  return image_urls;
+}
+
 }  // namespace brave_news
@@ -0,0 +1,77 @@
+// Copyright (c) 2021 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_IMAGE_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_IMAGE_CACHE_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "url/gurl.h"
+
+namespace base {
+class SequencedTaskRunner;
+}  // namespace base
+
+namespace brave_news {
+
+extern const base::FilePath::CharType kImageCacheDirname[];
+
+// Caches unpadded Brave News images by their padded url, in a byte-bounded
+// in-memory LRU backed by a byte-bounded directory on disk. Disk entries are
+// evicted least recently used first, based on their modification time which
+// is refreshed whenever an entry is read.
+class ImageCache {
+ public:
+  using GetCallback =
+      base::OnceCallback<void(absl::optional<std::vector<uint8_t>>)>;
+
+  ImageCache(const base::FilePath& cache_dir,
+             size_t max_memory_bytes,
+             int64_t max_disk_bytes);
+  ~ImageCache();
+  ImageCache(const ImageCache&) = delete;
+  ImageCache& operator=(const ImageCache&) = delete;
+
+  // Runs |callback| synchronously on a memory hit, otherwise after looking
+  // on disk.
+  void Get(const GURL& url, GetCallback callback);
+  void Put(const GURL& url, const std::vector<uint8_t>& data);
+  void Clear();
+
+ private:
+  void OnReadFromDisk(const std::string& key,
+                      int clear_count,
+                      GetCallback callback,
+                      absl::optional<std::vector<uint8_t>> data);
+  void AddToMemoryCache(const std::string& key, std::vector<uint8_t> data);
+  base::FilePath GetPathForKey(const std::string& key) const;
+
+  const base::FilePath cache_dir_;
+  const size_t max_memory_bytes_;
+  const int64_t max_disk_bytes_;
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
+
+  base::MRUCache<std::string, std::vector<uint8_t>> memory_cache_;
+  size_t memory_cache_bytes_ = 0;
+  // Trimming the disk cache requires listing the directory, so it is done
+  // on startup and then only every so many writes.
+  int writes_since_trim_ = 0;
+  int clear_count_ = 0;
+
+  base::WeakPtrFactory<ImageCache> weak_ptr_factory_{this};
+};
+
+}  // namespace brave_news
+
+#endif  // BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_IMAGE_CACHE_H_
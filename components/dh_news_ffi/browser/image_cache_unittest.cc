@@ -0,0 +1,111 @@
+// Copyright (c) 2021 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "brave/components/brave_today/browser/image_cache.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave_news {
+
+class BraveNewsImageCacheTest : public testing::Test {
+ public:
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  std::unique_ptr<ImageCache> CreateCache(size_t max_memory_bytes,
+                                          int64_t max_disk_bytes) {
+    return std::make_unique<ImageCache>(temp_dir_.GetPath(), max_memory_bytes,
+                                        max_disk_bytes);
+  }
+
+  absl::optional<std::vector<uint8_t>> Get(ImageCache* cache,
+                                           const GURL& url) {
+    absl::optional<std::vector<uint8_t>> result;
+    base::RunLoop run_loop;
+    cache->Get(url, base::BindLambdaForTesting(
+                        [&](absl::optional<std::vector<uint8_t>> data) {
+                          result = std::move(data);
+                          run_loop.Quit();
+                        }));
+    run_loop.Run();
+    return result;
+  }
+
+  absl::optional<std::vector<uint8_t>> GetFromMemory(ImageCache* cache,
+                                                     const GURL& url) {
+    absl::optional<std::vector<uint8_t>> result;
+    bool called = false;
+    cache->Get(url, base::BindLambdaForTesting(
+                        [&](absl::optional<std::vector<uint8_t>> data) {
+                          result = std::move(data);
+                          called = true;
+                        }));
+    // Memory hits are synchronous.
+    EXPECT_TRUE(called);
+    return result;
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_F(BraveNewsImageCacheTest, ServesFromMemoryAndDisk) {
+  const GURL url("https://pcdn.brave.com/brave-today/cache/1.jpg.pad");
+  const std::vector<uint8_t> image = {1, 2, 3, 4};
+
+  auto cache = CreateCache(1024, 1024);
+  EXPECT_FALSE(Get(cache.get(), url));
+  cache->Put(url, image);
+  EXPECT_EQ(GetFromMemory(cache.get(), url), image);
+  task_environment_.RunUntilIdle();
+
+  // A new cache, as on the next startup, reads the image back from disk.
+  cache = CreateCache(1024, 1024);
+  EXPECT_EQ(Get(cache.get(), url), image);
+  EXPECT_EQ(GetFromMemory(cache.get(), url), image);
+
+  cache->Clear();
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(Get(cache.get(), url));
+  EXPECT_FALSE(base::PathExists(temp_dir_.GetPath()));
+}
+
+TEST_F(BraveNewsImageCacheTest, EvictsLeastRecentlyUsedFromMemory) {
+  const GURL url1("https://pcdn.brave.com/brave-today/cache/1.jpg.pad");
+  const GURL url2("https://pcdn.brave.com/brave-today/cache/2.jpg.pad");
+  const GURL url3("https://pcdn.brave.com/brave-today/cache/3.jpg.pad");
+  const std::vector<uint8_t> image(4, 1);
+
+  // Room for two images in memory.
+  auto cache = CreateCache(8, 1024);
+  cache->Put(url1, image);
+  cache->Put(url2, image);
+  // Use the first image so that the second is the least recently used.
+  GetFromMemory(cache.get(), url1);
+  cache->Put(url3, image);
+  task_environment_.RunUntilIdle();
+
+  bool called = false;
+  cache->Get(url2, base::BindLambdaForTesting(
+                       [&](absl::optional<std::vector<uint8_t>> data) {
+                         called = true;
+                       }));
+  // Not in memory, so has to go to disk.
+  EXPECT_FALSE(called);
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(called);
+  EXPECT_EQ(GetFromMemory(cache.get(), url3), image);
+}
+
+}  // namespace brave_news
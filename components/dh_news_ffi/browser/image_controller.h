@@ -0,0 +1,78 @@
+// Copyright (c) 2021 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_IMAGE_CONTROLLER_H_
+#define BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_IMAGE_CONTROLLER_H_
+
+#include <string>
+#include <vector>
+
+#include "base/containers/circular_deque.h"
+#include "base/containers/flat_map.h"
+#include "base/containers/mru_cache.h"
+#include "base/memory/weak_ptr.h"
+#include "brave/components/api_request_helper/api_request_helper.h"
+#include "brave/components/brave_today/browser/image_cache.h"
+#include "brave/components/brave_today/common/brave_news.mojom.h"
+#include "url/gurl.h"
+
+namespace base {
+class FilePath;
+}  // namespace base
+
+namespace brave_news {
+
+using GetImageDataCallback = mojom::BraveNewsController::GetImageDataCallback;
+
+// Provides unpadded images from the private CDN, caching them in memory and
+// on disk. Simultaneous requests for the same image share a single fetch, and
+// images can be prefetched ahead of being displayed.
+class ImageController {
+ public:
+  // Older queued prefetches are dropped beyond this, as the user has most
+  // likely scrolled past them.
+  static constexpr size_t kMaxQueuedPrefetches = 32;
+
+  ImageController(api_request_helper::APIRequestHelper* api_request_helper,
+                  const base::FilePath& cache_dir);
+  ~ImageController();
+  ImageController(const ImageController&) = delete;
+  ImageController& operator=(const ImageController&) = delete;
+
+  void GetImageData(const GURL& padded_image_url,
+                    GetImageDataCallback callback);
+  // Queues the images to be fetched into the cache, a few at a time so as not
+  // to compete with requests for images which are being displayed. Images
+  // which were recently queued or prefetched are skipped.
+  void PrefetchImages(const std::vector<GURL>& padded_image_urls);
+  void ClearCache();
+
+ private:
+  void OnCacheLookup(const GURL& padded_image_url,
+                     GetImageDataCallback callback,
+                     absl::optional<std::vector<uint8_t>> image_data);
+  void FetchImage(const GURL& padded_image_url, GetImageDataCallback callback);
+  void OnImageFetched(const GURL& padded_image_url,
+                      const int status,
+                      const std::string& body,
+                      const base::flat_map<std::string, std::string>& headers);
+  void StartPrefetches();
+  void OnPrefetchDone(const GURL& padded_image_url, bool success);
+
+  api_request_helper::APIRequestHelper* api_request_helper_;
+  ImageCache image_cache_;
+  // Callbacks waiting on each in-flight fetch.
+  base::flat_map<GURL, std::vector<GetImageDataCallback>> pending_fetches_;
+  base::circular_deque<GURL> prefetch_queue_;
+  // Images which are queued, being prefetched or were prefetched
+  // successfully.
+  base::MRUCache<GURL, bool> recent_prefetches_;
+  size_t active_prefetches_ = 0;
+  base::WeakPtrFactory<ImageController> weak_ptr_factory_{this};
+};
+
+}  // namespace brave_news
+
+#endif  // BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_IMAGE_CONTROLLER_H_
@@ -39,10 +39,14 @@ class PublishersController {
   void RemoveObserver(Observer* observer);
   void GetOrFetchPublishers(GetPublishersCallback callback);
   void EnsurePublishersIsUpdating();
+  // Seeds the in-memory publishers with those persisted alongside the feed,
+  // unless they have already been fetched.
+  void SetCachedPublishers(Publishers publishers);
   void ClearCache();
 
  private:
   void GetOrFetchPublishers(base::OnceClosure callback);
+  void ApplyUserEnabledPrefs(Publishers* publishers);
 
   PrefService* prefs_;
   api_request_helper::APIRequestHelper* api_request_helper_;
@@ -6,6 +6,9 @@
 #include "brave/components/greaselion/browser/greaselion_service_impl.h"
 
 #include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -15,12 +18,16 @@
 #include "base/bind.h"
 #include "base/callback_helpers.h"
 #include "base/command_line.h"
+#include "base/containers/flat_set.h"
 #include "base/feature_list.h"
+#include "base/files/file_enumerator.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/json/json_file_value_serializer.h"
 #include "base/one_shot_event.h"
 #include "base/sequenced_task_runner.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
@@ -33,6 +40,7 @@
 #include "brave/components/version_info//version_info.h"
 #include "chrome/browser/extensions/extension_service.h"
 #include "components/version_info/version_info.h"
+#include "crypto/secure_hash.h"
 #include "crypto/sha2.h"
 #include "extensions/browser/computed_hashes.h"
 #include "extensions/browser/extension_registry.h"
@@ -52,6 +60,7 @@ using extensions::mojom::ManifestLocation;
 namespace {
 
 constexpr char kRunAtDocumentStart[] = "document_start";
+constexpr char kExtensionCacheDirectory[] = "Extensions";
 
 bool ShouldComputeHashesForResource(
     const base::FilePath& relative_resource_path) {
@@ -60,30 +69,117 @@ bool ShouldComputeHashesForResource(
   return !components.empty() && components[0] != extensions::kMetadataFolder;
 }
 
-// Wraps a Greaselion rule in a component. The component is stored as
-// an unpacked extension in the user data dir. Returns a valid
-// extension that the caller should take ownership of, or nullptr.
+std::string GetUpdaterEndpoint() {
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  if (!command_line.HasSwitch(brave_component_updater::kUseGoUpdateDev) &&
+      !base::FeatureList::IsEnabled(
+          brave_component_updater::kUseDevUpdaterUrl)) {
+    return UPDATER_DEV_ENDPOINT;
+  }
+  return UPDATER_PROD_ENDPOINT;
+}
+
+base::FilePath GetExtensionCacheDir(const base::FilePath& install_dir) {
+  return install_dir.AppendASCII(kExtensionCacheDirectory);
+}
+
+// Adds |value| to |hash|, prefixed by its length so that consecutive values
+// can't be confused with each other.
+void UpdateCacheKeyHash(crypto::SecureHash* hash,
+                        const base::StringPiece value) {
+  const uint64_t size = value.size();
+  hash->Update(&size, sizeof(size));
+  hash->Update(value.data(), value.size());
+}
+
+bool UpdateCacheKeyHashWithFile(crypto::SecureHash* hash,
+                                const base::FilePath& path,
+                                const base::FilePath& relative_path) {
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents))
+    return false;
+  UpdateCacheKeyHash(hash, relative_path.AsUTF8Unsafe());
+  UpdateCacheKeyHash(hash, contents);
+  return true;
+}
+
+// Returns a key that changes whenever anything the converted extension is
+// built from changes, or an empty string if the rule's files can't be read.
 //
 // NOTE: This function does file IO and should not be called on the UI thread.
-// NOTE: The caller takes ownership of the directory at extension->path() on the
-// returned object.
-absl::optional<greaselion::GreaselionServiceImpl::GreaselionConvertedExtension>
-ConvertGreaselionRuleToExtensionOnTaskRunner(
-    const greaselion::GreaselionRule& rule,
-    const base::FilePath& install_dir) {
-  base::FilePath install_temp_dir =
-      extensions::file_util::GetInstallTempDir(install_dir);
-  if (install_temp_dir.empty()) {
-    LOG(ERROR) << "Could not get path to profile temp directory";
-    return absl::nullopt;
+std::string ComputeCacheKey(const greaselion::GreaselionRule& rule,
+                            const std::string& browser_version) {
+  std::unique_ptr<crypto::SecureHash> hash =
+      crypto::SecureHash::Create(crypto::SecureHash::SHA256);
+  UpdateCacheKeyHash(hash.get(), browser_version);
+  UpdateCacheKeyHash(hash.get(), GetUpdaterEndpoint());
+  UpdateCacheKeyHash(hash.get(), rule.name());
+  UpdateCacheKeyHash(hash.get(), rule.run_at());
+  for (const auto& url_pattern : rule.url_patterns())
+    UpdateCacheKeyHash(hash.get(), url_pattern);
+
+  for (const auto& script : rule.scripts()) {
+    if (!UpdateCacheKeyHashWithFile(hash.get(), script, script.BaseName()))
+      return std::string();
   }
 
-  base::ScopedTempDir temp_dir;
-  if (!temp_dir.CreateUniqueTempDirUnderPath(install_temp_dir)) {
-    LOG(ERROR) << "Could not create Greaselion temp directory";
-    return absl::nullopt;
+  if (!rule.messages().empty()) {
+    std::vector<base::FilePath> messages;
+    base::FileEnumerator enumerator(rule.messages(), true,
+                                    base::FileEnumerator::FILES);
+    for (base::FilePath path = enumerator.Next(); !path.empty();
+         path = enumerator.Next()) {
+      messages.push_back(path);
+    }
+    std::sort(messages.begin(), messages.end());
+    for (const auto& path : messages) {
+      base::FilePath relative_path;
+      rule.messages().AppendRelativePath(path, &relative_path);
+      if (!UpdateCacheKeyHashWithFile(hash.get(), path, relative_path))
+        return std::string();
+    }
   }
 
+  uint8_t digest[crypto::kSHA256Length];
+  hash->Finish(digest, sizeof(digest));
+  return base::ToLowerASCII(base::HexEncode(digest, sizeof(digest)));
+}
+
+// Computes the cache key of each of |rules|.
+//
+// NOTE: This function does file IO and should not be called on the UI thread.
+std::vector<std::string> ComputeCacheKeysOnTaskRunner(
+    const std::vector<greaselion::GreaselionRule>& rules,
+    const std::string& browser_version) {
+  std::vector<std::string> cache_keys;
+  cache_keys.reserve(rules.size());
+  for (const auto& rule : rules)
+    cache_keys.push_back(ComputeCacheKey(rule, browser_version));
+  return cache_keys;
+}
+
+// Deletes the cached extensions whose key isn't in |cache_keys|.
+//
+// NOTE: This function does file IO and should not be called on the UI thread.
+void PruneExtensionCacheOnTaskRunner(const std::vector<std::string>& cache_keys,
+                                     const base::FilePath& install_dir) {
+  const base::flat_set<std::string> keys(cache_keys.begin(), cache_keys.end());
+  base::FileEnumerator enumerator(GetExtensionCacheDir(install_dir), false,
+                                  base::FileEnumerator::DIRECTORIES);
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    if (!keys.contains(path.BaseName().AsUTF8Unsafe()))
+      base::DeletePathRecursively(path);
+  }
+}
+
+// Wraps a Greaselion rule in a component, writing it as an unpacked extension
+// to |extension_dir|.
+//
+// NOTE: This function does file IO and should not be called on the UI thread.
+bool ConvertGreaselionRuleToExtension(const greaselion::GreaselionRule& rule,
+                                      const base::FilePath& extension_dir) {
   // Create the manifest
   std::unique_ptr<base::DictionaryValue> root(new base::DictionaryValue);
 
@@ -99,19 +195,8 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
   char raw[crypto::kSHA256Length] = {0};
   std::string key;
   std::string script_name = rule.name();
-  const base::CommandLine& command_line =
-      *base::CommandLine::ForCurrentProcess();
-  if (!command_line.HasSwitch(brave_component_updater::kUseGoUpdateDev) &&
-      !base::FeatureList::IsEnabled(
-          brave_component_updater::kUseDevUpdaterUrl)) {
-    crypto::SHA256HashString(UPDATER_DEV_ENDPOINT + script_name,
-                             raw,
-                             crypto::kSHA256Length);
-  } else {
-    crypto::SHA256HashString(UPDATER_PROD_ENDPOINT + script_name,
-                             raw,
-                             crypto::kSHA256Length);
-  }
+  crypto::SHA256HashString(GetUpdaterEndpoint() + script_name, raw,
+                           crypto::kSHA256Length);
   base::Base64Encode(base::StringPiece(raw, crypto::kSHA256Length), &key);
 
   root->SetStringPath(extensions::manifest_keys::kName, script_name);
@@ -150,7 +235,7 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
             std::move(content_scripts));
 
   base::FilePath manifest_path =
-      temp_dir.GetPath().Append(extensions::kManifestFilename);
+      extension_dir.Append(extensions::kManifestFilename);
   JSONFileValueSerializer serializer(manifest_path);
   // If you read the header file for this function, it says not to use it
   // outside unit tests because it writes to disk (which blocks the thread). I
@@ -159,57 +244,109 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
   // files to disk.
   if (!serializer.Serialize(*root)) {
     LOG(ERROR) << "Could not write Greaselion manifest";
-    return absl::nullopt;
+    return false;
   }
 
   // Copy the messages directory to our extension directory.
   if (!rule.messages().empty()) {
     if (!base::CopyDirectory(
             rule.messages(),
-            temp_dir.GetPath().AppendASCII("_locales"), true)) {
+            extension_dir.AppendASCII("_locales"), true)) {
       LOG(ERROR) << "Could not copy Greaselion messages directory at path: "
                  << rule.messages().LossyDisplayName();
-      return absl::nullopt;
+      return false;
     }
   }
 
   // Copy the script files to our extension directory.
   for (auto script : rule.scripts()) {
-    if (!base::CopyFile(script,
-                        temp_dir.GetPath().Append(script.BaseName()))) {
+    if (!base::CopyFile(script, extension_dir.Append(script.BaseName()))) {
       LOG(ERROR) << "Could not copy Greaselion script at path: "
           << script.LossyDisplayName();
-      return absl::nullopt;
+      return false;
     }
   }
 
-  std::string error;
-  scoped_refptr<Extension> extension = extensions::file_util::LoadExtension(
-      temp_dir.GetPath(), ManifestLocation::kComponent, Extension::NO_FLAGS,
-      &error);
-  if (!extension.get()) {
-    LOG(ERROR) << "Could not load Greaselion extension";
-    LOG(ERROR) << error;
-    return absl::nullopt;
-  }
-
   // Calculate and write computed hashes.
   absl::optional<extensions::ComputedHashes::Data> computed_hashes_data =
       extensions::ComputedHashes::Compute(
-          extension->path(),
-          extension_misc::kContentVerificationDefaultBlockSize,
+          extension_dir, extension_misc::kContentVerificationDefaultBlockSize,
           extensions::IsCancelledCallback(),
           base::BindRepeating(&ShouldComputeHashesForResource));
   if (computed_hashes_data) {
     extensions::ComputedHashes(std::move(*computed_hashes_data))
-        .WriteToFile(
-            extensions::file_util::GetComputedHashesPath(extension->path()));
+        .WriteToFile(extensions::file_util::GetComputedHashesPath(
+            extension_dir));
+  }
+
+  return true;
+}
+
+// Loads the extension for |rule| from the cache, converting the rule and
+// adding it to the cache first if it isn't there. Returns nullptr on failure.
+//
+// NOTE: This function does file IO and should not be called on the UI thread.
+scoped_refptr<Extension> LoadGreaselionExtensionOnTaskRunner(
+    const greaselion::GreaselionRule& rule,
+    const std::string& cache_key,
+    const base::FilePath& install_dir) {
+  if (cache_key.empty()) {
+    LOG(ERROR) << "Could not read Greaselion rule " << rule.name();
+    return nullptr;
+  }
+
+  const base::FilePath extension_dir =
+      GetExtensionCacheDir(install_dir).AppendASCII(cache_key);
+  std::string error;
+  if (base::DirectoryExists(extension_dir)) {
+    scoped_refptr<Extension> extension = extensions::file_util::LoadExtension(
+        extension_dir, ManifestLocation::kComponent, Extension::NO_FLAGS,
+        &error);
+    if (extension)
+      return extension;
+    // Convert the rule again below.
+    LOG(ERROR) << "Could not load cached Greaselion extension: " << error;
+    base::DeletePathRecursively(extension_dir);
+  }
+
+  base::FilePath install_temp_dir =
+      extensions::file_util::GetInstallTempDir(install_dir);
+  if (install_temp_dir.empty()) {
+    LOG(ERROR) << "Could not get path to profile temp directory";
+    return nullptr;
+  }
+
+  // Convert in a temporary directory and move it into the cache once it is
+  // complete, so that the cache never holds a partial extension.
+  base::ScopedTempDir temp_dir;
+  if (!temp_dir.CreateUniqueTempDirUnderPath(install_temp_dir)) {
+    LOG(ERROR) << "Could not create Greaselion temp directory";
+    return nullptr;
+  }
+
+  if (!ConvertGreaselionRuleToExtension(rule, temp_dir.GetPath()))
+    return nullptr;
+
+  if (!base::CreateDirectory(extension_dir.DirName()) ||
+      !base::Move(temp_dir.GetPath(), extension_dir)) {
+    LOG(ERROR) << "Could not move Greaselion extension to "
+               << extension_dir.LossyDisplayName();
+    return nullptr;
   }
+  ignore_result(temp_dir.Take());
 
-  // Take ownership of this temporary directory so it's deleted when
-  // the service exits
-  return std::make_pair(extension, std::move(temp_dir));
+  scoped_refptr<Extension> extension = extensions::file_util::LoadExtension(
+      extension_dir, ManifestLocation::kComponent, Extension::NO_FLAGS,
+      &error);
+  if (!extension.get()) {
+    LOG(ERROR) << "Could not load Greaselion extension";
+    LOG(ERROR) << error;
+    return nullptr;
+  }
+
+  return extension;
 }
+
 }  // namespace
 
 namespace greaselion {
@@ -247,13 +384,16 @@ GreaselionServiceImpl::~GreaselionServiceImpl() {
 }
 
 bool GreaselionServiceImpl::IsGreaselionExtension(const std::string& id) {
-  return std::find(greaselion_extensions_.begin(), greaselion_extensions_.end(),
-                   id) != greaselion_extensions_.end();
+  return greaselion_extensions_.contains(id);
 }
 
 std::vector<extensions::ExtensionId>
 GreaselionServiceImpl::GetExtensionIdsForTesting() {
-  return greaselion_extensions_;
+  std::vector<extensions::ExtensionId> ids;
+  ids.reserve(greaselion_extensions_.size());
+  for (const auto& extension : greaselion_extensions_)
+    ids.push_back(extension.first);
+  return ids;
 }
 
 void GreaselionServiceImpl::UpdateInstalledExtensions() {
@@ -262,74 +402,117 @@ void GreaselionServiceImpl::UpdateInstalledExtensions() {
     return;
   }
   update_in_progress_ = true;
-  if (greaselion_extensions_.empty()) {
-    // No Greaselion extensions are currently installed, so we can move on to
-    // the install phase immediately.
+
+  // Keys are computed for all rules, matching or not, so that the cached
+  // extensions of rules that are only switched off are kept.
+  std::vector<GreaselionRule> rules;
+  for (const std::unique_ptr<GreaselionRule>& rule :
+       *download_service_->rules()) {
+    if (rule->has_unknown_preconditions() == false)
+      rules.push_back(*rule);
+  }
+  base::PostTaskAndReplyWithResult(
+      task_runner_.get(), FROM_HERE,
+      base::BindOnce(&ComputeCacheKeysOnTaskRunner, rules,
+                     browser_version_.GetString()),
+      base::BindOnce(&GreaselionServiceImpl::OnCacheKeysComputed,
+                     weak_factory_.GetWeakPtr(), rules));
+}
+
+void GreaselionServiceImpl::OnCacheKeysComputed(
+    std::vector<GreaselionRule> rules,
+    std::vector<std::string> cache_keys) {
+  DCHECK(update_in_progress_);
+  DCHECK_EQ(rules.size(), cache_keys.size());
+  rules_to_install_.clear();
+  rule_cache_keys_ = cache_keys;
+
+  base::flat_set<std::string> matching_cache_keys;
+  for (size_t i = 0; i < rules.size(); i++) {
+    if (!rules[i].Matches(state_, browser_version_))
+      continue;
+    matching_cache_keys.insert(cache_keys[i]);
+    const bool installed =
+        std::any_of(greaselion_extensions_.begin(),
+                    greaselion_extensions_.end(), [&](const auto& extension) {
+                      return extension.second == cache_keys[i];
+                    });
+    if (!installed)
+      rules_to_install_.emplace_back(std::move(rules[i]), cache_keys[i]);
+  }
+
+  // Extensions whose rule no longer matches or has changed are unloaded
+  // first. OnExtensionUnloaded will be called on each of them, and once they
+  // are all gone, it will call CreateAndInstallExtensions().
+  for (const auto& extension : greaselion_extensions_) {
+    if (!matching_cache_keys.contains(extension.second))
+      extensions_to_unload_.insert(extension.first);
+  }
+  if (extensions_to_unload_.empty()) {
     CreateAndInstallExtensions();
     return;
   }
 
-  // Make a copy of greaselion_extensions_ to iterate while the original vector
+  // Make a copy of extensions_to_unload_ to iterate while the original set
   // changes.
-  std::vector<extensions::ExtensionId> extensions = greaselion_extensions_;
-  for (auto id : extensions) {
-    // We need to unload all the Greaselion extensions that are already
-    // installed. OnExtensionUnloaded will be called on each extension, where we
-    // will update the greaselion_extensions_ set. Once it's empty, that
-    // callback will call CreateAndInstallExtensions().
+  const base::flat_set<extensions::ExtensionId> extensions =
+      extensions_to_unload_;
+  for (const auto& id : extensions) {
     extension_service_->UnloadExtension(
         id, extensions::UnloadedExtensionReason::UPDATE);
   }
 }
 
 void GreaselionServiceImpl::CreateAndInstallExtensions() {
-  DCHECK(greaselion_extensions_.empty());
+  DCHECK(extensions_to_unload_.empty());
   DCHECK(update_in_progress_);
   all_rules_installed_successfully_ = true;
-  pending_installs_ = 0;
-  std::vector<std::unique_ptr<GreaselionRule>>* rules =
-      download_service_->rules();
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_, browser_version_) &&
-        rule->has_unknown_preconditions() == false) {
-      pending_installs_ += 1;
-    }
+
+  // Only now that the extensions of changed rules are unloaded can their
+  // files be deleted. There are no rules until the Greaselion component has
+  // loaded, which can be after a feature was toggled at startup, and the
+  // cache must not be emptied then.
+  if (!rule_cache_keys_.empty()) {
+    task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(&PruneExtensionCacheOnTaskRunner,
+                                  rule_cache_keys_, install_directory_));
   }
+
+  pending_installs_ = rules_to_install_.size();
   if (!pending_installs_) {
-    // no rules match, nothing else to do
+    // nothing changed, nothing else to do
     MaybeNotifyObservers();
     return;
   }
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_, browser_version_) &&
-        rule->has_unknown_preconditions() == false) {
-      // Convert script file to component extension. This must run on extension
-      // file task runner, which was passed in in the constructor.
-      GreaselionRule rule_copy(*rule);
-      base::PostTaskAndReplyWithResult(
-          task_runner_.get(), FROM_HERE,
-          base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
-                         rule_copy, install_directory_),
-          base::BindOnce(&GreaselionServiceImpl::PostConvert,
-                         weak_factory_.GetWeakPtr()));
-    }
+  std::vector<GreaselionRuleAndCacheKey> rules = std::move(rules_to_install_);
+  for (GreaselionRuleAndCacheKey& rule : rules) {
+    // Load the component extension from the cache, converting the rule if
+    // needed. This must run on extension file task runner, which was passed
+    // in in the constructor.
+    const std::string cache_key = rule.second;
+    base::PostTaskAndReplyWithResult(
+        task_runner_.get(), FROM_HERE,
+        base::BindOnce(&LoadGreaselionExtensionOnTaskRunner,
+                       std::move(rule.first), cache_key, install_directory_),
+        base::BindOnce(&GreaselionServiceImpl::PostConvert,
+                       weak_factory_.GetWeakPtr(), cache_key));
   }
 }
 
 void GreaselionServiceImpl::PostConvert(
-    absl::optional<GreaselionConvertedExtension> converted_extension) {
-  if (!converted_extension) {
+    const std::string& cache_key,
+    scoped_refptr<extensions::Extension> extension) {
+  if (!extension) {
     all_rules_installed_successfully_ = false;
     pending_installs_ -= 1;
     MaybeNotifyObservers();
     LOG(ERROR) << "Could not load Greaselion script";
   } else {
-    greaselion_extensions_.push_back(converted_extension->first->id());
-    extension_dirs_.push_back(std::move(converted_extension->second));
+    greaselion_extensions_[extension->id()] = cache_key;
     extension_system_->ready().Post(
-        FROM_HERE, base::BindOnce(&GreaselionServiceImpl::Install,
-                                  weak_factory_.GetWeakPtr(),
-                                  std::move(converted_extension->first)));
+        FROM_HERE,
+        base::BindOnce(&GreaselionServiceImpl::Install,
+                       weak_factory_.GetWeakPtr(), std::move(extension)));
   }
 }
 
@@ -341,9 +524,7 @@ void GreaselionServiceImpl::Install(
 void GreaselionServiceImpl::OnExtensionReady(
     content::BrowserContext* browser_context,
     const extensions::Extension* extension) {
-  auto index = std::find(greaselion_extensions_.begin(),
-                         greaselion_extensions_.end(), extension->id());
-  if (index == greaselion_extensions_.end()) {
+  if (!greaselion_extensions_.contains(extension->id())) {
     // not one of ours
     return;
   }
@@ -356,14 +537,12 @@ void GreaselionServiceImpl::OnExtensionUnloaded(
     content::BrowserContext* browser_context,
     const extensions::Extension* extension,
     extensions::UnloadedExtensionReason reason) {
-  auto index = std::find(greaselion_extensions_.begin(),
-                         greaselion_extensions_.end(), extension->id());
-  if (index == greaselion_extensions_.end()) {
+  if (!greaselion_extensions_.erase(extension->id())) {
     // not one of ours
     return;
   }
-  greaselion_extensions_.erase(index);
-  if (update_in_progress_ && greaselion_extensions_.empty()) {
+  if (extensions_to_unload_.erase(extension->id()) &&
+      extensions_to_unload_.empty()) {
     // It's time!
     CreateAndInstallExtensions();
   }
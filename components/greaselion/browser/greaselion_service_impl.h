@@ -12,8 +12,9 @@
 #include <utility>
 #include <vector>
 
+#include "base/containers/flat_map.h"
+#include "base/containers/flat_set.h"
 #include "base/files/file_path.h"
-#include "base/files/scoped_temp_dir.h"
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
 #include "base/path_service.h"
@@ -37,6 +38,10 @@ class ExtensionSystem;
 
 namespace greaselion {
 
+// Converted extensions are kept in a cache under |install_directory|, keyed by
+// a hash of the rule, its scripts and messages and the browser version, so
+// that unchanged rules are loaded again without being converted. Updates only
+// unload and install the extensions whose key changed.
 class GreaselionServiceImpl : public GreaselionService,
                               public GreaselionDownloadService::Observer {
  public:
@@ -64,14 +69,15 @@ class GreaselionServiceImpl : public GreaselionService,
                            const extensions::Extension* extension,
                            extensions::UnloadedExtensionReason reason) override;
 
-  using GreaselionConvertedExtension =
-      std::pair<scoped_refptr<extensions::Extension>, base::ScopedTempDir>;
+  using GreaselionRuleAndCacheKey = std::pair<GreaselionRule, std::string>;
 
  private:
   void SetBrowserVersionForTesting(const base::Version& version) override;
+  void OnCacheKeysComputed(std::vector<GreaselionRule> rules,
+                           std::vector<std::string> cache_keys);
   void CreateAndInstallExtensions();
-  void PostConvert(
-      absl::optional<GreaselionConvertedExtension> converted_extension);
+  void PostConvert(const std::string& cache_key,
+                   scoped_refptr<extensions::Extension> extension);
   void Install(scoped_refptr<extensions::Extension> extension);
   void MaybeNotifyObservers();
 
@@ -90,8 +96,13 @@ class GreaselionServiceImpl : public GreaselionService,
   int pending_installs_;
   scoped_refptr<base::SequencedTaskRunner> task_runner_;
   base::ObserverList<GreaselionService::Observer> observers_;
-  std::vector<extensions::ExtensionId> greaselion_extensions_;
-  std::vector<base::ScopedTempDir> extension_dirs_;
+  // Cache keys of the loaded extensions.
+  base::flat_map<extensions::ExtensionId, std::string> greaselion_extensions_;
+  // Extensions waiting to be unloaded before |rules_to_install_| are.
+  base::flat_set<extensions::ExtensionId> extensions_to_unload_;
+  std::vector<GreaselionRuleAndCacheKey> rules_to_install_;
+  // Cache keys of all current rules, whether they match or not.
+  std::vector<std::string> rule_cache_keys_;
   base::Version browser_version_;
   base::WeakPtrFactory<GreaselionServiceImpl> weak_factory_;
 
@@ -0,0 +1,116 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ipfs/content_path_cache.h"
+
+#include <utility>
+
+#include "base/strings/strcat.h"
+#include "base/strings/string_util.h"
+#include "brave/components/ipfs/ipfs_utils.h"
+
+namespace {
+
+const char kIPFSPathPrefix[] = "/ipfs/";
+const char kIPNSPathPrefix[] = "/ipns/";
+const char kIPFSSubdomain[] = ".ipfs.";
+
+// If |url| looks like a gateway URL for immutable content, returns the key of
+// its gateway and the content path it would serve.
+bool ParseGatewayURL(const GURL& url,
+                     std::string* gateway_key,
+                     std::string* ipfs_path) {
+  const std::string& host = url.host();
+  const size_t subdomain = host.find(kIPFSSubdomain);
+  if (subdomain != std::string::npos &&
+      ipfs::IsValidCID(host.substr(0, subdomain))) {
+    *gateway_key = base::StrCat({"*", host.substr(subdomain)});
+    *ipfs_path =
+        base::StrCat({kIPFSPathPrefix, host.substr(0, subdomain), url.path()});
+    return true;
+  }
+
+  const std::string& path = url.path();
+  if (!base::StartsWith(path, kIPFSPathPrefix))
+    return false;
+  const size_t cid_start = sizeof(kIPFSPathPrefix) - 1;
+  const size_t cid_end = path.find('/', cid_start);
+  if (!ipfs::IsValidCID(path.substr(cid_start, cid_end - cid_start)))
+    return false;
+  *gateway_key = host;
+  *ipfs_path = path;
+  return true;
+}
+
+GURL GetCacheKey(const GURL& url) {
+  GURL::Replacements replacements;
+  replacements.ClearRef();
+  return url.ReplaceComponents(replacements);
+}
+
+}  // namespace
+
+namespace ipfs {
+
+ContentPathCache::ContentPathCache(size_t max_size)
+    : paths_(max_size), gateways_(max_size) {}
+
+ContentPathCache::~ContentPathCache() = default;
+
+void ContentPathCache::Add(const GURL& url,
+                           const std::string& ipfs_path,
+                           base::TimeDelta ipns_ttl) {
+  if (!url.is_valid())
+    return;
+
+  Entry entry;
+  entry.ipfs_path = ipfs_path;
+  if (base::StartsWith(ipfs_path, kIPNSPathPrefix)) {
+    if (ipns_ttl <= base::TimeDelta())
+      return;
+    entry.expiration_time = base::TimeTicks::Now() + ipns_ttl;
+  } else if (!base::StartsWith(ipfs_path, kIPFSPathPrefix)) {
+    return;
+  }
+
+  std::string gateway_key;
+  std::string gateway_path;
+  if (ParseGatewayURL(url, &gateway_key, &gateway_path) &&
+      gateway_path == ipfs_path) {
+    gateways_.Put(gateway_key, true);
+    return;
+  }
+  paths_.Put(GetCacheKey(url), std::move(entry));
+}
+
+std::string ContentPathCache::Get(const GURL& url) {
+  if (!url.is_valid())
+    return std::string();
+
+  std::string gateway_key;
+  std::string gateway_path;
+  if (ParseGatewayURL(url, &gateway_key, &gateway_path) &&
+      gateways_.Get(gateway_key) != gateways_.end()) {
+    return gateway_path;
+  }
+
+  auto it = paths_.Get(GetCacheKey(url));
+  if (it == paths_.end())
+    return std::string();
+  const Entry& entry = it->second;
+  if (!entry.expiration_time.is_null() &&
+      entry.expiration_time <= base::TimeTicks::Now()) {
+    paths_.Erase(it);
+    return std::string();
+  }
+  return entry.ipfs_path;
+}
+
+void ContentPathCache::Clear() {
+  paths_.Clear();
+  gateways_.Clear();
+}
+
+}  // namespace ipfs
@@ -0,0 +1,58 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_IPFS_CONTENT_PATH_CACHE_H_
+#define BRAVE_COMPONENTS_IPFS_CONTENT_PATH_CACHE_H_
+
+#include <string>
+
+#include "base/containers/mru_cache.h"
+#include "base/time/time.h"
+#include "url/gurl.h"
+
+namespace ipfs {
+
+// Remembers which URLs serve IPFS content, as announced by their x-ipfs-path
+// response header, so that later requests for them can go to the configured
+// gateway without a round-trip to the original server. Gateways are
+// recognized as well: once a host served /ipfs/<cid>/<path> at that same path
+// (or <cid>.ipfs.<domain> for subdomain gateways), every valid CID on it maps
+// to its content path. Either way the same CID and path end up fetched from,
+// and cached under, a single gateway origin.
+// /ipfs/ paths are immutable and never expire. /ipns/ paths can be repointed
+// and are only kept for their TTL.
+class ContentPathCache {
+ public:
+  explicit ContentPathCache(size_t max_size);
+  ~ContentPathCache();
+
+  ContentPathCache(const ContentPathCache&) = delete;
+  ContentPathCache& operator=(const ContentPathCache&) = delete;
+
+  // Records that |url| serves |ipfs_path|. Anything other than /ipfs/ and
+  // /ipns/ paths is ignored.
+  void Add(const GURL& url,
+           const std::string& ipfs_path,
+           base::TimeDelta ipns_ttl);
+  // Returns the content path served by |url|, or an empty string.
+  std::string Get(const GURL& url);
+  void Clear();
+
+ private:
+  struct Entry {
+    std::string ipfs_path;
+    // Null for content that doesn't expire.
+    base::TimeTicks expiration_time;
+  };
+
+  base::MRUCache<GURL, Entry> paths_;
+  // Keyed by the host of path gateways, or "*.ipfs.<domain>" for subdomain
+  // gateways.
+  base::MRUCache<std::string, bool> gateways_;
+};
+
+}  // namespace ipfs
+
+#endif  // BRAVE_COMPONENTS_IPFS_CONTENT_PATH_CACHE_H_
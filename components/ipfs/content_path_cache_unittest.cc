@@ -0,0 +1,94 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ipfs/content_path_cache.h"
+
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace {
+
+const char kCID1[] = "QmSrPmbaUKA3ZodhzPWZnpFgcPMFWF4QsxXbkWfEptTBJd";
+const char kCID2[] =
+    "bafybeiemxf5abjwjbikoz4mc3a3dla6ual3jsgpdr4cjr3oz3evfyavhwq";
+const char kCID3[] =
+    "bafybeibd4ala53bs26dvygofvr6ahpa7gbw4eyaibvrbivf4l5rr44yqu4";
+
+}  // namespace
+
+namespace ipfs {
+
+class ContentPathCacheTest : public testing::Test {
+ public:
+  ContentPathCacheTest() : cache_(10) {}
+
+ protected:
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  ContentPathCache cache_;
+};
+
+TEST_F(ContentPathCacheTest, IPFSPathsDontExpire) {
+  const std::string ipfs_path = std::string("/ipfs/") + kCID1 + "/index.html";
+  cache_.Add(GURL("https://example.com/index.html#top"), ipfs_path,
+             base::TimeDelta::FromMinutes(1));
+  task_environment_.FastForwardBy(base::TimeDelta::FromDays(1));
+  EXPECT_EQ(cache_.Get(GURL("https://example.com/index.html")), ipfs_path);
+  EXPECT_EQ(cache_.Get(GURL("https://example.com/index.html#bottom")),
+            ipfs_path);
+  EXPECT_EQ(cache_.Get(GURL("https://example.com/")), "");
+
+  cache_.Clear();
+  EXPECT_EQ(cache_.Get(GURL("https://example.com/index.html")), "");
+}
+
+TEST_F(ContentPathCacheTest, IPNSPathsExpire) {
+  cache_.Add(GURL("https://example.com/"), "/ipns/example.com/",
+             base::TimeDelta::FromMinutes(5));
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(4));
+  EXPECT_EQ(cache_.Get(GURL("https://example.com/")), "/ipns/example.com/");
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(1));
+  EXPECT_EQ(cache_.Get(GURL("https://example.com/")), "");
+
+  cache_.Add(GURL("https://example.com/"), "/ipns/example.com/",
+             base::TimeDelta());
+  EXPECT_EQ(cache_.Get(GURL("https://example.com/")), "");
+}
+
+TEST_F(ContentPathCacheTest, IgnoresOtherPaths) {
+  cache_.Add(GURL("https://example.com/"), "/test",
+             base::TimeDelta::FromMinutes(1));
+  EXPECT_EQ(cache_.Get(GURL("https://example.com/")), "");
+  cache_.Add(GURL(), std::string("/ipfs/") + kCID1,
+             base::TimeDelta::FromMinutes(1));
+  EXPECT_EQ(cache_.Get(GURL()), "");
+}
+
+TEST_F(ContentPathCacheTest, RecognizesPathGateways) {
+  cache_.Add(GURL(std::string("https://gateway.example/ipfs/") + kCID1),
+             std::string("/ipfs/") + kCID1, base::TimeDelta());
+  EXPECT_EQ(
+      cache_.Get(GURL(std::string("https://gateway.example/ipfs/") + kCID2 +
+                      "/a/b.png")),
+      std::string("/ipfs/") + kCID2 + "/a/b.png");
+  EXPECT_EQ(cache_.Get(GURL("https://gateway.example/ipfs/not-a-cid")), "");
+  EXPECT_EQ(
+      cache_.Get(GURL(std::string("https://other.example/ipfs/") + kCID2)),
+      "");
+}
+
+TEST_F(ContentPathCacheTest, RecognizesSubdomainGateways) {
+  cache_.Add(GURL(std::string("https://") + kCID2 + ".ipfs.gateway.example/"),
+             std::string("/ipfs/") + kCID2 + "/", base::TimeDelta());
+  EXPECT_EQ(cache_.Get(GURL(std::string("https://") + kCID3 +
+                            ".ipfs.gateway.example/index.html")),
+            std::string("/ipfs/") + kCID3 + "/index.html");
+  EXPECT_EQ(cache_.Get(GURL(std::string("https://") + kCID3 +
+                            ".ipfs.other.example/index.html")),
+            "");
+}
+
+}  // namespace ipfs
@@ -20,5 +20,10 @@ const base::Feature kIpfsFeature{
 #endif
 };
 
+// Imports folders one file at a time with several uploads in flight, instead
+// of as one multipart request.
+const base::Feature kIpfsStreamingFolderImport{
+    "IpfsStreamingFolderImport", base::FEATURE_DISABLED_BY_DEFAULT};
+
 }  // namespace features
 }  // namespace ipfs
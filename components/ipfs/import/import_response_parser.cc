@@ -0,0 +1,96 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ipfs/import/import_response_parser.h"
+
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/values.h"
+
+namespace {
+
+// Entries are a few hundred bytes at most, longer lines are not ours.
+const size_t kMaxLineLength = 64 * 1024;
+
+}  // namespace
+
+namespace ipfs {
+
+ImportResponseParser::ImportResponseParser(
+    ImportProgressCallback progress_callback,
+    EntryCallback entry_callback)
+    : progress_callback_(std::move(progress_callback)),
+      entry_callback_(std::move(entry_callback)) {}
+
+ImportResponseParser::~ImportResponseParser() = default;
+
+void ImportResponseParser::Append(base::StringPiece data) {
+  while (!data.empty()) {
+    const size_t end = data.find('\n');
+    const base::StringPiece chunk = data.substr(0, end);
+    if (!skipping_line_) {
+      if (partial_line_.size() + chunk.size() > kMaxLineLength) {
+        VLOG(1) << "Skipping oversized line in import response";
+        partial_line_.clear();
+        skipping_line_ = true;
+      } else {
+        chunk.AppendToString(&partial_line_);
+      }
+    }
+    if (end == base::StringPiece::npos)
+      return;
+
+    if (!skipping_line_)
+      ParseLine(partial_line_);
+    partial_line_.clear();
+    skipping_line_ = false;
+    data.remove_prefix(end + 1);
+  }
+}
+
+void ImportResponseParser::Finish() {
+  if (!skipping_line_)
+    ParseLine(partial_line_);
+  partial_line_.clear();
+  skipping_line_ = false;
+}
+
+void ImportResponseParser::ParseLine(base::StringPiece line) {
+  line = base::TrimWhitespaceASCII(line, base::TRIM_ALL);
+  if (line.empty() || line.front() != '{' || line.back() != '}')
+    return;
+
+  absl::optional<base::Value> value =
+      base::JSONReader::Read(line, base::JSONParserOptions::JSON_PARSE_RFC);
+  if (!value || !value->is_dict()) {
+    VLOG(1) << "Invalid import response line: " << line;
+    return;
+  }
+
+  const std::string* name = value->FindStringKey("Name");
+  const std::string* hash = value->FindStringKey("Hash");
+  if (hash) {
+    ImportedData entry;
+    if (name)
+      entry.filename = *name;
+    entry.hash = *hash;
+    const std::string* size = value->FindStringKey("Size");
+    if (size && !base::StringToInt64(*size, &entry.size))
+      entry.size = -1;
+    if (entry_callback_)
+      entry_callback_.Run(entry);
+    return;
+  }
+
+  absl::optional<double> bytes = value->FindDoubleKey("Bytes");
+  if (name && bytes && progress_callback_)
+    progress_callback_.Run(*name, static_cast<int64_t>(*bytes));
+}
+
+}  // namespace ipfs
@@ -0,0 +1,49 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_IPFS_IMPORT_IMPORT_RESPONSE_PARSER_H_
+#define BRAVE_COMPONENTS_IPFS_IMPORT_IMPORT_RESPONSE_PARSER_H_
+
+#include <string>
+
+#include "base/callback.h"
+#include "base/strings/string_piece.h"
+#include "brave/components/ipfs/import/imported_data.h"
+
+namespace ipfs {
+
+// Parses the newline delimited JSON returned by /api/v0/add as it arrives.
+// Each line is handled as soon as it is complete, so only a partial last line
+// is kept in memory. Progress lines ({"Name":..., "Bytes":...}) are passed to
+// the progress callback, added entries ({"Name":..., "Hash":..., "Size":...})
+// to the entry callback. Anything else is skipped.
+class ImportResponseParser {
+ public:
+  using EntryCallback = base::RepeatingCallback<void(const ImportedData&)>;
+
+  ImportResponseParser(ImportProgressCallback progress_callback,
+                       EntryCallback entry_callback);
+  ~ImportResponseParser();
+
+  ImportResponseParser(const ImportResponseParser&) = delete;
+  ImportResponseParser& operator=(const ImportResponseParser&) = delete;
+
+  void Append(base::StringPiece data);
+  // Handles the last line when the response doesn't end with a newline.
+  void Finish();
+
+ private:
+  void ParseLine(base::StringPiece line);
+
+  ImportProgressCallback progress_callback_;
+  EntryCallback entry_callback_;
+  std::string partial_line_;
+  // Set when a line grew past the limit, until its end is reached.
+  bool skipping_line_ = false;
+};
+
+}  // namespace ipfs
+
+#endif  // BRAVE_COMPONENTS_IPFS_IMPORT_IMPORT_RESPONSE_PARSER_H_
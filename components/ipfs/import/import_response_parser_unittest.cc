@@ -0,0 +1,67 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ipfs/import/import_response_parser.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/test/bind.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ipfs {
+
+class ImportResponseParserTest : public testing::Test {
+ public:
+  ImportResponseParserTest()
+      : parser_(base::BindLambdaForTesting(
+                    [this](const std::string& name, int64_t bytes) {
+                      progress_.push_back({name, bytes});
+                    }),
+                base::BindLambdaForTesting([this](const ImportedData& entry) {
+                  entries_.push_back(entry.filename + ":" + entry.hash + ":" +
+                                     std::to_string(entry.size));
+                })) {}
+
+ protected:
+  std::vector<std::pair<std::string, int64_t>> progress_;
+  std::vector<std::string> entries_;
+  ImportResponseParser parser_;
+};
+
+TEST_F(ImportResponseParserTest, ParsesLinesSplitAcrossChunks) {
+  const std::string response =
+      "{\"Name\":\"a.txt\",\"Bytes\":262144}\n"
+      "{\"Name\":\"a.txt\",\"Bytes\":300000}\n"
+      "{\"Name\":\"a.txt\",\"Hash\":\"QmA\",\"Size\":\"300011\"}\n"
+      "{\"Name\":\"\",\"Hash\":\"QmDir\",\"Size\":\"300060\"}";
+  // Feed the response a few bytes at a time.
+  for (size_t i = 0; i < response.size(); i += 7)
+    parser_.Append(base::StringPiece(response).substr(i, 7));
+  EXPECT_EQ(entries_.size(), 1u);
+  parser_.Finish();
+
+  EXPECT_EQ(progress_, (std::vector<std::pair<std::string, int64_t>>{
+                           {"a.txt", 262144}, {"a.txt", 300000}}));
+  EXPECT_EQ(entries_, (std::vector<std::string>{"a.txt:QmA:300011",
+                                                ":QmDir:300060"}));
+}
+
+TEST_F(ImportResponseParserTest, SkipsInvalidLines) {
+  parser_.Append("\n\nnot json\n{\"Name\":\"a\"\n");
+  parser_.Append("{\"Message\":\"error\",\"Type\":\"error\"}\r\n");
+  parser_.Append("{\"Name\":\"b\",\"Hash\":\"QmB\",\"Size\":\"x\"}\n");
+  // Oversized lines are dropped without being kept in memory.
+  parser_.Append(std::string(100 * 1024, ' '));
+  parser_.Append("{\"Name\":\"c\",\"Hash\":\"QmC\",\"Size\":\"1\"}\n");
+  parser_.Append("{\"Name\":\"d\",\"Hash\":\"QmD\",\"Size\":\"2\"}\n");
+  parser_.Finish();
+
+  EXPECT_TRUE(progress_.empty());
+  EXPECT_EQ(entries_, (std::vector<std::string>{"b:QmB:-1", "d:QmD:2"}));
+}
+
+}  // namespace ipfs
@@ -37,6 +37,9 @@ struct ImportedData {
 
 using ImportCompletedCallback =
     base::OnceCallback<void(const ipfs::ImportedData&)>;
+// Reports how many bytes of the file |name| the node has added so far.
+using ImportProgressCallback =
+    base::RepeatingCallback<void(const std::string& name, int64_t bytes)>;
 
 }  // namespace ipfs
 
@@ -0,0 +1,81 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ipfs/import/ipfs_add_request.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/notreached.h"
+#include "net/base/net_errors.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_status_code.h"
+#include "services/network/public/cpp/simple_url_loader.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+
+namespace ipfs {
+
+IpfsAddRequest::IpfsAddRequest(
+    std::unique_ptr<network::SimpleURLLoader> url_loader,
+    const std::string& filename,
+    ImportProgressCallback progress_callback)
+    : url_loader_(std::move(url_loader)),
+      filename_(filename),
+      parser_(std::move(progress_callback),
+              base::BindRepeating(&IpfsAddRequest::OnEntryAdded,
+                                  base::Unretained(this))) {
+  DCHECK(url_loader_);
+}
+
+IpfsAddRequest::~IpfsAddRequest() = default;
+
+void IpfsAddRequest::Start(network::mojom::URLLoaderFactory* url_loader_factory,
+                           AddCompletedCallback callback) {
+  DCHECK(!callback_);
+  callback_ = std::move(callback);
+  url_loader_->DownloadAsStream(url_loader_factory, this);
+}
+
+void IpfsAddRequest::OnDataReceived(base::StringPiece string_piece,
+                                    base::OnceClosure resume) {
+  parser_.Append(string_piece);
+  std::move(resume).Run();
+}
+
+void IpfsAddRequest::OnComplete(bool success) {
+  parser_.Finish();
+
+  int error_code = url_loader_->NetError();
+  int response_code = -1;
+  if (url_loader_->ResponseInfo() && url_loader_->ResponseInfo()->headers)
+    response_code = url_loader_->ResponseInfo()->headers->response_code();
+  success = success && error_code == net::OK &&
+            response_code == net::HTTP_OK && entry_found_;
+  if (!success) {
+    VLOG(1) << "error_code:" << error_code << " response_code:" << response_code
+            << " entry_found:" << entry_found_;
+  }
+
+  // The callback may delete |this|.
+  const std::string hash = hash_;
+  const int64_t size = size_;
+  std::move(callback_).Run(success, hash, size);
+}
+
+void IpfsAddRequest::OnRetry(base::OnceClosure start_retry) {
+  // Retries are not enabled for uploads.
+  NOTREACHED();
+}
+
+void IpfsAddRequest::OnEntryAdded(const ImportedData& entry) {
+  if (entry.filename != filename_)
+    return;
+  entry_found_ = true;
+  hash_ = entry.hash;
+  size_ = entry.size;
+}
+
+}  // namespace ipfs
@@ -0,0 +1,67 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_IPFS_IMPORT_IPFS_ADD_REQUEST_H_
+#define BRAVE_COMPONENTS_IPFS_IMPORT_IPFS_ADD_REQUEST_H_
+
+#include <memory>
+#include <string>
+
+#include "base/callback.h"
+#include "brave/components/ipfs/import/import_response_parser.h"
+#include "brave/components/ipfs/import/imported_data.h"
+#include "services/network/public/cpp/simple_url_loader_stream_consumer.h"
+
+namespace network {
+class SimpleURLLoader;
+namespace mojom {
+class URLLoaderFactory;
+}  // namespace mojom
+}  // namespace network
+
+namespace ipfs {
+
+// Sends a single /api/v0/add request and reads the response as a stream.
+// Progress is reported while the upload is still running and the response,
+// which has a line for every added file, is never held in memory as a whole.
+class IpfsAddRequest : public network::SimpleURLLoaderStreamConsumer {
+ public:
+  // |hash| and |size| are those of the entry named |filename|. The callback
+  // may delete the request.
+  using AddCompletedCallback = base::OnceCallback<
+      void(bool success, const std::string& hash, int64_t size)>;
+
+  IpfsAddRequest(std::unique_ptr<network::SimpleURLLoader> url_loader,
+                 const std::string& filename,
+                 ImportProgressCallback progress_callback);
+  ~IpfsAddRequest() override;
+
+  IpfsAddRequest(const IpfsAddRequest&) = delete;
+  IpfsAddRequest& operator=(const IpfsAddRequest&) = delete;
+
+  void Start(network::mojom::URLLoaderFactory* url_loader_factory,
+             AddCompletedCallback callback);
+
+ private:
+  // network::SimpleURLLoaderStreamConsumer
+  void OnDataReceived(base::StringPiece string_piece,
+                      base::OnceClosure resume) override;
+  void OnComplete(bool success) override;
+  void OnRetry(base::OnceClosure start_retry) override;
+
+  void OnEntryAdded(const ImportedData& entry);
+
+  std::unique_ptr<network::SimpleURLLoader> url_loader_;
+  std::string filename_;
+  ImportResponseParser parser_;
+  std::string hash_;
+  int64_t size_ = -1;
+  bool entry_found_ = false;
+  AddCompletedCallback callback_;
+};
+
+}  // namespace ipfs
+
+#endif  // BRAVE_COMPONENTS_IPFS_IMPORT_IPFS_ADD_REQUEST_H_
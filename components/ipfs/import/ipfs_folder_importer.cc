@@ -0,0 +1,311 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ipfs/import/ipfs_folder_importer.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/guid.h"
+#include "base/logging.h"
+#include "base/strings/strcat.h"
+#include "base/task/post_task.h"
+#include "base/task/thread_pool.h"
+#include "brave/components/ipfs/import/ipfs_add_request.h"
+#include "brave/components/ipfs/ipfs_constants.h"
+#include "brave/components/ipfs/ipfs_json_parser.h"
+#include "content/public/browser/browser_thread.h"
+#include "net/base/net_errors.h"
+#include "net/base/url_util.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_status_code.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/simple_url_loader.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+
+namespace {
+
+// Files being added, or directories being created, at the same time.
+const size_t kMaxOperationsInFlight = 4;
+
+// MFS responses are a single small JSON object.
+const size_t kMaxResponseSize = 64 * 1024;
+
+bool IsSuccessfulResponse(network::SimpleURLLoader* url_loader) {
+  int error_code = url_loader->NetError();
+  int response_code = -1;
+  if (url_loader->ResponseInfo() && url_loader->ResponseInfo()->headers)
+    response_code = url_loader->ResponseInfo()->headers->response_code();
+  bool success = (error_code == net::OK && response_code == net::HTTP_OK);
+  if (!success) {
+    VLOG(1) << "error_code:" << error_code
+            << " response_code:" << response_code;
+  }
+  return success;
+}
+
+}  // namespace
+
+namespace ipfs {
+
+IpfsFolderImporter::IpfsFolderImporter(
+    BlobContextGetterFactory* blob_context_getter_factory,
+    network::mojom::URLLoaderFactory* url_loader_factory,
+    const GURL& endpoint,
+    ImportProgressCallback progress_callback)
+    : blob_context_getter_factory_(blob_context_getter_factory),
+      url_loader_factory_(url_loader_factory),
+      server_endpoint_(endpoint),
+      progress_callback_(std::move(progress_callback)) {
+  DCHECK(endpoint.is_valid());
+}
+
+IpfsFolderImporter::~IpfsFolderImporter() = default;
+
+void IpfsFolderImporter::Start(const base::FilePath& folder_path,
+                               FolderImportedCallback callback) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  DCHECK(!callback_);
+  callback_ = std::move(callback);
+  staging_directory_ =
+      base::StrCat({kImportDirectory, ".staging-", base::GenerateGUID()});
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock()},
+      base::BindOnce(&EnumerateDirectoryFiles, folder_path),
+      base::BindOnce(&IpfsFolderImporter::OnFolderEnumerated,
+                     weak_factory_.GetWeakPtr(), folder_path));
+}
+
+void IpfsFolderImporter::OnFolderEnumerated(const base::FilePath& folder_path,
+                                            std::vector<ImportFileInfo> files) {
+  // Paths keep the folder name, the same as for a multipart folder upload.
+  // MFS paths are UTF-8 with forward slashes on every platform.
+  const base::FilePath parent = folder_path.DirName();
+  folder_name_ = folder_path.BaseName().AsUTF8Unsafe();
+  pending_directories_.push(folder_name_);
+  for (const auto& file : files) {
+    base::FilePath::StringType relative_path;
+    if (!GetRelativePathComponent(parent, file.path, &relative_path))
+      continue;
+    const std::string path = base::FilePath(relative_path)
+                                 .NormalizePathSeparatorsTo('/')
+                                 .AsUTF8Unsafe();
+    if (file.info.IsDirectory()) {
+      pending_directories_.push(path);
+    } else {
+      pending_files_.push({file.path, path, file.info.GetSize()});
+    }
+  }
+  PumpQueue();
+}
+
+void IpfsFolderImporter::PumpQueue() {
+  if (failed_) {
+    // Let requests that are already running finish before cleaning up.
+    if (!operations_in_flight_)
+      RemoveStagingDirectory();
+    return;
+  }
+
+  while (operations_in_flight_ < kMaxOperationsInFlight &&
+         !pending_directories_.empty()) {
+    MakeDirectory(pending_directories_.front());
+    pending_directories_.pop();
+  }
+  // Files are copied into the directories, so all of them must exist first.
+  if (!pending_directories_.empty() ||
+      (!adding_files_ && operations_in_flight_)) {
+    return;
+  }
+  adding_files_ = true;
+
+  while (operations_in_flight_ < kMaxOperationsInFlight &&
+         !pending_files_.empty()) {
+    AddFile(pending_files_.front());
+    pending_files_.pop();
+  }
+  if (!operations_in_flight_)
+    StatFolder();
+}
+
+void IpfsFolderImporter::MakeDirectory(const std::string& relative_path) {
+  GURL url = net::AppendQueryParameter(
+      server_endpoint_.Resolve(kImportMakeDirectoryPath), "arg",
+      GetStagingPath(relative_path));
+  url = net::AppendQueryParameter(url, "parents", "true");
+
+  operations_in_flight_++;
+  auto iter = AddURLLoader(url);
+  (*iter)->DownloadToString(
+      url_loader_factory_,
+      base::BindOnce(&IpfsFolderImporter::OnOperationCompleted,
+                     weak_factory_.GetWeakPtr(), iter),
+      kMaxResponseSize);
+}
+
+void IpfsFolderImporter::AddFile(const PendingFile& file) {
+  operations_in_flight_++;
+  const std::string filename = file.path.BaseName().AsUTF8Unsafe();
+  CreateRequestForFile(
+      file.path, blob_context_getter_factory_, kFileMimeType, filename,
+      base::BindOnce(&IpfsFolderImporter::UploadFile,
+                     weak_factory_.GetWeakPtr(), file.relative_path, filename),
+      file.size);
+}
+
+void IpfsFolderImporter::UploadFile(
+    const std::string& relative_path,
+    const std::string& filename,
+    std::unique_ptr<network::ResourceRequest> request) {
+  // Another operation may have failed while the file was being prepared.
+  if (!request || failed_) {
+    OnOperationFailed();
+    return;
+  }
+
+  GURL url = net::AppendQueryParameter(server_endpoint_.Resolve(kImportAddPath),
+                                       "stream-channels", "true");
+  url = net::AppendQueryParameter(url, "pin", "false");
+  url = net::AppendQueryParameter(url, "progress",
+                                  progress_callback_ ? "true" : "false");
+
+  ImportProgressCallback progress_callback;
+  if (progress_callback_) {
+    progress_callback =
+        base::BindRepeating(&IpfsFolderImporter::OnFileProgress,
+                            weak_factory_.GetWeakPtr(), relative_path);
+  }
+  auto iter = add_requests_.insert(
+      add_requests_.end(),
+      std::make_unique<IpfsAddRequest>(
+          CreateURLLoader(url, "POST", std::move(request)), filename,
+          std::move(progress_callback)));
+  (*iter)->Start(url_loader_factory_,
+                 base::BindOnce(&IpfsFolderImporter::OnFileAdded,
+                                weak_factory_.GetWeakPtr(), iter,
+                                relative_path));
+}
+
+void IpfsFolderImporter::OnFileProgress(const std::string& relative_path,
+                                        const std::string& name,
+                                        int64_t bytes) {
+  // The node only knows the file name, report the path within the folder.
+  progress_callback_.Run(relative_path, bytes);
+}
+
+void IpfsFolderImporter::OnFileAdded(AddRequestList::iterator iter,
+                                     const std::string& relative_path,
+                                     bool success,
+                                     const std::string& hash,
+                                     int64_t size) {
+  add_requests_.erase(iter);
+  if (!success || hash.empty() || failed_) {
+    OnOperationFailed();
+    return;
+  }
+  if (size > 0)
+    folder_size_ += size;
+  // The file keeps its slot until it has been copied into the folder.
+  CopyToStagingDirectory(relative_path, hash);
+}
+
+void IpfsFolderImporter::CopyToStagingDirectory(
+    const std::string& relative_path,
+    const std::string& hash) {
+  GURL url = net::AppendQueryParameter(
+      server_endpoint_.Resolve(kImportCopyPath), "arg", "/ipfs/" + hash);
+  url = net::AppendQueryParameter(url, "arg", GetStagingPath(relative_path));
+
+  auto iter = AddURLLoader(url);
+  (*iter)->DownloadToString(
+      url_loader_factory_,
+      base::BindOnce(&IpfsFolderImporter::OnOperationCompleted,
+                     weak_factory_.GetWeakPtr(), iter),
+      kMaxResponseSize);
+}
+
+void IpfsFolderImporter::OnOperationCompleted(
+    URLLoaderList::iterator iter,
+    std::unique_ptr<std::string> response_body) {
+  const bool success = IsSuccessfulResponse(iter->get());
+  url_loaders_.erase(iter);
+  if (!success) {
+    OnOperationFailed();
+    return;
+  }
+  operations_in_flight_--;
+  PumpQueue();
+}
+
+void IpfsFolderImporter::OnOperationFailed() {
+  DCHECK(operations_in_flight_);
+  failed_ = true;
+  operations_in_flight_--;
+  PumpQueue();
+}
+
+void IpfsFolderImporter::StatFolder() {
+  GURL url = net::AppendQueryParameter(
+      server_endpoint_.Resolve(kImportStatPath), "arg",
+      GetStagingPath(folder_name_));
+  auto iter = AddURLLoader(url);
+  (*iter)->DownloadToString(
+      url_loader_factory_,
+      base::BindOnce(&IpfsFolderImporter::OnFolderStat,
+                     weak_factory_.GetWeakPtr(), iter),
+      kMaxResponseSize);
+}
+
+void IpfsFolderImporter::OnFolderStat(
+    URLLoaderList::iterator iter,
+    std::unique_ptr<std::string> response_body) {
+  const bool success = IsSuccessfulResponse(iter->get());
+  url_loaders_.erase(iter);
+  ImportedData data;
+  if (success && response_body &&
+      IPFSJSONParser::GetImportResponseFromJSON(*response_body, &data)) {
+    folder_hash_ = data.hash;
+  }
+  failed_ = folder_hash_.empty();
+  RemoveStagingDirectory();
+}
+
+void IpfsFolderImporter::RemoveStagingDirectory() {
+  GURL url = net::AppendQueryParameter(
+      server_endpoint_.Resolve(kImportRemovePath), "arg", staging_directory_);
+  url = net::AppendQueryParameter(url, "recursive", "true");
+  auto iter = AddURLLoader(url);
+  (*iter)->DownloadToString(
+      url_loader_factory_,
+      base::BindOnce(&IpfsFolderImporter::OnStagingDirectoryRemoved,
+                     weak_factory_.GetWeakPtr(), iter),
+      kMaxResponseSize);
+}
+
+void IpfsFolderImporter::OnStagingDirectoryRemoved(
+    URLLoaderList::iterator iter,
+    std::unique_ptr<std::string> response_body) {
+  // Leftovers are harmless, the result doesn't depend on the removal.
+  IsSuccessfulResponse(iter->get());
+  url_loaders_.erase(iter);
+
+  // The callback may delete |this|.
+  const bool success = !failed_;
+  const std::string hash = folder_hash_;
+  const int64_t size = folder_size_;
+  std::move(callback_).Run(success, hash, size);
+}
+
+IpfsFolderImporter::URLLoaderList::iterator IpfsFolderImporter::AddURLLoader(
+    const GURL& url) {
+  return url_loaders_.insert(url_loaders_.end(), CreateURLLoader(url, "POST"));
+}
+
+std::string IpfsFolderImporter::GetStagingPath(
+    const std::string& relative_path) const {
+  return staging_directory_ + "/" + relative_path;
+}
+
+}  // namespace ipfs
@@ -0,0 +1,130 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_IPFS_IMPORT_IPFS_FOLDER_IMPORTER_H_
+#define BRAVE_COMPONENTS_IPFS_IMPORT_IPFS_FOLDER_IMPORTER_H_
+
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/queue.h"
+#include "base/files/file_path.h"
+#include "base/memory/weak_ptr.h"
+#include "brave/components/ipfs/blob_context_getter_factory.h"
+#include "brave/components/ipfs/import/imported_data.h"
+#include "brave/components/ipfs/ipfs_network_utils.h"
+#include "url/gurl.h"
+
+namespace network {
+class SimpleURLLoader;
+namespace mojom {
+class URLLoaderFactory;
+}  // namespace mojom
+}  // namespace network
+
+namespace ipfs {
+
+class IpfsAddRequest;
+
+// Adds a folder to ipfs one file at a time instead of as a single multipart
+// upload, so that large folders report per-file progress and are sent as a
+// bounded number of smaller requests.
+// The import process consists of the following steps:
+//   1. Creates the folder tree in a staging directory in MFS
+//      (/api/v0/files/mkdir)
+//   2. Adds every file (/api/v0/add) and copies it into place as soon as its
+//      hash is known (/api/v0/files/cp)
+//   3. Reads the hash of the assembled folder (/api/v0/files/stat)
+//   4. Removes the staging directory (/api/v0/files/rm)
+// At most kMaxOperationsInFlight requests of steps 1 and 2 run at once.
+class IpfsFolderImporter {
+ public:
+  // The callback may delete the importer.
+  using FolderImportedCallback = base::OnceCallback<
+      void(bool success, const std::string& hash, int64_t size)>;
+
+  IpfsFolderImporter(BlobContextGetterFactory* blob_context_getter_factory,
+                     network::mojom::URLLoaderFactory* url_loader_factory,
+                     const GURL& endpoint,
+                     ImportProgressCallback progress_callback);
+  ~IpfsFolderImporter();
+
+  IpfsFolderImporter(const IpfsFolderImporter&) = delete;
+  IpfsFolderImporter& operator=(const IpfsFolderImporter&) = delete;
+
+  void Start(const base::FilePath& folder_path,
+             FolderImportedCallback callback);
+
+ private:
+  struct PendingFile {
+    base::FilePath path;
+    std::string relative_path;
+    int64_t size = 0;
+  };
+  using URLLoaderList = std::list<std::unique_ptr<network::SimpleURLLoader>>;
+  using AddRequestList = std::list<std::unique_ptr<IpfsAddRequest>>;
+
+  void OnFolderEnumerated(const base::FilePath& folder_path,
+                          std::vector<ImportFileInfo> files);
+  void PumpQueue();
+
+  void MakeDirectory(const std::string& relative_path);
+  void AddFile(const PendingFile& file);
+  void UploadFile(const std::string& relative_path,
+                  const std::string& filename,
+                  std::unique_ptr<network::ResourceRequest> request);
+  void OnFileProgress(const std::string& relative_path,
+                      const std::string& name,
+                      int64_t bytes);
+  void OnFileAdded(AddRequestList::iterator iter,
+                   const std::string& relative_path,
+                   bool success,
+                   const std::string& hash,
+                   int64_t size);
+  void CopyToStagingDirectory(const std::string& relative_path,
+                              const std::string& hash);
+  void OnOperationCompleted(URLLoaderList::iterator iter,
+                            std::unique_ptr<std::string> response_body);
+  void OnOperationFailed();
+
+  void StatFolder();
+  void OnFolderStat(URLLoaderList::iterator iter,
+                    std::unique_ptr<std::string> response_body);
+  void RemoveStagingDirectory();
+  void OnStagingDirectoryRemoved(URLLoaderList::iterator iter,
+                                 std::unique_ptr<std::string> response_body);
+
+  URLLoaderList::iterator AddURLLoader(const GURL& url);
+  std::string GetStagingPath(const std::string& relative_path) const;
+
+  BlobContextGetterFactory* blob_context_getter_factory_ = nullptr;
+  network::mojom::URLLoaderFactory* url_loader_factory_ = nullptr;
+  GURL server_endpoint_;
+  ImportProgressCallback progress_callback_;
+  FolderImportedCallback callback_;
+
+  std::string staging_directory_;
+  std::string folder_name_;
+  base::queue<std::string> pending_directories_;
+  base::queue<PendingFile> pending_files_;
+  // Directory, add and copy requests that have been started but not
+  // completed. A file takes one slot from its add until its copy completes.
+  size_t operations_in_flight_ = 0;
+  bool adding_files_ = false;
+  bool failed_ = false;
+  std::string folder_hash_;
+  int64_t folder_size_ = 0;
+
+  URLLoaderList url_loaders_;
+  AddRequestList add_requests_;
+  base::WeakPtrFactory<IpfsFolderImporter> weak_factory_{this};
+};
+
+}  // namespace ipfs
+
+#endif  // BRAVE_COMPONENTS_IPFS_IMPORT_IPFS_FOLDER_IMPORTER_H_
@@ -8,18 +8,20 @@
 #include <utility>
 
 #include "base/command_line.h"
+#include "base/feature_list.h"
 #include "base/files/file_util.h"
 #include "base/guid.h"
 #include "base/strings/strcat.h"
-#include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/task/post_task.h"
 #include "base/task/thread_pool.h"
 #include "base/task_runner_util.h"
 #include "base/time/time.h"
+#include "brave/components/ipfs/features.h"
+#include "brave/components/ipfs/import/ipfs_add_request.h"
+#include "brave/components/ipfs/import/ipfs_folder_importer.h"
 #include "brave/components/ipfs/ipfs_constants.h"
-#include "brave/components/ipfs/ipfs_json_parser.h"
 #include "brave/components/ipfs/ipfs_utils.h"
 #include "brave/components/ipfs/pref_names.h"
 #include "brave/components/ipfs/service_sandbox_type.h"
@@ -94,13 +96,28 @@ void IpfsImportWorkerBase::ImportFile(const base::FilePath upload_file_path,
 }
 
 void IpfsImportWorkerBase::ImportFolder(const base::FilePath folder_path) {
+  data_->filename = folder_path.BaseName().MaybeAsASCII();
+  if (base::FeatureList::IsEnabled(features::kIpfsStreamingFolderImport)) {
+    DCHECK(!folder_importer_);
+    folder_importer_ = std::make_unique<IpfsFolderImporter>(
+        blob_context_getter_factory_, url_loader_factory_, server_endpoint_,
+        progress_callback_);
+    folder_importer_->Start(
+        folder_path, base::BindOnce(&IpfsImportWorkerBase::OnImportAddComplete,
+                                    weak_factory_.GetWeakPtr()));
+    return;
+  }
   auto upload_callback = base::BindOnce(&IpfsImportWorkerBase::UploadData,
                                         weak_factory_.GetWeakPtr());
-  data_->filename = folder_path.BaseName().MaybeAsASCII();
   CreateRequestForFolder(folder_path, blob_context_getter_factory_,
                          std::move(upload_callback));
 }
 
+void IpfsImportWorkerBase::SetProgressCallback(
+    ImportProgressCallback callback) {
+  progress_callback_ = std::move(callback);
+}
+
 void IpfsImportWorkerBase::ImportText(const std::string& text,
                                       const std::string& host) {
   if (text.empty() || host.empty()) {
@@ -130,52 +147,30 @@ void IpfsImportWorkerBase::UploadData(
                                        "stream-channels", "true");
   url = net::AppendQueryParameter(url, "wrap-with-directory", "true");
   url = net::AppendQueryParameter(url, "pin", "false");
-  url = net::AppendQueryParameter(url, "progress", "false");
-
-  DCHECK(!url_loader_);
-  url_loader_ = CreateURLLoader(url, "POST", std::move(request));
-
-  url_loader_->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
+  url = net::AppendQueryParameter(url, "progress",
+                                  progress_callback_ ? "true" : "false");
+
+  // The response is parsed as it streams in, the node writes a line for
+  // every file and, with progress enabled, for every chunk of it.
+  DCHECK(!add_request_);
+  add_request_ = std::make_unique<IpfsAddRequest>(
+      CreateURLLoader(url, "POST", std::move(request)), data_->filename,
+      progress_callback_);
+  add_request_->Start(
       url_loader_factory_,
       base::BindOnce(&IpfsImportWorkerBase::OnImportAddComplete,
                      weak_factory_.GetWeakPtr()));
 }
 
-bool IpfsImportWorkerBase::ParseResponseBody(const std::string& response_body,
-                                             ipfs::ImportedData* data) {
-  DCHECK(data);
-  std::vector<std::string> parts = base::SplitString(
-      response_body, "\n", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL);
-  if (!parts.size())
-    return IPFSJSONParser::GetImportResponseFromJSON(response_body, data);
-  for (const auto& item : parts) {
-    if (item.front() != '{' || item.back() != '}')
-      continue;
-    ipfs::ImportedData imported_item;
-    if (IPFSJSONParser::GetImportResponseFromJSON(item, &imported_item)) {
-      if (imported_item.filename != data->filename)
-        continue;
-      data->hash = imported_item.hash;
-      data->size = imported_item.size;
-      return true;
-    }
-  }
-  return false;
-}
-
-void IpfsImportWorkerBase::OnImportAddComplete(
-    std::unique_ptr<std::string> response_body) {
-  int error_code = url_loader_->NetError();
-  int response_code = -1;
-  if (url_loader_->ResponseInfo() && url_loader_->ResponseInfo()->headers)
-    response_code = url_loader_->ResponseInfo()->headers->response_code();
-
-  bool success = (error_code == net::OK && response_code == net::HTTP_OK);
-  if (success) {
-    success = ParseResponseBody(*response_body, data_.get());
-  }
-  url_loader_.reset();
-  if (success && !data_->hash.empty()) {
+void IpfsImportWorkerBase::OnImportAddComplete(bool success,
+                                               const std::string& hash,
+                                               int64_t size) {
+  // Both of these run this callback as their last step.
+  add_request_.reset();
+  folder_importer_.reset();
+  if (success && !hash.empty()) {
+    data_->hash = hash;
+    data_->size = size;
     CreateBraveDirectory();
     return;
   }
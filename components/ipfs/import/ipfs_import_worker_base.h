@@ -30,6 +30,9 @@ struct ResourceRequest;
 
 namespace ipfs {
 
+class IpfsAddRequest;
+class IpfsFolderImporter;
+
 // A base class that implements steps for importing objects into ipfs.
 // In order to import an object it is necessary to create
 // an ImportWorker of the desired type, each worker can import only one object.
@@ -38,7 +41,9 @@ namespace ipfs {
 // Worker:
 //   1. Worker prepares a blob block of data to import
 // IpfsImportWorkerBase:
-//   2. Sends blob to ifps using IPFS api (/api/v0/add)
+//   2. Sends blob to ifps using IPFS api (/api/v0/add). Folders are sent one
+//      file at a time by IpfsFolderImporter when kIpfsStreamingFolderImport
+//      is enabled
 //   3. Creates target directory for import using IPFS api(/api/v0/files/mkdir)
 //   4. Moves objects to target directory using IPFS api(/api/v0/files/cp)
 //   5. Publishes objects under passed IPNS key(/api/v0/name/publish)
@@ -61,6 +66,9 @@ class IpfsImportWorkerBase {
   void ImportText(const std::string& text, const std::string& host);
   void ImportFolder(const base::FilePath folder_path);
 
+  // Reports the number of bytes of each file added so far.
+  void SetProgressCallback(ImportProgressCallback callback);
+
  protected:
   network::mojom::URLLoaderFactory* GetUrlLoaderFactory();
 
@@ -69,23 +77,26 @@ class IpfsImportWorkerBase {
  private:
   void UploadData(std::unique_ptr<network::ResourceRequest> request);
 
-  void OnImportAddComplete(std::unique_ptr<std::string> response_body);
+  void OnImportAddComplete(bool success,
+                           const std::string& hash,
+                           int64_t size);
 
   void CreateBraveDirectory();
   void OnImportDirectoryCreated(const std::string& directory,
                                 std::unique_ptr<std::string> response_body);
   void CopyFilesToBraveDirectory();
   void OnImportFilesMoved(std::unique_ptr<std::string> response_body);
-  bool ParseResponseBody(const std::string& response_body,
-                         ipfs::ImportedData* data);
   void PublishContent();
   void OnContentPublished(std::unique_ptr<std::string> response_body);
   ImportCompletedCallback callback_;
+  ImportProgressCallback progress_callback_;
   std::unique_ptr<ipfs::ImportedData> data_;
 
   BlobContextGetterFactory* blob_context_getter_factory_ = nullptr;
   network::mojom::URLLoaderFactory* url_loader_factory_;
   std::unique_ptr<network::SimpleURLLoader> url_loader_;
+  std::unique_ptr<IpfsAddRequest> add_request_;
+  std::unique_ptr<IpfsFolderImporter> folder_importer_;
   GURL server_endpoint_;
   std::string key_to_publish_;
   base::WeakPtrFactory<IpfsImportWorkerBase> weak_factory_;
@@ -57,41 +57,6 @@ net::NetworkTrafficAnnotationTag GetIpfsNetworkTrafficAnnotationTag() {
 }
 
 #if BUILDFLAG(ENABLE_IPFS_LOCAL_NODE)
-struct ImportFileInfo {
-  ImportFileInfo(base::FilePath full_path,
-                 base::FileEnumerator::FileInfo information) {
-    path = full_path;
-    info = information;
-  }
-  base::FilePath path;
-  base::FileEnumerator::FileInfo info;
-};
-
-bool GetRelativePathComponent(const base::FilePath& parent,
-                              const base::FilePath& child,
-                              base::FilePath::StringType* out) {
-  if (!parent.IsParent(child))
-    return false;
-
-  std::vector<base::FilePath::StringType> parent_components;
-  std::vector<base::FilePath::StringType> child_components;
-  parent.GetComponents(&parent_components);
-  child.GetComponents(&child_components);
-
-  size_t i = 0;
-  while (i < parent_components.size() &&
-         child_components[i] == parent_components[i]) {
-    ++i;
-  }
-
-  while (i < child_components.size()) {
-    out->append(child_components[i]);
-    if (++i < child_components.size())
-      out->append(FILE_PATH_LITERAL("/"));
-  }
-  return true;
-}
-
 std::unique_ptr<storage::BlobDataBuilder> BuildBlobWithText(
     const std::string& text,
     std::string mime_type,
@@ -138,13 +103,13 @@ std::unique_ptr<storage::BlobDataBuilder> BuildBlobWithFile(
 std::unique_ptr<storage::BlobDataBuilder> BuildBlobWithFolder(
     base::FilePath upload_path,
     std::string mime_boundary,
-    std::vector<ImportFileInfo> files) {
+    std::vector<ipfs::ImportFileInfo> files) {
   auto blob_builder =
       std::make_unique<storage::BlobDataBuilder>(base::GenerateGUID());
   for (const auto& info : files) {
     std::string data_header;
     base::FilePath::StringType relative_path;
-    GetRelativePathComponent(upload_path, info.path, &relative_path);
+    ipfs::GetRelativePathComponent(upload_path, info.path, &relative_path);
 
     std::string mime_type = info.info.IsDirectory() ? ipfs::kDirectoryMimeType
                                                     : ipfs::kFileMimeType;
@@ -242,6 +207,31 @@ void AddMultipartHeaderForUploadWithFileName(const std::string& value_name,
   post_data->append("\r\n");
 }
 
+bool GetRelativePathComponent(const base::FilePath& parent,
+                              const base::FilePath& child,
+                              base::FilePath::StringType* out) {
+  if (!parent.IsParent(child))
+    return false;
+
+  std::vector<base::FilePath::StringType> parent_components;
+  std::vector<base::FilePath::StringType> child_components;
+  parent.GetComponents(&parent_components);
+  child.GetComponents(&child_components);
+
+  size_t i = 0;
+  while (i < parent_components.size() &&
+         child_components[i] == parent_components[i]) {
+    ++i;
+  }
+
+  while (i < child_components.size()) {
+    out->append(child_components[i]);
+    if (++i < child_components.size())
+      out->append(FILE_PATH_LITERAL("/"));
+  }
+  return true;
+}
+
 int64_t CalculateFileSize(base::FilePath upload_file_path) {
   int64_t file_size = -1;
   base::GetFileSize(upload_file_path, &file_size);
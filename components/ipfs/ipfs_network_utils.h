@@ -8,6 +8,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/files/file_enumerator.h"
@@ -51,6 +52,25 @@ void AddMultipartHeaderForUploadWithFileName(const std::string& value_name,
 
 int64_t CalculateFileSize(base::FilePath upload_file_path);
 
+struct ImportFileInfo {
+  ImportFileInfo(base::FilePath full_path,
+                 base::FileEnumerator::FileInfo information) {
+    path = full_path;
+    info = information;
+  }
+  base::FilePath path;
+  base::FileEnumerator::FileInfo info;
+};
+
+// Lists the files and directories under |dir_path|, skipping symlinks.
+std::vector<ImportFileInfo> EnumerateDirectoryFiles(base::FilePath dir_path);
+
+// Writes the path of |child| relative to |parent| to |out|, with components
+// separated by '/'.
+bool GetRelativePathComponent(const base::FilePath& parent,
+                              const base::FilePath& child,
+                              base::FilePath::StringType* out);
+
 using BlobBuilderCallback =
     base::OnceCallback<std::unique_ptr<storage::BlobDataBuilder>()>;
 
@@ -0,0 +1,157 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ipfs/ipfs_node_monitor.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bind.h"
+
+namespace ipfs {
+
+template <typename T>
+IpfsNodeMonitor::Value<T>::Value(
+    base::RepeatingCallback<void(Callback)> request,
+    base::RepeatingCallback<void(const T&)> on_changed)
+    : request(std::move(request)), on_changed(std::move(on_changed)) {}
+
+template <typename T>
+IpfsNodeMonitor::Value<T>::~Value() = default;
+
+IpfsNodeMonitor::IpfsNodeMonitor(Delegate* delegate)
+    : peers_(base::BindRepeating(&Delegate::RequestConnectedPeers,
+                                 base::Unretained(delegate)),
+             base::BindRepeating(&Delegate::OnConnectedPeersChanged,
+                                 base::Unretained(delegate))),
+      repo_stats_(base::BindRepeating(&Delegate::RequestRepoStats,
+                                      base::Unretained(delegate)),
+                  base::BindRepeating(&Delegate::OnRepoStatsChanged,
+                                      base::Unretained(delegate))),
+      node_info_(base::BindRepeating(&Delegate::RequestNodeInfo,
+                                     base::Unretained(delegate)),
+                 base::BindRepeating(&Delegate::OnNodeInfoChanged,
+                                     base::Unretained(delegate))),
+      refresh_interval_(kMinRefreshInterval) {
+  DCHECK(delegate);
+}
+
+IpfsNodeMonitor::~IpfsNodeMonitor() = default;
+
+void IpfsNodeMonitor::GetConnectedPeers(ConnectedPeersCallback callback) {
+  Get(&peers_, std::move(callback));
+}
+
+void IpfsNodeMonitor::GetRepoStats(RepoStatsCallback callback) {
+  Get(&repo_stats_, std::move(callback));
+}
+
+void IpfsNodeMonitor::GetNodeInfo(NodeInfoCallback callback) {
+  Get(&node_info_, std::move(callback));
+}
+
+void IpfsNodeMonitor::Reset() {
+  weak_factory_.InvalidateWeakPtrs();
+  refresh_timer_.Stop();
+  monitoring_ = false;
+  requests_in_flight_ = 0;
+  changed_ = false;
+  last_refresh_time_ = base::TimeTicks();
+  refresh_interval_ = kMinRefreshInterval;
+  ResetValue(&peers_);
+  ResetValue(&repo_stats_);
+  ResetValue(&node_info_);
+}
+
+template <typename T>
+void IpfsNodeMonitor::Get(Value<T>* value,
+                          typename Value<T>::Callback callback) {
+  if (!monitoring_) {
+    monitoring_ = true;
+    last_refresh_time_ = base::TimeTicks::Now();
+  }
+
+  if (!value->snapshot) {
+    value->pending_callbacks.push_back(std::move(callback));
+    Request(value);
+    return;
+  }
+
+  std::move(callback).Run(true, *value->snapshot);
+  // Someone is looking, refresh at the fastest rate again.
+  refresh_interval_ = kMinRefreshInterval;
+  if (base::TimeTicks::Now() - last_refresh_time_ >= kMinRefreshInterval)
+    RefreshAll();
+  else if (!requests_in_flight_)
+    ScheduleRefresh();
+}
+
+template <typename T>
+void IpfsNodeMonitor::Request(Value<T>* value) {
+  if (value->request_in_flight)
+    return;
+  value->request_in_flight = true;
+  requests_in_flight_++;
+  refresh_timer_.Stop();
+  value->request.Run(base::BindOnce(&IpfsNodeMonitor::OnValueReceived<T>,
+                                    weak_factory_.GetWeakPtr(), value));
+}
+
+template <typename T>
+void IpfsNodeMonitor::OnValueReceived(Value<T>* value,
+                                      bool success,
+                                      const T& result) {
+  DCHECK(value->request_in_flight);
+  value->request_in_flight = false;
+  requests_in_flight_--;
+
+  // A failed refresh keeps the last known value.
+  if (success && (!value->snapshot || !(*value->snapshot == result))) {
+    const bool was_known = value->snapshot.has_value();
+    value->snapshot = result;
+    changed_ = true;
+    if (was_known)
+      value->on_changed.Run(result);
+  }
+
+  auto callbacks = std::move(value->pending_callbacks);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(success, result);
+
+  if (!requests_in_flight_)
+    ScheduleRefresh();
+}
+
+template <typename T>
+void IpfsNodeMonitor::ResetValue(Value<T>* value) {
+  value->snapshot.reset();
+  value->request_in_flight = false;
+  auto callbacks = std::move(value->pending_callbacks);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(false, T());
+}
+
+void IpfsNodeMonitor::RefreshAll() {
+  last_refresh_time_ = base::TimeTicks::Now();
+  Request(&peers_);
+  Request(&repo_stats_);
+  Request(&node_info_);
+}
+
+void IpfsNodeMonitor::ScheduleRefresh() {
+  if (!monitoring_)
+    return;
+  if (changed_) {
+    refresh_interval_ = kMinRefreshInterval;
+  } else if (!refresh_timer_.IsRunning()) {
+    refresh_interval_ = std::min(refresh_interval_ * 2, kMaxRefreshInterval);
+  }
+  changed_ = false;
+  refresh_timer_.Start(FROM_HERE, refresh_interval_,
+                       base::BindOnce(&IpfsNodeMonitor::RefreshAll,
+                                      weak_factory_.GetWeakPtr()));
+}
+
+}  // namespace ipfs
@@ -0,0 +1,120 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_IPFS_IPFS_NODE_MONITOR_H_
+#define BRAVE_COMPONENTS_IPFS_IPFS_NODE_MONITOR_H_
+
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "brave/components/ipfs/node_info.h"
+#include "brave/components/ipfs/repo_stats.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace ipfs {
+
+// Keeps a snapshot of the connected peers, repo stats and node info of the
+// running daemon, so that callers get an answer without waiting for the daemon
+// API. Once something asked for the snapshot it is refreshed in the
+// background: every kMinRefreshInterval while values keep changing, backing
+// off up to kMaxRefreshInterval while they stay the same. Values that aren't
+// known yet are requested once, however many callers are waiting for them.
+class IpfsNodeMonitor {
+ public:
+  using ConnectedPeersCallback =
+      base::OnceCallback<void(bool, const std::vector<std::string>&)>;
+  using RepoStatsCallback = base::OnceCallback<void(bool, const RepoStats&)>;
+  using NodeInfoCallback = base::OnceCallback<void(bool, const NodeInfo&)>;
+
+  class Delegate {
+   public:
+    virtual ~Delegate() = default;
+
+    // Request the value from the daemon.
+    virtual void RequestConnectedPeers(ConnectedPeersCallback callback) = 0;
+    virtual void RequestRepoStats(RepoStatsCallback callback) = 0;
+    virtual void RequestNodeInfo(NodeInfoCallback callback) = 0;
+
+    // Called when a refresh changed a value that was already known.
+    virtual void OnConnectedPeersChanged(
+        const std::vector<std::string>& peers) = 0;
+    virtual void OnRepoStatsChanged(const RepoStats& stats) = 0;
+    virtual void OnNodeInfoChanged(const NodeInfo& info) = 0;
+  };
+
+  static constexpr base::TimeDelta kMinRefreshInterval =
+      base::TimeDelta::FromSeconds(5);
+  static constexpr base::TimeDelta kMaxRefreshInterval =
+      base::TimeDelta::FromMinutes(5);
+
+  explicit IpfsNodeMonitor(Delegate* delegate);
+  ~IpfsNodeMonitor();
+
+  IpfsNodeMonitor(const IpfsNodeMonitor&) = delete;
+  IpfsNodeMonitor& operator=(const IpfsNodeMonitor&) = delete;
+
+  void GetConnectedPeers(ConnectedPeersCallback callback);
+  void GetRepoStats(RepoStatsCallback callback);
+  void GetNodeInfo(NodeInfoCallback callback);
+
+  // Forgets the snapshot and stops refreshing it, for when the daemon goes
+  // away. Callers still waiting for a value get a failure.
+  void Reset();
+
+  base::TimeDelta refresh_interval_for_testing() const {
+    return refresh_interval_;
+  }
+
+ private:
+  template <typename T>
+  struct Value {
+    using Callback = base::OnceCallback<void(bool, const T&)>;
+
+    Value(base::RepeatingCallback<void(Callback)> request,
+          base::RepeatingCallback<void(const T&)> on_changed);
+    ~Value();
+
+    base::RepeatingCallback<void(Callback)> request;
+    base::RepeatingCallback<void(const T&)> on_changed;
+    absl::optional<T> snapshot;
+    std::vector<Callback> pending_callbacks;
+    bool request_in_flight = false;
+  };
+
+  template <typename T>
+  void Get(Value<T>* value, typename Value<T>::Callback callback);
+  template <typename T>
+  void Request(Value<T>* value);
+  template <typename T>
+  void OnValueReceived(Value<T>* value, bool success, const T& result);
+  template <typename T>
+  void ResetValue(Value<T>* value);
+
+  void RefreshAll();
+  void ScheduleRefresh();
+
+  Value<std::vector<std::string>> peers_;
+  Value<RepoStats> repo_stats_;
+  Value<NodeInfo> node_info_;
+
+  // Refreshing starts with the first Get*() call.
+  bool monitoring_ = false;
+  size_t requests_in_flight_ = 0;
+  // Whether any value changed since the last refresh was scheduled.
+  bool changed_ = false;
+  base::TimeTicks last_refresh_time_;
+  base::TimeDelta refresh_interval_;
+  base::OneShotTimer refresh_timer_;
+
+  base::WeakPtrFactory<IpfsNodeMonitor> weak_factory_{this};
+};
+
+}  // namespace ipfs
+
+#endif  // BRAVE_COMPONENTS_IPFS_IPFS_NODE_MONITOR_H_
@@ -0,0 +1,143 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ipfs/ipfs_node_monitor.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ipfs {
+
+class IpfsNodeMonitorTest : public testing::Test,
+                            public IpfsNodeMonitor::Delegate {
+ public:
+  IpfsNodeMonitorTest() : monitor_(this) {}
+
+  // IpfsNodeMonitor::Delegate
+  void RequestConnectedPeers(
+      IpfsNodeMonitor::ConnectedPeersCallback callback) override {
+    peers_requests_++;
+    peers_callbacks_.push_back(std::move(callback));
+  }
+  void RequestRepoStats(IpfsNodeMonitor::RepoStatsCallback callback) override {
+    repo_stats_requests_++;
+    std::move(callback).Run(true, repo_stats_);
+  }
+  void RequestNodeInfo(IpfsNodeMonitor::NodeInfoCallback callback) override {
+    node_info_requests_++;
+    std::move(callback).Run(true, node_info_);
+  }
+  void OnConnectedPeersChanged(
+      const std::vector<std::string>& peers) override {
+    peers_changes_++;
+  }
+  void OnRepoStatsChanged(const RepoStats& stats) override {
+    repo_stats_changes_++;
+  }
+  void OnNodeInfoChanged(const NodeInfo& info) override {}
+
+  void RespondToPeersRequests(bool success,
+                              const std::vector<std::string>& peers) {
+    auto callbacks = std::move(peers_callbacks_);
+    for (auto& callback : callbacks)
+      std::move(callback).Run(success, peers);
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  std::vector<IpfsNodeMonitor::ConnectedPeersCallback> peers_callbacks_;
+  RepoStats repo_stats_;
+  NodeInfo node_info_;
+  int peers_requests_ = 0;
+  int repo_stats_requests_ = 0;
+  int node_info_requests_ = 0;
+  int peers_changes_ = 0;
+  int repo_stats_changes_ = 0;
+  IpfsNodeMonitor monitor_;
+};
+
+TEST_F(IpfsNodeMonitorTest, CoalescesRequests) {
+  std::vector<size_t> results;
+  auto callback = [&](bool success, const std::vector<std::string>& peers) {
+    EXPECT_TRUE(success);
+    results.push_back(peers.size());
+  };
+  monitor_.GetConnectedPeers(base::BindLambdaForTesting(callback));
+  monitor_.GetConnectedPeers(base::BindLambdaForTesting(callback));
+  EXPECT_EQ(peers_requests_, 1);
+
+  RespondToPeersRequests(true, {"a", "b"});
+  EXPECT_EQ(results, (std::vector<size_t>{2, 2}));
+  EXPECT_EQ(peers_changes_, 0);
+
+  // Known values are answered right away.
+  monitor_.GetConnectedPeers(base::BindLambdaForTesting(callback));
+  EXPECT_EQ(results, (std::vector<size_t>{2, 2, 2}));
+  EXPECT_EQ(peers_requests_, 1);
+}
+
+TEST_F(IpfsNodeMonitorTest, RefreshBacksOffWhileUnchanged) {
+  monitor_.GetRepoStats(base::DoNothing());
+  EXPECT_EQ(repo_stats_requests_, 1);
+  EXPECT_EQ(monitor_.refresh_interval_for_testing(),
+            IpfsNodeMonitor::kMinRefreshInterval);
+
+  task_environment_.FastForwardBy(IpfsNodeMonitor::kMinRefreshInterval);
+  EXPECT_EQ(repo_stats_requests_, 2);
+  EXPECT_EQ(node_info_requests_, 1);
+  EXPECT_EQ(peers_requests_, 1);
+  // The peers request is still running, nothing else is requested meanwhile.
+  task_environment_.FastForwardBy(IpfsNodeMonitor::kMaxRefreshInterval);
+  EXPECT_EQ(repo_stats_requests_, 2);
+
+  RespondToPeersRequests(true, {});
+  EXPECT_EQ(monitor_.refresh_interval_for_testing(),
+            IpfsNodeMonitor::kMinRefreshInterval);
+  task_environment_.FastForwardBy(IpfsNodeMonitor::kMinRefreshInterval);
+  EXPECT_EQ(repo_stats_requests_, 3);
+  RespondToPeersRequests(true, {});
+  EXPECT_EQ(monitor_.refresh_interval_for_testing(),
+            IpfsNodeMonitor::kMinRefreshInterval * 2);
+
+  // A change goes back to the shortest interval and reaches the delegate.
+  repo_stats_.objects = 10;
+  task_environment_.FastForwardBy(IpfsNodeMonitor::kMinRefreshInterval * 2);
+  RespondToPeersRequests(true, {});
+  EXPECT_EQ(repo_stats_requests_, 4);
+  EXPECT_EQ(repo_stats_changes_, 1);
+  EXPECT_EQ(monitor_.refresh_interval_for_testing(),
+            IpfsNodeMonitor::kMinRefreshInterval);
+
+  monitor_.GetRepoStats(
+      base::BindLambdaForTesting([](bool success, const RepoStats& stats) {
+        EXPECT_TRUE(success);
+        EXPECT_EQ(stats.objects, 10u);
+      }));
+}
+
+TEST_F(IpfsNodeMonitorTest, ResetFailsPendingRequests) {
+  bool called = false;
+  monitor_.GetConnectedPeers(base::BindLambdaForTesting(
+      [&](bool success, const std::vector<std::string>& peers) {
+        EXPECT_FALSE(success);
+        called = true;
+      }));
+  monitor_.Reset();
+  EXPECT_TRUE(called);
+
+  // Responses to requests made before the reset are dropped.
+  RespondToPeersRequests(true, {"a"});
+  task_environment_.FastForwardBy(IpfsNodeMonitor::kMaxRefreshInterval);
+  EXPECT_EQ(peers_requests_, 1);
+  EXPECT_EQ(repo_stats_requests_, 0);
+}
+
+}  // namespace ipfs
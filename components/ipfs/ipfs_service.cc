@@ -80,6 +80,8 @@ const int kPeersRetryRate = 3;
 const char kGatewayValidationCID[] = "bafkqae2xmvwgg33nmuqhi3zajfiemuzahiwss";
 const char kGatewayValidationResult[] = "Welcome to IPFS :-)";
 
+const size_t kMaxPrewarmedLinks = 100;
+
 std::pair<bool, std::string> LoadConfigFileOnFileTaskRunner(
     const base::FilePath& path) {
   std::string data;
@@ -105,6 +107,7 @@ IpfsService::IpfsService(
     version_info::Channel channel)
     : prefs_(prefs),
       url_loader_factory_(url_loader_factory),
+      prewarmed_links_(kMaxPrewarmedLinks),
       blob_context_getter_factory_(std::move(blob_context_getter_factory)),
       server_endpoint_(GetAPIServer(channel)),
       user_data_dir_(user_data_dir),
@@ -280,6 +283,7 @@ void IpfsService::Shutdown() {
   }
   ipfs_service_.reset();
   ipfs_pid_ = -1;
+  node_monitor_.Reset();
 }
 
 #if BUILDFLAG(ENABLE_IPFS_LOCAL_NODE)
@@ -385,6 +389,8 @@ void IpfsService::ImportFileToIpfs(const base::FilePath& path,
   importers_[hash] = std::make_unique<IpfsImportWorkerBase>(
       blob_context_getter_factory_.get(), url_loader_factory_.get(),
       server_endpoint_, std::move(import_completed_callback), key);
+  importers_[hash]->SetProgressCallback(base::BindRepeating(
+      &IpfsService::OnImportProgress, weak_factory_.GetWeakPtr()));
   importers_[hash]->ImportFile(path);
 }
 
@@ -413,6 +419,8 @@ void IpfsService::ImportLinkToIpfs(const GURL& url,
   importers_[hash] = std::make_unique<IpfsLinkImportWorker>(
       blob_context_getter_factory_.get(), url_loader_factory_.get(),
       server_endpoint_, std::move(import_completed_callback), url);
+  importers_[hash]->SetProgressCallback(base::BindRepeating(
+      &IpfsService::OnImportProgress, weak_factory_.GetWeakPtr()));
 }
 
 void IpfsService::ImportDirectoryToIpfs(const base::FilePath& folder,
@@ -440,6 +448,8 @@ void IpfsService::ImportDirectoryToIpfs(const base::FilePath& folder,
   importers_[hash] = std::make_unique<IpfsImportWorkerBase>(
       blob_context_getter_factory_.get(), url_loader_factory_.get(),
       server_endpoint_, std::move(import_completed_callback), key);
+  importers_[hash]->SetProgressCallback(base::BindRepeating(
+      &IpfsService::OnImportProgress, weak_factory_.GetWeakPtr()));
   importers_[hash]->ImportFolder(folder);
 }
 
@@ -479,6 +489,12 @@ void IpfsService::OnImportFinished(ipfs::ImportCompletedCallback callback,
 
   importers_.erase(key);
 }
+
+void IpfsService::OnImportProgress(const std::string& name, int64_t bytes) {
+  for (auto& observer : observers_) {
+    observer.OnImportProgress(name, bytes);
+  }
+}
 #endif
 void IpfsService::GetConnectedPeers(GetConnectedPeersCallback callback,
                                     int retries) {
@@ -553,6 +569,54 @@ void IpfsService::OnGetConnectedPeers(
   }
 }
 
+void IpfsService::GetCachedConnectedPeers(GetConnectedPeersCallback callback) {
+  if (!IsDaemonLaunched()) {
+    std::move(callback).Run(false, std::vector<std::string>{});
+    return;
+  }
+  node_monitor_.GetConnectedPeers(std::move(callback));
+}
+
+void IpfsService::RequestConnectedPeers(GetConnectedPeersCallback callback) {
+  auto url_loader =
+      CreateURLLoader(server_endpoint_.Resolve(kSwarmPeersPath), "POST");
+  auto iter = url_loaders_.insert(url_loaders_.begin(), std::move(url_loader));
+
+  iter->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
+      url_loader_factory_.get(),
+      base::BindOnce(&IpfsService::OnConnectedPeersRequested,
+                     base::Unretained(this), iter, std::move(callback)));
+}
+
+void IpfsService::OnConnectedPeersRequested(
+    SimpleURLLoaderList::iterator iter,
+    GetConnectedPeersCallback callback,
+    std::unique_ptr<std::string> response_body) {
+  auto* url_loader = iter->get();
+  int error_code = url_loader->NetError();
+  int response_code = -1;
+  if (url_loader->ResponseInfo() && url_loader->ResponseInfo()->headers)
+    response_code = url_loader->ResponseInfo()->headers->response_code();
+  url_loaders_.erase(iter);
+
+  std::vector<std::string> peers;
+  if (error_code != net::OK || response_code != net::HTTP_OK) {
+    VLOG(1) << "Fail to get connected peers, error_code = " << error_code
+            << " response_code = " << response_code;
+    std::move(callback).Run(false, peers);
+    return;
+  }
+
+  bool success = IPFSJSONParser::GetPeersFromJSON(*response_body, &peers);
+  std::move(callback).Run(success, peers);
+}
+
+void IpfsService::OnConnectedPeersChanged(
+    const std::vector<std::string>& peers) {
+  for (auto& observer : observers_)
+    observer.OnConnectedPeersChanged(peers);
+}
+
 void IpfsService::GetAddressesConfig(GetAddressesConfigCallback callback) {
   if (!IsDaemonLaunched()) {
     std::move(callback).Run(false, AddressesConfig());
@@ -728,7 +792,10 @@ void IpfsService::GetRepoStats(GetRepoStatsCallback callback) {
     std::move(callback).Run(false, RepoStats());
     return;
   }
+  node_monitor_.GetRepoStats(std::move(callback));
+}
 
+void IpfsService::RequestRepoStats(GetRepoStatsCallback callback) {
   GURL gurl =
       net::AppendQueryParameter(server_endpoint_.Resolve(ipfs::kRepoStatsPath),
                                 ipfs::kRepoStatsHumanReadableParamName,
@@ -765,12 +832,20 @@ void IpfsService::OnRepoStats(SimpleURLLoaderList::iterator iter,
   std::move(callback).Run(success, repo_stats);
 }
 
+void IpfsService::OnRepoStatsChanged(const RepoStats& stats) {
+  for (auto& observer : observers_)
+    observer.OnRepoStatsChanged(stats);
+}
+
 void IpfsService::GetNodeInfo(GetNodeInfoCallback callback) {
   if (!IsDaemonLaunched()) {
     std::move(callback).Run(false, NodeInfo());
     return;
   }
+  node_monitor_.GetNodeInfo(std::move(callback));
+}
 
+void IpfsService::RequestNodeInfo(GetNodeInfoCallback callback) {
   GURL gurl = server_endpoint_.Resolve(ipfs::kNodeInfoPath);
   auto url_loader = CreateURLLoader(gurl, "POST");
   auto iter = url_loaders_.insert(url_loaders_.begin(), std::move(url_loader));
@@ -804,6 +879,11 @@ void IpfsService::OnNodeInfo(SimpleURLLoaderList::iterator iter,
   std::move(callback).Run(success, node_info);
 }
 
+void IpfsService::OnNodeInfoChanged(const NodeInfo& info) {
+  for (auto& observer : observers_)
+    observer.OnNodeInfoChanged(info);
+}
+
 void IpfsService::RunGarbageCollection(GarbageCollectionCallback callback) {
   if (!IsDaemonLaunched()) {
     std::move(callback).Run(false, std::string());
@@ -848,6 +928,9 @@ void IpfsService::OnGarbageCollection(
 }
 
 void IpfsService::PreWarmShareableLink(const GURL& url) {
+  if (prewarmed_links_.Get(url) != prewarmed_links_.end())
+    return;
+  prewarmed_links_.Put(url, true);
   auto url_loader = CreateURLLoader(url, "HEAD");
   auto iter = url_loaders_.insert(url_loaders_.begin(), std::move(url_loader));
   iter->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
@@ -13,6 +13,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
 #include "base/containers/queue.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/observer_list.h"
@@ -22,6 +23,7 @@
 #include "brave/components/ipfs/buildflags/buildflags.h"
 #include "brave/components/ipfs/import/imported_data.h"
 #include "brave/components/ipfs/ipfs_constants.h"
+#include "brave/components/ipfs/ipfs_node_monitor.h"
 #include "brave/components/ipfs/ipfs_p3a.h"
 #include "brave/components/ipfs/node_info.h"
 #include "brave/components/ipfs/repo_stats.h"
@@ -54,7 +56,8 @@ class IpfsImportWorkerBase;
 class IpnsKeysManager;
 #endif
 class IpfsService : public KeyedService,
-                    public BraveIpfsClientUpdater::Observer {
+                    public BraveIpfsClientUpdater::Observer,
+                    public IpfsNodeMonitor::Delegate {
  public:
   IpfsService(PrefService* prefs,
               scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory,
@@ -120,17 +123,22 @@ class IpfsService : public KeyedService,
   void OnImportFinished(ipfs::ImportCompletedCallback callback,
                         size_t key,
                         const ipfs::ImportedData& data);
+  void OnImportProgress(const std::string& name, int64_t bytes);
   void ExportKey(const std::string& key,
                  const base::FilePath& target_path,
                  BoolCallback callback);
 #endif
   void GetConnectedPeers(GetConnectedPeersCallback callback,
                          int retries = kPeersDefaultRetries);
+  // Answers from the node monitor's snapshot instead of asking the daemon,
+  // changes are reported to observers by OnConnectedPeersChanged.
+  void GetCachedConnectedPeers(GetConnectedPeersCallback callback);
   void GetAddressesConfig(GetAddressesConfigCallback callback);
   virtual void LaunchDaemon(BoolCallback callback);
   void ShutdownDaemon(BoolCallback callback);
   void StartDaemonAndLaunch(base::OnceCallback<void(void)> callback);
   void GetConfig(GetConfigCallback);
+  // Both are answered from the node monitor's snapshot when there is one.
   void GetRepoStats(GetRepoStatsCallback callback);
   void GetNodeInfo(GetNodeInfoCallback callback);
   void RunGarbageCollection(GarbageCollectionCallback callback);
@@ -165,6 +173,14 @@ class IpfsService : public KeyedService,
   void OnExecutableReady(const base::FilePath& path) override;
   void OnInstallationEvent(ComponentUpdaterEvents event) override;
 
+  // IpfsNodeMonitor::Delegate
+  void RequestConnectedPeers(GetConnectedPeersCallback callback) override;
+  void RequestRepoStats(GetRepoStatsCallback callback) override;
+  void RequestNodeInfo(GetNodeInfoCallback callback) override;
+  void OnConnectedPeersChanged(const std::vector<std::string>& peers) override;
+  void OnRepoStatsChanged(const RepoStats& stats) override;
+  void OnNodeInfoChanged(const NodeInfo& info) override;
+
   void OnIpfsCrashed();
   void OnIpfsLaunched(bool result, int64_t pid);
   void OnIpfsDaemonCrashed(int64_t pid);
@@ -189,6 +205,9 @@ class IpfsService : public KeyedService,
                            GetConnectedPeersCallback,
                            int retries,
                            std::unique_ptr<std::string> response_body);
+  void OnConnectedPeersRequested(SimpleURLLoaderList::iterator iter,
+                                 GetConnectedPeersCallback callback,
+                                 std::unique_ptr<std::string> response_body);
   void OnGetAddressesConfig(SimpleURLLoaderList::iterator iter,
                             GetAddressesConfigCallback callback,
                             std::unique_ptr<std::string> response_body);
@@ -211,10 +230,14 @@ class IpfsService : public KeyedService,
 
   int64_t ipfs_pid_ = -1;
   base::ObserverList<IpfsServiceObserver> observers_;
+  IpfsNodeMonitor node_monitor_{this};
 
   PrefService* prefs_ = nullptr;
   scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
   SimpleURLLoaderList url_loaders_;
+  // Shareable links that were already pre-warmed, content behind a CID
+  // doesn't change so it only needs to reach the gateway once.
+  base::MRUCache<GURL, bool> prewarmed_links_;
   BlobContextGetterFactoryPtr blob_context_getter_factory_;
 
   base::queue<BoolCallback> pending_launch_callbacks_;
@@ -10,6 +10,8 @@
 #include <vector>
 
 #include "base/observer_list_types.h"
+#include "brave/components/ipfs/node_info.h"
+#include "brave/components/ipfs/repo_stats.h"
 #include "components/component_updater/component_updater_service.h"
 
 namespace ipfs {
@@ -24,7 +26,14 @@ class IpfsServiceObserver : public base::CheckedObserver {
   virtual void OnInstallationEvent(ComponentUpdaterEvents event) {}
   virtual void OnGetConnectedPeers(bool succes,
                                    const std::vector<std::string>& peers) {}
+  // The node monitor's snapshot of the running daemon changed.
+  virtual void OnConnectedPeersChanged(const std::vector<std::string>& peers) {
+  }
+  virtual void OnRepoStatsChanged(const RepoStats& stats) {}
+  virtual void OnNodeInfoChanged(const NodeInfo& info) {}
   virtual void OnIpnsKeysLoaded(bool success) {}
+  // |bytes| of the file |name| have been added by an import in progress.
+  virtual void OnImportProgress(const std::string& name, int64_t bytes) {}
 };
 
 }  // namespace ipfs
@@ -10,4 +10,8 @@ namespace ipfs {
 NodeInfo::NodeInfo() = default;
 NodeInfo::~NodeInfo() = default;
 
+bool NodeInfo::operator==(const NodeInfo& other) const {
+  return id == other.id && version == other.version;
+}
+
 }  // namespace ipfs
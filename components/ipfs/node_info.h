@@ -15,6 +15,8 @@ struct NodeInfo {
   NodeInfo();
   ~NodeInfo();
 
+  bool operator==(const NodeInfo& other) const;
+
   std::string id;
   std::string version;
 };
@@ -10,4 +10,10 @@ namespace ipfs {
 RepoStats::RepoStats() = default;
 RepoStats::~RepoStats() = default;
 
+bool RepoStats::operator==(const RepoStats& other) const {
+  return objects == other.objects && size == other.size &&
+         storage_max == other.storage_max && path == other.path &&
+         version == other.version;
+}
+
 }  // namespace ipfs
@@ -15,6 +15,8 @@ struct RepoStats {
   RepoStats();
   ~RepoStats();
 
+  bool operator==(const RepoStats& other) const;
+
   uint64_t objects = 0;
   uint64_t size = 0;
   uint64_t storage_max = 0;
@@ -0,0 +1,114 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ntp_background_images/browser/image_file_cache.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/task/post_task.h"
+#include "base/task/thread_pool.h"
+
+namespace ntp_background_images {
+
+namespace {
+
+absl::optional<std::string> ReadFileToString(const base::FilePath& path) {
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents))
+    return absl::optional<std::string>();
+  return contents;
+}
+
+}  // namespace
+
+ImageFileCache::ImageFileCache(size_t max_bytes)
+    : max_bytes_(max_bytes),
+      cache_(base::MRUCache<base::FilePath,
+                            scoped_refptr<base::RefCountedMemory>>::
+                 NO_AUTO_EVICT) {}
+
+ImageFileCache::~ImageFileCache() = default;
+
+void ImageFileCache::GetImageFile(const base::FilePath& image_file_path,
+                                  GetImageFileCallback callback) {
+  auto it = cache_.Get(image_file_path);
+  if (it != cache_.end()) {
+    std::move(callback).Run(it->second);
+    return;
+  }
+
+  // A prefetch of the file may already be reading it, with no callbacks yet.
+  auto result = pending_reads_.try_emplace(image_file_path);
+  result.first->second.push_back(std::move(callback));
+  if (result.second)
+    ReadImageFile(image_file_path);
+}
+
+void ImageFileCache::Prefetch(const base::FilePath& image_file_path) {
+  if (image_file_path.empty() ||
+      cache_.Peek(image_file_path) != cache_.end())
+    return;
+
+  if (pending_reads_.try_emplace(image_file_path).second)
+    ReadImageFile(image_file_path);
+}
+
+void ImageFileCache::Clear() {
+  clear_count_++;
+  cache_.Clear();
+  cached_bytes_ = 0;
+}
+
+bool ImageFileCache::IsCachedForTesting(
+    const base::FilePath& image_file_path) const {
+  return cache_.Peek(image_file_path) != cache_.end();
+}
+
+void ImageFileCache::ReadImageFile(const base::FilePath& image_file_path) {
+  file_reads_++;
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&ReadFileToString, image_file_path),
+      base::BindOnce(&ImageFileCache::OnReadImageFile,
+                     weak_factory_.GetWeakPtr(), image_file_path,
+                     clear_count_));
+}
+
+void ImageFileCache::OnReadImageFile(const base::FilePath& image_file_path,
+                                     int clear_count,
+                                     absl::optional<std::string> contents) {
+  scoped_refptr<base::RefCountedMemory> bytes;
+  if (contents) {
+    bytes = base::RefCountedString::TakeString(&contents.value());
+    // Files bigger than the whole cache are served but not kept, and so are
+    // files which were read before the cache was cleared.
+    if (bytes->size() <= max_bytes_ && clear_count == clear_count_) {
+      auto existing = cache_.Peek(image_file_path);
+      if (existing != cache_.end()) {
+        cached_bytes_ -= existing->second->size();
+        cache_.Erase(existing);
+      }
+      cached_bytes_ += bytes->size();
+      cache_.Put(image_file_path, bytes);
+      while (cached_bytes_ > max_bytes_) {
+        auto oldest = cache_.rbegin();
+        cached_bytes_ -= oldest->second->size();
+        cache_.Erase(oldest);
+      }
+    }
+  }
+
+  auto it = pending_reads_.find(image_file_path);
+  if (it == pending_reads_.end())
+    return;
+  auto callbacks = std::move(it->second);
+  pending_reads_.erase(it);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(bytes);
+}
+
+}  // namespace ntp_background_images
@@ -0,0 +1,69 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_IMAGE_FILE_CACHE_H_
+#define BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_IMAGE_FILE_CACHE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/memory/weak_ptr.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace ntp_background_images {
+
+// Keeps the encoded bytes of recently used NTP images in memory, bounded by
+// total size, so that opening new tabs doesn't read the same wallpaper from
+// disk each time. Cached bytes are ref-counted and shared by every request
+// rather than copied. Reads of the same file are coalesced.
+class ImageFileCache {
+ public:
+  using GetImageFileCallback =
+      base::OnceCallback<void(scoped_refptr<base::RefCountedMemory>)>;
+
+  explicit ImageFileCache(size_t max_bytes);
+  ~ImageFileCache();
+
+  ImageFileCache(const ImageFileCache&) = delete;
+  ImageFileCache& operator=(const ImageFileCache&) = delete;
+
+  // Runs |callback| with null bytes if the file can't be read. Runs it
+  // synchronously on a cache hit.
+  void GetImageFile(const base::FilePath& image_file_path,
+                    GetImageFileCallback callback);
+  // Reads |image_file_path| into the cache ahead of it being requested.
+  void Prefetch(const base::FilePath& image_file_path);
+  // Reads which are in flight still answer their callbacks, but no longer
+  // populate the cache.
+  void Clear();
+
+  bool IsCachedForTesting(const base::FilePath& image_file_path) const;
+  int file_reads_for_testing() const { return file_reads_; }
+
+ private:
+  void ReadImageFile(const base::FilePath& image_file_path);
+  void OnReadImageFile(const base::FilePath& image_file_path,
+                       int clear_count,
+                       absl::optional<std::string> contents);
+
+  const size_t max_bytes_;
+  size_t cached_bytes_ = 0;
+  base::MRUCache<base::FilePath, scoped_refptr<base::RefCountedMemory>> cache_;
+  // Callbacks waiting for each in-flight read.
+  std::map<base::FilePath, std::vector<GetImageFileCallback>> pending_reads_;
+  // Incremented by Clear(), so that reads started before it are not cached.
+  int clear_count_ = 0;
+  int file_reads_ = 0;
+  base::WeakPtrFactory<ImageFileCache> weak_factory_{this};
+};
+
+}  // namespace ntp_background_images
+
+#endif  // BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_IMAGE_FILE_CACHE_H_
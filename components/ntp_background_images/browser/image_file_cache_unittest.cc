@@ -0,0 +1,147 @@
+// Copyright (c) 2021 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/ntp_background_images/browser/image_file_cache.h"
+
+#include <string>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ntp_background_images {
+
+class ImageFileCacheTest : public testing::Test {
+ public:
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  base::FilePath WriteImage(const std::string& name,
+                            const std::string& contents) {
+    base::FilePath path = temp_dir_.GetPath().AppendASCII(name);
+    EXPECT_TRUE(base::WriteFile(path, contents));
+    return path;
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_F(ImageFileCacheTest, SharesBytesBetweenRequests) {
+  ImageFileCache cache(1024);
+  const base::FilePath path = WriteImage("wallpaper.jpg", "image");
+
+  scoped_refptr<base::RefCountedMemory> first;
+  scoped_refptr<base::RefCountedMemory> second;
+  cache.GetImageFile(path, base::BindLambdaForTesting(
+                               [&](scoped_refptr<base::RefCountedMemory> b) {
+                                 first = b;
+                               }));
+  cache.GetImageFile(path, base::BindLambdaForTesting(
+                               [&](scoped_refptr<base::RefCountedMemory> b) {
+                                 second = b;
+                               }));
+  task_environment_.RunUntilIdle();
+  ASSERT_TRUE(first);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(std::string(first->front_as<char>(), first->size()), "image");
+
+  // Served from memory even once the file is gone.
+  ASSERT_TRUE(base::DeleteFile(path));
+  scoped_refptr<base::RefCountedMemory> cached;
+  cache.GetImageFile(path, base::BindLambdaForTesting(
+                               [&](scoped_refptr<base::RefCountedMemory> b) {
+                                 cached = b;
+                               }));
+  EXPECT_EQ(cached, first);
+
+  cache.Clear();
+  EXPECT_FALSE(cache.IsCachedForTesting(path));
+}
+
+TEST_F(ImageFileCacheTest, PrefetchAndEviction) {
+  // Room for two of the images below.
+  ImageFileCache cache(10);
+  const base::FilePath path1 = WriteImage("1.jpg", "11111");
+  const base::FilePath path2 = WriteImage("2.jpg", "22222");
+  const base::FilePath path3 = WriteImage("3.jpg", "33333");
+
+  cache.Prefetch(path1);
+  cache.Prefetch(path2);
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(cache.IsCachedForTesting(path1));
+  EXPECT_TRUE(cache.IsCachedForTesting(path2));
+
+  cache.Prefetch(path3);
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(cache.IsCachedForTesting(path1));
+  EXPECT_TRUE(cache.IsCachedForTesting(path2));
+  EXPECT_TRUE(cache.IsCachedForTesting(path3));
+
+  // Missing files are reported as null bytes.
+  bool called = false;
+  cache.GetImageFile(temp_dir_.GetPath().AppendASCII("missing.jpg"),
+                     base::BindLambdaForTesting(
+                         [&](scoped_refptr<base::RefCountedMemory> b) {
+                           EXPECT_FALSE(b);
+                           called = true;
+                         }));
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(called);
+}
+
+TEST_F(ImageFileCacheTest, RequestDuringPrefetch) {
+  ImageFileCache cache(1024);
+  const base::FilePath path = WriteImage("wallpaper.jpg", "image");
+
+  // E.g. the NTP opens while its wallpaper is still being prefetched.
+  cache.Prefetch(path);
+  cache.Prefetch(path);
+  scoped_refptr<base::RefCountedMemory> bytes;
+  cache.GetImageFile(path, base::BindLambdaForTesting(
+                               [&](scoped_refptr<base::RefCountedMemory> b) {
+                                 bytes = b;
+                               }));
+  EXPECT_EQ(cache.file_reads_for_testing(), 1);
+  task_environment_.RunUntilIdle();
+
+  // The request is answered by the prefetch.
+  ASSERT_TRUE(bytes);
+  EXPECT_EQ(std::string(bytes->front_as<char>(), bytes->size()), "image");
+  EXPECT_TRUE(cache.IsCachedForTesting(path));
+  EXPECT_EQ(cache.file_reads_for_testing(), 1);
+}
+
+TEST_F(ImageFileCacheTest, ClearDuringRead) {
+  ImageFileCache cache(1024);
+  const base::FilePath path = WriteImage("wallpaper.jpg", "image");
+
+  scoped_refptr<base::RefCountedMemory> bytes;
+  cache.GetImageFile(path, base::BindLambdaForTesting(
+                               [&](scoped_refptr<base::RefCountedMemory> b) {
+                                 bytes = b;
+                               }));
+  cache.Prefetch(WriteImage("other.jpg", "other"));
+  // E.g. a new component version was installed while reading.
+  cache.Clear();
+  task_environment_.RunUntilIdle();
+
+  // The request is still answered, but nothing read before the clear is
+  // cached.
+  ASSERT_TRUE(bytes);
+  EXPECT_EQ(std::string(bytes->front_as<char>(), bytes->size()), "image");
+  EXPECT_FALSE(cache.IsCachedForTesting(path));
+  EXPECT_FALSE(
+      cache.IsCachedForTesting(temp_dir_.GetPath().AppendASCII("other.jpg")));
+
+  // Reads started after the clear are cached again.
+  cache.Prefetch(path);
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(cache.IsCachedForTesting(path));
+}
+
+}  // namespace ntp_background_images
@@ -41,6 +41,10 @@ namespace ntp_background_images {
 
 namespace {
 
+// Enough for the current and the next few wallpapers, which are typically a
+// few megabytes each.
+constexpr size_t kMaxImageFileCacheBytes = 24 * 1024 * 1024;
+
 constexpr int kSIComponentUpdateCheckIntervalMins = 15;
 constexpr char kNTPManifestFile[] = "photo.json";
 constexpr char kNTPSRMappingTableFile[] = "mapping-table.json";
@@ -102,6 +106,7 @@ NTPBackgroundImagesService::NTPBackgroundImagesService(
     PrefService* local_pref)
     : component_update_service_(cus),
       local_pref_(local_pref),
+      image_file_cache_(kMaxImageFileCacheBytes),
       weak_factory_(this) {
 }
 
@@ -471,6 +476,8 @@ void NTPBackgroundImagesService::OnGetComponentJsonData(
     const std::string& json_string) {
   bi_images_data_.reset(
       new NTPBackgroundImagesData(json_string, bi_installed_dir_));
+  // Images of the previous component version are no longer served.
+  image_file_cache_.Clear();
 
   for (auto& observer : observer_list_) {
     observer.OnUpdated(bi_images_data_.get());
@@ -499,6 +506,7 @@ void NTPBackgroundImagesService::OnSponsoredComponentReady(
 void NTPBackgroundImagesService::OnGetSponsoredComponentJsonData(
     bool is_super_referral,
     const std::string& json_string) {
+  image_file_cache_.Clear();
   if (is_super_referral) {
     local_pref_->SetBoolean(
           prefs::kNewTabPageGetInitialSRComponentInProgress,
@@ -8,7 +8,9 @@
 
 #include <string>
 
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "content/public/browser/url_data_source.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 
@@ -45,8 +47,9 @@ class NTPBackgroundImagesSource : public content::URLDataSource {
 
   void GetImageFile(const base::FilePath& image_file_path,
                     GotDataCallback callback);
-  void OnGotImageFile(GotDataCallback callback,
-                      absl::optional<std::string> input);
+  void OnGotImageFile(base::TimeTicks request_time,
+                      GotDataCallback callback,
+                      scoped_refptr<base::RefCountedMemory> bytes);
   int GetWallpaperIndexFromPath(const std::string& path) const;
 
   NTPBackgroundImagesService* service_;  // not owned
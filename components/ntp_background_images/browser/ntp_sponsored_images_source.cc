@@ -10,11 +10,11 @@
 
 #include "base/bind.h"
 #include "base/files/file_path.h"
-#include "base/files/file_util.h"
 #include "base/memory/ref_counted_memory.h"
+#include "base/metrics/histogram_macros_local.h"
 #include "base/strings/stringprintf.h"
-#include "base/task/post_task.h"
-#include "base/task/thread_pool.h"
+#include "base/time/time.h"
+#include "brave/components/ntp_background_images/browser/image_file_cache.h"
 #include "brave/components/ntp_background_images/browser/ntp_background_images_service.h"
 #include "brave/components/ntp_background_images/browser/ntp_sponsored_images_data.h"
 #include "brave/components/ntp_background_images/browser/url_constants.h"
@@ -25,13 +25,6 @@ namespace ntp_background_images {
 
 namespace {
 
-absl::optional<std::string> ReadFileToString(const base::FilePath& path) {
-  std::string contents;
-  if (!base::ReadFileToString(path, &contents))
-    return absl::optional<std::string>();
-  return contents;
-}
-
 bool IsSuperReferralPath(const std::string& path) {
   return path.rfind(kSuperReferralPath, 0) == 0;
 }
@@ -63,7 +56,7 @@ void NTPSponsoredImagesSource::StartDataRequest(
 
   // Favicon data is fetched from cached folder not from component data.
   if (IsTopSiteFaviconPath(path)) {
-    GetImageFile(GetTopSiteFaviconFilePath(path), std::move(callback));
+    GetImageFile(GetTopSiteFaviconFilePath(path), false, std::move(callback));
     return;
   }
 
@@ -77,7 +70,8 @@ void NTPSponsoredImagesSource::StartDataRequest(
   }
 
   base::FilePath image_file_path;
-  if (IsLogoPath(path)) {
+  const bool is_wallpaper = !IsLogoPath(path);
+  if (!is_wallpaper) {
     if (IsDefaultLogoPath(path)) {
       image_file_path = images_data->default_logo.image_file;
     } else {
@@ -91,28 +85,32 @@ void NTPSponsoredImagesSource::StartDataRequest(
         images_data->backgrounds[GetWallpaperIndexFromPath(path)].image_file;
   }
 
-  GetImageFile(image_file_path, std::move(callback));
+  GetImageFile(image_file_path, is_wallpaper, std::move(callback));
 }
 
 void NTPSponsoredImagesSource::GetImageFile(
     const base::FilePath& image_file_path,
+    bool is_wallpaper,
     GotDataCallback callback) {
-  base::ThreadPool::PostTaskAndReplyWithResult(
-      FROM_HERE, {base::MayBlock()},
-      base::BindOnce(&ReadFileToString, image_file_path),
+  service_->image_file_cache()->GetImageFile(
+      image_file_path,
       base::BindOnce(&NTPSponsoredImagesSource::OnGotImageFile,
-                     weak_factory_.GetWeakPtr(), std::move(callback)));
+                     weak_factory_.GetWeakPtr(), is_wallpaper,
+                     base::TimeTicks::Now(), std::move(callback)));
 }
 
 void NTPSponsoredImagesSource::OnGotImageFile(
+    bool is_wallpaper,
+    base::TimeTicks request_time,
     GotDataCallback callback,
-    absl::optional<std::string> input) {
-  if (!input)
+    scoped_refptr<base::RefCountedMemory> bytes) {
+  if (!bytes)
     return;
 
-  scoped_refptr<base::RefCountedMemory> bytes;
-  bytes = new base::RefCountedBytes(
-      reinterpret_cast<const unsigned char*>(input->c_str()), input->length());
+  if (is_wallpaper) {
+    LOCAL_HISTOGRAM_TIMES("Brave.NTP.SponsoredImageLoadTime",
+                          base::TimeTicks::Now() - request_time);
+  }
   std::move(callback).Run(std::move(bytes));
 }
 
@@ -8,7 +8,9 @@
 
 #include <string>
 
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "content/public/browser/url_data_source.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 
@@ -44,9 +46,12 @@ class NTPSponsoredImagesSource : public content::URLDataSource {
   bool AllowCaching() override;
 
   void GetImageFile(const base::FilePath& image_file_path,
+                    bool is_wallpaper,
                     GotDataCallback callback);
-  void OnGotImageFile(GotDataCallback callback,
-                      absl::optional<std::string> input);
+  void OnGotImageFile(bool is_wallpaper,
+                      base::TimeTicks request_time,
+                      GotDataCallback callback,
+                      scoped_refptr<base::RefCountedMemory> bytes);
   bool IsValidPath(const std::string& path) const;
   bool IsLogoPath(const std::string& path) const;
   bool IsDefaultLogoPath(const std::string& path) const;
@@ -99,6 +99,7 @@ ViewCounterService::ViewCounterService(NTPBackgroundImagesService* service,
 
   OnUpdated(GetCurrentBrandedWallpaperData());
   OnUpdated(GetCurrentWallpaperData());
+  PrefetchNextWallpaper();
 }
 
 ViewCounterService::~ViewCounterService() = default;
@@ -257,6 +258,25 @@ void ViewCounterService::RegisterPageView() {
   // This will be no-op when component is not ready.
   service_->CheckNTPSIComponentUpdateIfNeeded();
   model_.RegisterPageView();
+  PrefetchNextWallpaper();
+}
+
+void ViewCounterService::PrefetchNextWallpaper() {
+  // |model_| already points at the wallpaper for the next new tab, so the
+  // page doesn't have to wait for the file to be read.
+  base::FilePath image_file;
+  if (ShouldShowBrandedWallpaper()) {
+    auto* data = GetCurrentBrandedWallpaperData();
+    const size_t index = model_.current_branded_wallpaper_image_index();
+    if (index < data->backgrounds.size())
+      image_file = data->backgrounds[index].image_file;
+  } else if (IsBackgroundWallpaperActive()) {
+    auto* data = GetCurrentWallpaperData();
+    const size_t index = model_.current_wallpaper_image_index();
+    if (index < data->backgrounds.size())
+      image_file = data->backgrounds[index].image_file;
+  }
+  service_->image_file_cache()->Prefetch(image_file);
 }
 
 void ViewCounterService::BrandedWallpaperLogoClicked(
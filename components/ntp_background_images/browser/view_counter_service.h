@@ -133,6 +133,8 @@ class ViewCounterService : public KeyedService,
   bool ShouldShowBrandedWallpaper() const;
 
   void ResetModel();
+  // Reads the image of the wallpaper the next new tab will show into memory.
+  void PrefetchNextWallpaper();
 
   void UpdateP3AValues() const;
 
@@ -5,6 +5,7 @@
 
 #include "brave/components/p3a/brave_p3a_log_store.h"
 
+#include "base/bind.h"
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/rand_util.h"
@@ -51,6 +52,13 @@ void BraveP3ALogStore::RegisterPrefs(PrefRegistrySimple* registry) {
 
 void BraveP3ALogStore::UpdateValue(const std::string& histogram_name,
                                    uint64_t value) {
+  updates_since_last_write_++;
+  auto iter = log_.find(histogram_name);
+  if (iter != log_.end() && iter->second.value == value) {
+    // Already stored, most metrics keep reporting the same answer.
+    return;
+  }
+
   LogEntry& entry = log_[histogram_name];
   entry.value = value;
   if (!entry.sent) {
@@ -58,21 +66,52 @@ void BraveP3ALogStore::UpdateValue(const std::string& histogram_name,
     unsent_entries_.insert(histogram_name);
   }
 
-  // Update the persistent value.
+  // The persistent value is updated with the next batch.
+  pending_values_.insert(histogram_name);
+  if (!persist_timer_.IsRunning()) {
+    persist_timer_.Start(FROM_HERE, kPersistDelay,
+                         base::BindOnce(&BraveP3ALogStore::PersistValues,
+                                        base::Unretained(this)));
+  }
+}
+
+void BraveP3ALogStore::PersistValues() {
+  if (pending_values_.empty())
+    return;
   DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({histogram_name, kLogValueKey},
-                  base::Value(base::NumberToString(value)));
-  update->SetPath({histogram_name, kLogSentKey}, base::Value(entry.sent));
+  WritePendingValues(update.Get());
+}
+
+void BraveP3ALogStore::WritePendingValues(base::Value* update) {
+  persist_timer_.Stop();
+  if (pending_values_.empty())
+    return;
+
+  for (const std::string& histogram_name : pending_values_) {
+    auto iter = log_.find(histogram_name);
+    if (iter == log_.end())
+      continue;
+    update->SetPath({histogram_name, kLogValueKey},
+                    base::Value(base::NumberToString(iter->second.value)));
+    update->SetPath({histogram_name, kLogSentKey},
+                    base::Value(iter->second.sent));
+  }
+  UMA_HISTOGRAM_COUNTS_1000("Brave.P3A.LogStore.UpdatesPerWrite",
+                            updates_since_last_write_);
+  pending_values_.clear();
+  updates_since_last_write_ = 0;
 }
 
 void BraveP3ALogStore::RemoveValueIfExists(const std::string& histogram_name) {
   DCHECK(delegate_->IsActualMetric(histogram_name));
   log_.erase(histogram_name);
   unsent_entries_.erase(histogram_name);
+  pending_values_.erase(histogram_name);
 
   // Update the persistent value.
   DictionaryPrefUpdate update(local_state_, kPrefName);
   update->RemovePath(histogram_name);
+  WritePendingValues(update.Get());
 
   if (has_staged_log() && staged_entry_key_ == histogram_name) {
     staged_entry_key_.clear();
@@ -83,6 +122,7 @@ void BraveP3ALogStore::RemoveValueIfExists(const std::string& histogram_name) {
 void BraveP3ALogStore::ResetUploadStamps() {
   // Clear log entries flags.
   DictionaryPrefUpdate update(local_state_, kPrefName);
+  WritePendingValues(update.Get());
   for (auto& pair : log_) {
     if (pair.second.sent) {
       DCHECK(!pair.second.sent_timestamp.is_null());
@@ -174,6 +214,7 @@ void BraveP3ALogStore::DiscardStagedLog() {
 
   // Update the persistent value.
   DictionaryPrefUpdate update(local_state_, kPrefName);
+  WritePendingValues(update.Get());
   update->SetPath({log_iter->first, kLogSentKey},
                   base::Value(log_iter->second.sent));
   update->SetPath({log_iter->first, kLogTimestampKey},
@@ -12,15 +12,23 @@
 #include "base/containers/flat_set.h"
 #include "base/strings/string_piece.h"
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "components/metrics/log_store.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 
 class PrefService;
 class PrefRegistrySimple;
 
+namespace base {
+class Value;
+}  // namespace base
+
 namespace brave {
 
-// Stores all given values in memory and persists in prefs on the fly.
+// Stores all given values in memory and persists them in prefs. New values are
+// folded in memory and written in batches at most every |kPersistDelay|,
+// values that didn't change aren't written at all. Sent state changes are
+// written right away along with any pending values.
 // All logs (not only unsent are persistent), and all logs could be loaded
 // using |LoadPersistedUnsentLogs()|. We should fix this at some point since
 // for now persisted entries never expire.
@@ -41,6 +49,9 @@ class BraveP3ALogStore : public metrics::LogStore {
 
   ~BraveP3ALogStore() override;
 
+  static constexpr base::TimeDelta kPersistDelay =
+      base::TimeDelta::FromSeconds(30);
+
   static void RegisterPrefs(PrefRegistrySimple* registry);
 
   void UpdateValue(const std::string& histogram_name, uint64_t value);
@@ -67,6 +78,9 @@ class BraveP3ALogStore : public metrics::LogStore {
   // Returns early if founds malformed persisted values.
   void LoadPersistedUnsentLogs() override;
 
+  // Writes the values that are waiting for the next batch.
+  void PersistValues();
+
  private:
   struct LogEntry {
     LogEntry() {}
@@ -85,6 +99,9 @@ class BraveP3ALogStore : public metrics::LogStore {
     base::Time sent_timestamp;  // At the moment only for debugging purposes.
   };
 
+  // Writes the values that are waiting for the next batch into |update|.
+  void WritePendingValues(base::Value* update);
+
   Delegate* const delegate_ = nullptr;  // Weak.
   PrefService* const local_state_ = nullptr;
 
@@ -92,6 +109,12 @@ class BraveP3ALogStore : public metrics::LogStore {
   base::flat_map<std::string, LogEntry> log_;
   base::flat_set<std::string> unsent_entries_;
 
+  // Values that changed since they were last persisted.
+  base::flat_set<std::string> pending_values_;
+  // Number of value updates since the last write, including unchanged ones.
+  size_t updates_since_last_write_ = 0;
+  base::OneShotTimer persist_timer_;
+
   std::string staged_entry_key_;
   std::string staged_log_;
 
@@ -0,0 +1,95 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/p3a/brave_p3a_log_store.h"
+
+#include <memory>
+#include <string>
+
+#include "base/strings/strcat.h"
+#include "base/test/task_environment.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BraveP3ALogStoreTest.*
+
+namespace brave {
+
+namespace {
+
+constexpr char kPrefName[] = "p3a.logs";
+constexpr char kHistogramName[] = "Brave.Test.Histogram";
+
+class TestDelegate : public BraveP3ALogStore::Delegate {
+ public:
+  std::string Serialize(base::StringPiece histogram_name,
+                        uint64_t value) override {
+    return base::StrCat({histogram_name, ":", std::to_string(value)});
+  }
+  bool IsActualMetric(base::StringPiece histogram_name) const override {
+    return true;
+  }
+};
+
+}  // namespace
+
+class BraveP3ALogStoreTest : public testing::Test {
+ public:
+  BraveP3ALogStoreTest() {
+    BraveP3ALogStore::RegisterPrefs(local_state_.registry());
+    log_store_ = std::make_unique<BraveP3ALogStore>(&delegate_, &local_state_);
+    log_store_->LoadPersistedUnsentLogs();
+  }
+
+  const base::Value* GetPersistedEntry() {
+    return local_state_.GetDictionary(kPrefName)->FindDictKey(kHistogramName);
+  }
+
+  const std::string* GetPersistedValue() {
+    const base::Value* entry = GetPersistedEntry();
+    return entry ? entry->FindStringKey("value") : nullptr;
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  TestingPrefServiceSimple local_state_;
+  TestDelegate delegate_;
+  std::unique_ptr<BraveP3ALogStore> log_store_;
+};
+
+TEST_F(BraveP3ALogStoreTest, BatchesValueUpdates) {
+  log_store_->UpdateValue(kHistogramName, 1);
+  log_store_->UpdateValue(kHistogramName, 2);
+  log_store_->UpdateValue(kHistogramName, 2);
+  EXPECT_TRUE(log_store_->has_unsent_logs());
+  EXPECT_FALSE(GetPersistedValue());
+
+  task_environment_.FastForwardBy(BraveP3ALogStore::kPersistDelay);
+  ASSERT_TRUE(GetPersistedValue());
+  EXPECT_EQ(*GetPersistedValue(), "2");
+
+  log_store_->UpdateValue(kHistogramName, 3);
+  log_store_->PersistValues();
+  EXPECT_EQ(*GetPersistedValue(), "3");
+}
+
+TEST_F(BraveP3ALogStoreTest, SentStateIsPersistedRightAway) {
+  log_store_->UpdateValue(kHistogramName, 1);
+  log_store_->StageNextLog();
+  EXPECT_EQ(log_store_->staged_log(), "Brave.Test.Histogram:1");
+  log_store_->DiscardStagedLog();
+  EXPECT_FALSE(log_store_->has_unsent_logs());
+
+  ASSERT_TRUE(GetPersistedValue());
+  EXPECT_EQ(*GetPersistedValue(), "1");
+  EXPECT_EQ(GetPersistedEntry()->FindBoolKey("sent"), true);
+
+  // An unchanged value keeps the sent state.
+  log_store_->UpdateValue(kHistogramName, 1);
+  EXPECT_FALSE(log_store_->has_unsent_logs());
+}
+
+}  // namespace brave
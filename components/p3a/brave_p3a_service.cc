@@ -420,6 +420,8 @@ void BraveP3AService::OnHistogramChanged(const char* histogram_name,
   // Shortcut for the special values, see |kSuspendedMetricValue|
   // description for details.
   if (IsSuspendedMetric(histogram_name, sample)) {
+    if (IsSameAsLastBucket(histogram_name, kSuspendedMetricBucket))
+      return;
     base::PostTask(FROM_HERE, {content::BrowserThread::UI},
                    base::BindOnce(&BraveP3AService::OnHistogramChangedOnUI,
                                   this,
@@ -438,6 +440,10 @@ void BraveP3AService::OnHistogramChanged(const char* histogram_name,
     return;
   }
 
+  // Most metrics keep reporting the same answer, there is nothing to update.
+  if (IsSameAsLastBucket(histogram_name, bucket))
+    return;
+
   // Special handling of P2A histograms.
   if (base::StartsWith(histogram_name, "Brave.P2A.",
                        base::CompareCase::SENSITIVE)) {
@@ -459,6 +465,16 @@ void BraveP3AService::OnHistogramChanged(const char* histogram_name,
                                 histogram_name, sample, bucket));
 }
 
+bool BraveP3AService::IsSameAsLastBucket(const char* histogram_name,
+                                         size_t bucket) {
+  base::AutoLock lock(last_buckets_lock_);
+  auto iter = last_buckets_.find(histogram_name);
+  if (iter != last_buckets_.end() && iter->second == bucket)
+    return true;
+  last_buckets_[histogram_name] = bucket;
+  return false;
+}
+
 void BraveP3AService::OnHistogramChangedOnUI(const char* histogram_name,
                                              base::HistogramBase::Sample sample,
                                              size_t bucket) {
@@ -481,6 +497,11 @@ void BraveP3AService::HandleHistogramChange(base::StringPiece histogram_name,
   log_store_->UpdateValue(std::string(histogram_name), bucket);
 }
 
+void BraveP3AService::PersistLogs() {
+  if (log_store_)
+    log_store_->PersistValues();
+}
+
 void BraveP3AService::OnLogUploadComplete(int response_code,
                                           int error_code,
                                           bool was_https) {
@@ -14,6 +14,7 @@
 #include "base/memory/ref_counted.h"
 #include "base/metrics/histogram_base.h"
 #include "base/metrics/statistics_recorder.h"
+#include "base/synchronization/lock.h"
 #include "base/timer/timer.h"
 #include "brave/components/p3a/brave_p3a_log_store.h"
 #include "brave/components/p3a/p3a_message.h"
@@ -51,6 +52,9 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   void Init(
       scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
 
+  // Writes the values that the log store keeps in memory to local state.
+  void PersistLogs();
+
   // BraveP3ALogStore::Delegate
   std::string Serialize(base::StringPiece histogram_name,
                         uint64_t value) override;
@@ -77,6 +81,10 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
                           uint64_t name_hash,
                           base::HistogramBase::Sample sample);
 
+  // Returns true if |bucket| is the last one posted for the histogram, the log
+  // already has it then.
+  bool IsSameAsLastBucket(const char* histogram_name, size_t bucket);
+
   void OnHistogramChangedOnUI(const char* histogram_name,
                               base::HistogramBase::Sample sample,
                               size_t bucket);
@@ -116,6 +124,10 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   // the service and its initialization.
   base::flat_map<base::StringPiece, size_t> histogram_values_;
 
+  // Last bucket posted to the UI thread for each histogram.
+  base::Lock last_buckets_lock_;
+  base::flat_map<base::StringPiece, size_t> last_buckets_;
+
   // Once fired we restart the overall uploading process.
   base::OneShotTimer rotation_timer_;
 
@@ -0,0 +1,131 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/tor/tor_circuit_pool.h"
+
+#include <vector>
+
+#include "base/bind.h"
+#include "base/check.h"
+#include "base/logging.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_split.h"
+
+namespace tor {
+
+namespace {
+
+constexpr char kCircuitStatusBuilt[] = "BUILT";
+constexpr char kCircuitStatusFailed[] = "FAILED";
+constexpr char kCircuitStatusClosed[] = "CLOSED";
+
+// Splits the first |count| space separated fields off |initial|.
+std::vector<base::StringPiece> GetFields(const std::string& initial,
+                                         size_t count) {
+  std::vector<base::StringPiece> fields = base::SplitStringPiece(
+      initial, " ", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  if (fields.size() < count)
+    return {};
+  fields.resize(count);
+  return fields;
+}
+
+}  // namespace
+
+TorCircuitPool::TorCircuitPool(Delegate* delegate) : delegate_(delegate) {
+  DCHECK(delegate);
+}
+
+TorCircuitPool::~TorCircuitPool() = default;
+
+void TorCircuitPool::Start() {
+  if (running_)
+    return;
+  running_ = true;
+  MaybeBuildCircuits();
+}
+
+void TorCircuitPool::Stop() {
+  weak_factory_.InvalidateWeakPtrs();
+  retry_timer_.Stop();
+  running_ = false;
+  requests_in_flight_ = 0;
+  pending_circuits_.clear();
+  clean_circuits_.clear();
+}
+
+// CIRC events start with `CircuitID SP CircStatus'.
+void TorCircuitPool::OnCircuitEvent(const std::string& initial) {
+  const std::vector<base::StringPiece> fields = GetFields(initial, 2);
+  if (fields.empty())
+    return;
+  const std::string circuit_id(fields[0]);
+  const base::StringPiece status = fields[1];
+
+  if (status == kCircuitStatusBuilt) {
+    if (pending_circuits_.erase(circuit_id))
+      clean_circuits_.insert(circuit_id);
+    return;
+  }
+
+  if (status == kCircuitStatusFailed || status == kCircuitStatusClosed) {
+    const bool was_pending = pending_circuits_.erase(circuit_id);
+    const bool was_clean = clean_circuits_.erase(circuit_id);
+    if (status == kCircuitStatusFailed && was_pending) {
+      RetryLater();
+    } else if (was_pending || was_clean) {
+      // Tor closes circuits that stayed unused for too long.
+      MaybeBuildCircuits();
+    }
+  }
+}
+
+// STREAM events start with `StreamID SP StreamStatus SP CircuitID', where
+// CircuitID is 0 while the stream isn't attached to a circuit.
+void TorCircuitPool::OnStreamEvent(const std::string& initial) {
+  const std::vector<base::StringPiece> fields = GetFields(initial, 3);
+  if (fields.empty())
+    return;
+  if (clean_circuits_.erase(std::string(fields[2]))) {
+    VLOG(2) << "tor: pre-built circuit " << fields[2] << " taken";
+    MaybeBuildCircuits();
+  }
+}
+
+void TorCircuitPool::MaybeBuildCircuits() {
+  if (!running_ || retry_timer_.IsRunning())
+    return;
+  while (clean_circuits_.size() + pending_circuits_.size() +
+             requests_in_flight_ <
+         kPoolSize) {
+    requests_in_flight_++;
+    delegate_->BuildCircuit(
+        base::BindOnce(&TorCircuitPool::OnCircuitBuildRequested,
+                       weak_factory_.GetWeakPtr()));
+  }
+}
+
+void TorCircuitPool::OnCircuitBuildRequested(bool error,
+                                             const std::string& circuit_id) {
+  DCHECK_GT(requests_in_flight_, 0u);
+  requests_in_flight_--;
+  if (error || circuit_id.empty()) {
+    VLOG(1) << "tor: failed to build circuit";
+    RetryLater();
+    return;
+  }
+  // Wait for the CIRC event saying that it is built.
+  pending_circuits_.insert(circuit_id);
+}
+
+void TorCircuitPool::RetryLater() {
+  if (retry_timer_.IsRunning())
+    return;
+  retry_timer_.Start(FROM_HERE, kRetryDelay,
+                     base::BindOnce(&TorCircuitPool::MaybeBuildCircuits,
+                                    weak_factory_.GetWeakPtr()));
+}
+
+}  // namespace tor
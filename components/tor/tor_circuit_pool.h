@@ -0,0 +1,82 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_TOR_TOR_CIRCUIT_POOL_H_
+#define BRAVE_COMPONENTS_TOR_TOR_CIRCUIT_POOL_H_
+
+#include <string>
+
+#include "base/callback.h"
+#include "base/containers/flat_set.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+
+namespace tor {
+
+// Keeps a few clean general purpose circuits built ahead of time. Tor gives
+// the first stream of a new SOCKS isolation key, i.e. of a new first-party
+// site, a clean circuit if one is open instead of building one on demand, so
+// the pool saves new sites the circuit build time. Once a stream is attached
+// to one of the circuits it belongs to that site and is replaced in the pool.
+//
+// The pool learns about circuits and streams through the CIRC and STREAM
+// control events, which the owner must be subscribed to and forward.
+class TorCircuitPool {
+ public:
+  using BuildCircuitCallback =
+      base::OnceCallback<void(bool error, const std::string& circuit_id)>;
+
+  class Delegate {
+   public:
+    virtual ~Delegate() = default;
+
+    // Ask Tor to build a new general purpose circuit.
+    virtual void BuildCircuit(BuildCircuitCallback callback) = 0;
+  };
+
+  static constexpr size_t kPoolSize = 3;
+  // How long to wait before building again after a circuit failed.
+  static constexpr base::TimeDelta kRetryDelay =
+      base::TimeDelta::FromSeconds(30);
+
+  explicit TorCircuitPool(Delegate* delegate);
+  ~TorCircuitPool();
+
+  TorCircuitPool(const TorCircuitPool&) = delete;
+  TorCircuitPool& operator=(const TorCircuitPool&) = delete;
+
+  // Starts filling the pool, once Tor has established a circuit.
+  void Start();
+  // Forgets all circuits, for when the control connection goes away.
+  void Stop();
+
+  // |initial| is the first line of a CIRC or STREAM event, after the event
+  // name.
+  void OnCircuitEvent(const std::string& initial);
+  void OnStreamEvent(const std::string& initial);
+
+  size_t clean_circuit_count() const { return clean_circuits_.size(); }
+
+ private:
+  void MaybeBuildCircuits();
+  void OnCircuitBuildRequested(bool error, const std::string& circuit_id);
+  void RetryLater();
+
+  Delegate* delegate_;  // NOT OWNED
+  bool running_ = false;
+  size_t requests_in_flight_ = 0;
+  // Circuits we asked for that aren't built yet.
+  base::flat_set<std::string> pending_circuits_;
+  // Built circuits that no stream has used yet.
+  base::flat_set<std::string> clean_circuits_;
+  base::OneShotTimer retry_timer_;
+
+  base::WeakPtrFactory<TorCircuitPool> weak_factory_{this};
+};
+
+}  // namespace tor
+
+#endif  // BRAVE_COMPONENTS_TOR_TOR_CIRCUIT_POOL_H_
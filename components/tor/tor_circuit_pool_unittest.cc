@@ -0,0 +1,128 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/tor/tor_circuit_pool.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace tor {
+
+// Stands in for the Tor control connection: hands out increasing circuit ids
+// and lets the test play back the CIRC and STREAM events Tor would send.
+class TorCircuitPoolTest : public testing::Test,
+                           public TorCircuitPool::Delegate {
+ public:
+  TorCircuitPoolTest() : pool_(this) {}
+
+  // TorCircuitPool::Delegate
+  void BuildCircuit(TorCircuitPool::BuildCircuitCallback callback) override {
+    build_callbacks_.push_back(std::move(callback));
+  }
+
+  // Answers the pending build requests and returns the new circuit ids.
+  std::vector<std::string> LaunchCircuits() {
+    std::vector<std::string> circuit_ids;
+    auto callbacks = std::move(build_callbacks_);
+    for (auto& callback : callbacks) {
+      circuit_ids.push_back(base::NumberToString(++last_circuit_id_));
+      std::move(callback).Run(false, circuit_ids.back());
+    }
+    return circuit_ids;
+  }
+
+  void FailBuildRequests() {
+    auto callbacks = std::move(build_callbacks_);
+    for (auto& callback : callbacks)
+      std::move(callback).Run(true, "");
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  std::vector<TorCircuitPool::BuildCircuitCallback> build_callbacks_;
+  int last_circuit_id_ = 0;
+  TorCircuitPool pool_;
+};
+
+TEST_F(TorCircuitPoolTest, FillsPool) {
+  pool_.Start();
+  EXPECT_EQ(build_callbacks_.size(), TorCircuitPool::kPoolSize);
+
+  const std::vector<std::string> circuit_ids = LaunchCircuits();
+  EXPECT_EQ(pool_.clean_circuit_count(), 0u);
+  for (const auto& circuit_id : circuit_ids)
+    pool_.OnCircuitEvent(circuit_id + " BUILT $ABCD~relay PURPOSE=GENERAL");
+  EXPECT_EQ(pool_.clean_circuit_count(), TorCircuitPool::kPoolSize);
+  // Circuits Tor built by itself are left alone.
+  pool_.OnCircuitEvent("100 BUILT $ABCD~relay PURPOSE=GENERAL");
+  EXPECT_EQ(pool_.clean_circuit_count(), TorCircuitPool::kPoolSize);
+  EXPECT_TRUE(build_callbacks_.empty());
+}
+
+TEST_F(TorCircuitPoolTest, ReplacesUsedCircuits) {
+  pool_.Start();
+  const std::vector<std::string> circuit_ids = LaunchCircuits();
+  for (const auto& circuit_id : circuit_ids)
+    pool_.OnCircuitEvent(circuit_id + " BUILT");
+
+  // An unattached stream doesn't use up a circuit.
+  pool_.OnStreamEvent("7 NEW 0 example.com:443 SOURCE_ADDR=127.0.0.1:1234");
+  EXPECT_TRUE(build_callbacks_.empty());
+
+  // The first stream of a new site takes a clean circuit, which is replaced.
+  pool_.OnStreamEvent("7 SENTCONNECT " + circuit_ids[0] + " example.com:443");
+  EXPECT_EQ(pool_.clean_circuit_count(), TorCircuitPool::kPoolSize - 1);
+  EXPECT_EQ(build_callbacks_.size(), 1u);
+  // Later streams of that site on the same circuit change nothing.
+  pool_.OnStreamEvent("7 SUCCEEDED " + circuit_ids[0] + " example.com:443");
+  EXPECT_EQ(build_callbacks_.size(), 1u);
+
+  pool_.OnCircuitEvent(LaunchCircuits()[0] + " BUILT");
+  EXPECT_EQ(pool_.clean_circuit_count(), TorCircuitPool::kPoolSize);
+
+  // Clean circuits closed by Tor are replaced too.
+  pool_.OnCircuitEvent(circuit_ids[1] + " CLOSED REASON=FINISHED");
+  EXPECT_EQ(pool_.clean_circuit_count(), TorCircuitPool::kPoolSize - 1);
+  EXPECT_EQ(build_callbacks_.size(), 1u);
+}
+
+TEST_F(TorCircuitPoolTest, RetriesAfterFailure) {
+  pool_.Start();
+  FailBuildRequests();
+  EXPECT_TRUE(build_callbacks_.empty());
+
+  task_environment_.FastForwardBy(TorCircuitPool::kRetryDelay);
+  EXPECT_EQ(build_callbacks_.size(), TorCircuitPool::kPoolSize);
+
+  const std::vector<std::string> circuit_ids = LaunchCircuits();
+  pool_.OnCircuitEvent(circuit_ids[0] + " FAILED REASON=TIMEOUT");
+  EXPECT_TRUE(build_callbacks_.empty());
+  task_environment_.FastForwardBy(TorCircuitPool::kRetryDelay);
+  EXPECT_EQ(build_callbacks_.size(), 1u);
+}
+
+TEST_F(TorCircuitPoolTest, StopForgetsCircuits) {
+  pool_.Start();
+  const std::vector<std::string> circuit_ids = LaunchCircuits();
+  pool_.OnCircuitEvent(circuit_ids[0] + " BUILT");
+  EXPECT_EQ(pool_.clean_circuit_count(), 1u);
+
+  pool_.Stop();
+  EXPECT_EQ(pool_.clean_circuit_count(), 0u);
+  pool_.OnCircuitEvent(circuit_ids[1] + " BUILT");
+  EXPECT_EQ(pool_.clean_circuit_count(), 0u);
+  EXPECT_TRUE(build_callbacks_.empty());
+
+  pool_.Start();
+  EXPECT_EQ(build_callbacks_.size(), TorCircuitPool::kPoolSize);
+}
+
+}  // namespace tor
@@ -5,6 +5,9 @@
 
 #include "brave/components/tor/tor_control.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "base/callback_helpers.h"
 #include "base/sequenced_task_runner.h"
 #include "base/strings/string_number_conversions.h"
@@ -35,7 +38,9 @@ const net::NetworkTrafficAnnotationTag tor_control_traffic_annotation =
     }
   )");
 
-const size_t kTorBufferSize = 4096;
+const int kTorBufferSize = 4096;
+// Lines longer than this are rejected.
+const int kTorMaxBufferSize = 64 * 1024;
 
 constexpr char kGetVersionCmd[] = "GETINFO version";
 constexpr char kGetVersionReply[] = "version=";
@@ -44,6 +49,8 @@ constexpr char kGetSOCKSListenersReply[] = "net/listeners/socks=";
 constexpr char kGetCircuitEstablishedCmd[] =
     "GETINFO status/circuit-established";
 constexpr char kGetCircuitEstablishedReply[] = "status/circuit-established=";
+constexpr char kExtendCircuitCmd[] = "EXTENDCIRCUIT 0";
+constexpr char kExtendCircuitReply[] = "EXTENDED ";
 
 static std::string escapify(const char* buf, int len) {
   std::ostringstream s;
@@ -190,8 +197,8 @@ void TorControl::Connected(std::vector<uint8_t> cookie, int rv) {
 //      we're ready.
 //
 void TorControl::Authenticated(bool error,
-                               const std::string& status,
-                               const std::string& reply) {
+                               base::StringPiece status,
+                               base::StringPiece reply) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   if (!error) {
     if (status != "250" || reply != "OK")
@@ -248,8 +255,8 @@ void TorControl::DoSubscribe(TorControlEvent event,
 void TorControl::Subscribed(TorControlEvent event,
                             base::OnceCallback<void(bool error)> callback,
                             bool error,
-                            const std::string& status,
-                            const std::string& reply) {
+                            base::StringPiece status,
+                            base::StringPiece reply) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   if (!error) {
     if (status != "250")
@@ -303,8 +310,8 @@ void TorControl::DoUnsubscribe(TorControlEvent event,
 void TorControl::Unsubscribed(TorControlEvent event,
                               base::OnceCallback<void(bool error)> callback,
                               bool error,
-                              const std::string& status,
-                              const std::string& reply) {
+                              base::StringPiece status,
+                              base::StringPiece reply) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   DCHECK_EQ(async_events_.count(event), 0u);
   if (!error) {
@@ -345,14 +352,17 @@ void TorControl::DoCmd(std::string cmd,
                        CmdCallback callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   NotifyTorRawCmd(cmd);
-  if (!socket_ || writeq_.size() > 100 || cmdq_.size() > 100) {
+  if (!socket_ || cmdq_.size() > 100) {
     // Socket is closed, or over 100 commands pending or synchronous
     // callbacks queued -- something is probably wrong.
     bool error = true;
     std::move(callback).Run(error, "", "");
     return;
   }
-  writeq_.push(cmd + "\r\n");
+  // Don't wait for earlier commands to be answered: replies come back
+  // in the order the commands were sent, so cmdq_ matches them up.
+  writeq_.append(cmd);
+  writeq_.append("\r\n");
   cmdq_.push(std::make_pair(std::move(perline), std::move(callback)));
   if (!writing_) {
     writing_ = true;
@@ -387,8 +397,8 @@ void TorControl::GetVersion(
 }
 
 void TorControl::GetVersionLine(std::string* version,
-                                const std::string& status,
-                                const std::string& reply) {
+                                base::StringPiece status,
+                                base::StringPiece reply) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   if (status != "250" ||
       !base::StartsWith(reply, kGetVersionReply,
@@ -397,15 +407,15 @@ void TorControl::GetVersionLine(std::string* version,
     VLOG(0) << "tor: unexpected " << kGetVersionCmd << " reply";
     return;
   }
-  *version = reply.substr(strlen(kGetVersionReply));
+  *version = std::string(reply.substr(strlen(kGetVersionReply)));
 }
 
 void TorControl::GetVersionDone(
     std::unique_ptr<std::string> version,
     base::OnceCallback<void(bool error, const std::string& version)> callback,
     bool error,
-    const std::string& status,
-    const std::string& reply) {
+    base::StringPiece status,
+    base::StringPiece reply) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   if (error || status != "250" || reply != "OK" || version->empty()) {
     std::move(callback).Run(true, "");
@@ -434,15 +444,15 @@ void TorControl::GetSOCKSListeners(
 }
 
 void TorControl::GetSOCKSListenersLine(std::vector<std::string>* listeners,
-                                       const std::string& status,
-                                       const std::string& reply) {
+                                       base::StringPiece status,
+                                       base::StringPiece reply) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   if (status != "250" || !base::StartsWith(reply, kGetSOCKSListenersReply,
                                            base::CompareCase::SENSITIVE)) {
     VLOG(0) << "tor: unexpected " << kGetSOCKSListenersCmd << " reply";
     return;
   }
-  listeners->push_back(reply.substr(strlen(kGetSOCKSListenersReply)));
+  listeners->emplace_back(reply.substr(strlen(kGetSOCKSListenersReply)));
 }
 
 void TorControl::GetSOCKSListenersDone(
@@ -450,8 +460,8 @@ void TorControl::GetSOCKSListenersDone(
     base::OnceCallback<
         void(bool error, const std::vector<std::string>& listeners)> callback,
     bool error,
-    const std::string& status,
-    const std::string& reply) {
+    base::StringPiece status,
+    base::StringPiece reply) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   if (error || status != "250" || reply != "OK" || listeners->empty()) {
     std::move(callback).Run(true, std::vector<std::string>());
@@ -478,8 +488,8 @@ void TorControl::GetCircuitEstablished(
 }
 
 void TorControl::GetCircuitEstablishedLine(std::string* established,
-                                           const std::string& status,
-                                           const std::string& reply) {
+                                           base::StringPiece status,
+                                           base::StringPiece reply) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   if (status != "250" ||
       !base::StartsWith(reply, kGetCircuitEstablishedReply,
@@ -488,15 +498,16 @@ void TorControl::GetCircuitEstablishedLine(std::string* established,
     VLOG(0) << "tor: unexpected " << kGetCircuitEstablishedCmd << " reply";
     return;
   }
-  *established = reply.substr(strlen(kGetCircuitEstablishedReply));
+  *established =
+      std::string(reply.substr(strlen(kGetCircuitEstablishedReply)));
 }
 
 void TorControl::GetCircuitEstablishedDone(
     std::unique_ptr<std::string> established,
     base::OnceCallback<void(bool error, bool established)> callback,
     bool error,
-    const std::string& status,
-    const std::string& reply) {
+    base::StringPiece status,
+    base::StringPiece reply) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   bool result;
   if (*established == "1")
@@ -512,12 +523,49 @@ void TorControl::GetCircuitEstablishedDone(
   std::move(callback).Run(false, result);
 }
 
+// ExtendCircuit(callback)
+//
+//      Ask Tor to build a new circuit on a path of its choosing and call
+//      callback(error, circuit_id) once it has been launched.
+//
+void TorControl::ExtendCircuit(
+    base::OnceCallback<void(bool error, const std::string& circuit_id)>
+        callback) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(owner_sequence_checker_);
+  io_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&TorControl::DoCmd, weak_ptr_factory_.GetWeakPtr(),
+                     kExtendCircuitCmd, base::DoNothing(),
+                     base::BindOnce(&TorControl::ExtendCircuitDone,
+                                    weak_ptr_factory_.GetWeakPtr(),
+                                    std::move(callback))));
+}
+
+void TorControl::ExtendCircuitDone(
+    base::OnceCallback<void(bool error, const std::string& circuit_id)>
+        callback,
+    bool error,
+    base::StringPiece status,
+    base::StringPiece reply) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
+  if (error || status != "250" ||
+      !base::StartsWith(reply, kExtendCircuitReply,
+                        base::CompareCase::SENSITIVE) ||
+      reply.size() == strlen(kExtendCircuitReply)) {
+    std::move(callback).Run(true, "");
+    return;
+  }
+  std::move(callback).Run(
+      false, std::string(reply.substr(strlen(kExtendCircuitReply))));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Writing state machine
 
 // StartWrite()
 //
-//      Pick a write off the queue and start an I/O buffer for it.
+//      Take all queued commands off the queue and start an I/O buffer
+//      for them.
 //
 //      Caller must ensure writing_ is true.
 //
@@ -526,9 +574,9 @@ void TorControl::StartWrite() {
   DCHECK(writing_);
   DCHECK(!writeq_.empty());
   DCHECK(!cmdq_.empty());
-  auto buf = base::MakeRefCounted<net::StringIOBuffer>(writeq_.front());
+  auto buf = base::MakeRefCounted<net::StringIOBuffer>(std::move(writeq_));
   writeiobuf_ = base::MakeRefCounted<net::DrainableIOBuffer>(buf, buf->size());
-  writeq_.pop();
+  writeq_.clear();
 }
 
 // DoWrites()
@@ -709,11 +757,13 @@ void TorControl::ReadDone(int rv) {
     } else {
       // CR seen.  Accept LF; reject all else.
       if (data[i] == 0x0a) {  // LF
-        // CRLF seen, so we must have i >= 2.  Emit a line and advance
-        // to the next one, unless anything went wrong with the line.
-        assert(i >= 1);
-        std::string line(readiobuf_->StartOfBuffer() + read_start_,
-                         readiobuf_->offset() + i - 1 - read_start_);
+        // CRLF seen, so we must have i >= 2.  Emit the line in place
+        // and advance to the next one, unless anything went wrong
+        // with the line.
+        DCHECK_GE(readiobuf_->offset() + i, 1);
+        const base::StringPiece line(
+            readiobuf_->StartOfBuffer() + read_start_,
+            readiobuf_->offset() + i - 1 - read_start_);
         read_start_ = readiobuf_->offset() + i + 1;
         read_cr_ = false;
         if (!ReadLine(line)) {
@@ -729,25 +779,37 @@ void TorControl::ReadDone(int rv) {
     }
   }
 
-  // If we've walked up to the end of the buffer, try shifting it to
-  // the beginning to make room; if there's no more room, fail --
-  // lines shouldn't be this long.
   DCHECK(rv <= readiobuf_->RemainingCapacity());
-  if (readiobuf_->RemainingCapacity() == rv) {
+  const int end = readiobuf_->offset() + rv;
+  if (read_start_ == end) {
+    // Every line read so far has been processed, which is the usual
+    // case: start over at the beginning of the buffer.
+    readiobuf_->set_offset(0);
+    read_start_ = 0;
+  } else if (readiobuf_->RemainingCapacity() == rv) {
+    // We've walked up to the end of the buffer with a partial line.
+    // Shift it to the beginning to make room, or grow the buffer if
+    // the line already starts there; fail if it gets too large --
+    // lines shouldn't be this long.
     if (read_start_ == 0) {
-      // Line is too long.
-      VLOG(1) << "tor: control line too long";
-      Error();
-      return;
+      if (readiobuf_->capacity() >= kTorMaxBufferSize) {
+        VLOG(1) << "tor: control line too long";
+        Error();
+        return;
+      }
+      readiobuf_->SetCapacity(
+          std::min(readiobuf_->capacity() * 2, kTorMaxBufferSize));
+      readiobuf_->set_offset(end);
+    } else {
+      const int partial_line_size = end - read_start_;
+      memmove(readiobuf_->StartOfBuffer(),
+              readiobuf_->StartOfBuffer() + read_start_, partial_line_size);
+      readiobuf_->set_offset(partial_line_size);
+      read_start_ = 0;
     }
-    memmove(readiobuf_->StartOfBuffer(),
-            readiobuf_->StartOfBuffer() + read_start_,
-            readiobuf_->offset() - read_start_ + rv);
-    readiobuf_->set_offset(readiobuf_->offset() - read_start_ + rv);
-    read_start_ = 0;
   } else {
     // Otherwise, just advance the offset by the size of this input.
-    readiobuf_->set_offset(readiobuf_->offset() + rv);
+    readiobuf_->set_offset(end);
   }
   DCHECK(readiobuf_->RemainingCapacity());
 
@@ -769,7 +831,7 @@ void TorControl::ReadDone(int rv) {
 //      We have read a line of input; process it.  Return true on
 //      success, false on error.
 //
-bool TorControl::ReadLine(const std::string& line) {
+bool TorControl::ReadLine(base::StringPiece line) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
 
   if (line.size() < 4) {
@@ -784,9 +846,9 @@ bool TorControl::ReadLine(const std::string& line) {
   // intermediate reply and ` ' for a final reply.
   //
   // TODO(riastradh): parse or check syntax of status
-  std::string status(line, 0, 3);
+  const base::StringPiece status = line.substr(0, 3);
   char pos = line[3];
-  std::string reply(line, 4);
+  const base::StringPiece reply = line.substr(4);
 
   // Determine whether it is an asynchronous reply, status 6yz.
   if (status[0] == '6') {
@@ -797,8 +859,8 @@ bool TorControl::ReadLine(const std::string& line) {
     if (!async_) {
       // Parse the keyword and the initial line.
       const size_t sp = reply.find(' ');
-      std::string event_name, initial;
-      if (sp == std::string::npos) {
+      base::StringPiece event_name, initial;
+      if (sp == base::StringPiece::npos) {
         event_name = reply;
       } else {
         event_name = reply.substr(0, sp);
@@ -826,7 +888,7 @@ bool TorControl::ReadLine(const std::string& line) {
 
           // Notify the delegate of the parsed reply.  No extra
           // because there were no intermediate reply lines.
-          NotifyTorEvent(event, initial, {});
+          NotifyTorEvent(event, std::string(initial), {});
 
           return true;
         }
@@ -841,7 +903,7 @@ bool TorControl::ReadLine(const std::string& line) {
                                                      : (*found).second);
           async_ = std::make_unique<Async>();
           async_->event = event;
-          async_->initial = initial;
+          async_->initial = std::string(initial);
           async_->skip = (event == TorControlEvent::INVALID);
           return true;
         }
@@ -874,7 +936,7 @@ bool TorControl::ReadLine(const std::string& line) {
             Error();
             return false;
           }
-          async_->extra[key] = value;
+          async_->extra[key] = std::move(value);
           return true;
         }
         case ' ': {
@@ -892,7 +954,7 @@ bool TorControl::ReadLine(const std::string& line) {
               Error();
               return false;
             }
-            async_->extra[key] = value;
+            async_->extra[key] = std::move(value);
 
             // If we're still subscribed, notify the delegate of the
             // parsed reply.
@@ -1003,28 +1065,28 @@ void TorControl::NotifyTorRawCmd(const std::string& cmd) {
       FROM_HERE, base::BindOnce(&Delegate::OnTorRawCmd, delegate_, cmd));
 }
 
-void TorControl::NotifyTorRawAsync(const std::string& status,
-                                   const std::string& line) {
+void TorControl::NotifyTorRawAsync(base::StringPiece status,
+                                   base::StringPiece line) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   owner_task_runner_->PostTask(
-      FROM_HERE,
-      base::BindOnce(&Delegate::OnTorRawAsync, delegate_, status, line));
+      FROM_HERE, base::BindOnce(&Delegate::OnTorRawAsync, delegate_,
+                                std::string(status), std::string(line)));
 }
 
-void TorControl::NotifyTorRawMid(const std::string& status,
-                                 const std::string& line) {
+void TorControl::NotifyTorRawMid(base::StringPiece status,
+                                 base::StringPiece line) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   owner_task_runner_->PostTask(
-      FROM_HERE,
-      base::BindOnce(&Delegate::OnTorRawMid, delegate_, status, line));
+      FROM_HERE, base::BindOnce(&Delegate::OnTorRawMid, delegate_,
+                                std::string(status), std::string(line)));
 }
 
-void TorControl::NotifyTorRawEnd(const std::string& status,
-                                 const std::string& line) {
+void TorControl::NotifyTorRawEnd(base::StringPiece status,
+                                 base::StringPiece line) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   owner_task_runner_->PostTask(
-      FROM_HERE,
-      base::BindOnce(&Delegate::OnTorRawEnd, delegate_, status, line));
+      FROM_HERE, base::BindOnce(&Delegate::OnTorRawEnd, delegate_,
+                                std::string(status), std::string(line)));
 }
 
 // ParseKV(string, key, value)
@@ -1034,7 +1096,7 @@ void TorControl::NotifyTorRawEnd(const std::string& status,
 //      success, false on failure.
 //
 // static
-bool TorControl::ParseKV(const std::string& string,
+bool TorControl::ParseKV(const base::StringPiece string,
                          std::string* key,
                          std::string* value) {
   size_t end;
@@ -1049,20 +1111,20 @@ bool TorControl::ParseKV(const std::string& string,
 //      failure.
 //
 // static
-bool TorControl::ParseKV(const std::string& string,
+bool TorControl::ParseKV(const base::StringPiece string,
                          std::string* key,
                          std::string* value,
                          size_t* end) {
   DCHECK(key && value && end);
   // Search for `=' -- it had better be there.
-  size_t eq = string.find("=");
-  if (eq == std::string::npos)
+  size_t eq = string.find('=');
+  if (eq == base::StringPiece::npos)
     return false;
   size_t vstart = eq + 1;
 
   // If we're at the end of the string, value is empt.
   if (vstart == string.size()) {
-    *key = string.substr(0, eq);
+    *key = std::string(string.substr(0, eq));
     *value = "";
     *end = string.size();
     return true;
@@ -1072,7 +1134,7 @@ bool TorControl::ParseKV(const std::string& string,
   if (string[vstart] != '"') {
     // Not quoted.  Check for a delimiter.
     size_t i, vend = string.size();
-    if ((i = string.find(" ", vstart)) != std::string::npos) {
+    if ((i = string.find(' ', vstart)) != base::StringPiece::npos) {
       // Delimited.  Stop at the delimiter, and consume it.
       vend = i;
       *end = vend + 1;
@@ -1082,19 +1144,19 @@ bool TorControl::ParseKV(const std::string& string,
     }
 
     // Check for internal quotes; they are forbidden.
-    if ((i = string.find("\"", vstart)) != std::string::npos)
+    if ((i = string.find('"', vstart)) != base::StringPiece::npos)
       return false;
 
     // Extract the key and value and we're done.
-    *key = string.substr(0, eq);
-    *value = string.substr(vstart, vend - vstart);
+    *key = std::string(string.substr(0, eq));
+    *value = std::string(string.substr(vstart, vend - vstart));
     return true;
   }
 
   // Quoted string.  Parse it, and consume trailing spaces.
   if (!ParseQuoted(string.substr(eq + 1), value, end))
     return false;
-  *key = string.substr(0, eq);
+  *key = std::string(string.substr(0, eq));
   *end += eq + 1;
   while (*end < string.size() && string[*end] == ' ')
     (*end)++;
@@ -1109,7 +1171,7 @@ bool TorControl::ParseKV(const std::string& string,
 //      return false on failure.
 //
 // static
-bool TorControl::ParseQuoted(const std::string& string,
+bool TorControl::ParseQuoted(const base::StringPiece string,
                              std::string* value,
                              size_t* end) {
   enum {
@@ -1234,7 +1296,7 @@ bool TorControl::ParseQuoted(const std::string& string,
       case REJECT:
         return false;
       case ACCEPT:
-        *value = buf.substr(0, pos);
+        value->assign(buf, 0, pos);
         *end = i + 1;
         return true;
       default:
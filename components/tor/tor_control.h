@@ -18,6 +18,7 @@
 #include "base/callback.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/strings/string_piece.h"
 
 namespace base {
 class SequencedTaskRunner;
@@ -44,11 +45,13 @@ namespace tor {
 // sure callback will be ran on the dedicated thread.
 class TorControl {
  public:
+  // |status| and |reply| point into the read buffer and are only valid
+  // during the call.
   using PerLineCallback =
-      base::RepeatingCallback<void(const std::string& status,
-                                   const std::string& reply)>;
+      base::RepeatingCallback<void(base::StringPiece status,
+                                   base::StringPiece reply)>;
   using CmdCallback = base::OnceCallback<
-      void(bool error, const std::string& status, const std::string& reply)>;
+      void(bool error, base::StringPiece status, base::StringPiece reply)>;
 
   class Delegate : public base::SupportsWeakPtr<Delegate> {
    public:
@@ -92,6 +95,10 @@ class TorControl {
           callback);
   void GetCircuitEstablished(
       base::OnceCallback<void(bool error, bool established)> callback);
+  // Build a new general purpose circuit on a path picked by Tor.
+  void ExtendCircuit(
+      base::OnceCallback<void(bool error, const std::string& circuit_id)>
+          callback);
 
  protected:
   friend class TorControlTest;
@@ -99,15 +106,17 @@ class TorControl {
   FRIEND_TEST_ALL_PREFIXES(TorControlTest, ParseKV);
   FRIEND_TEST_ALL_PREFIXES(TorControlTest, ReadLine);
   FRIEND_TEST_ALL_PREFIXES(TorControlTest, GetCircuitEstablishedDone);
+  FRIEND_TEST_ALL_PREFIXES(TorControlTest, ExtendCircuitDone);
+  FRIEND_TEST_ALL_PREFIXES(TorControlTest, PipelinesCommandsOverControlPort);
 
-  static bool ParseKV(const std::string& string,
+  static bool ParseKV(const base::StringPiece string,
                       std::string* key,
                       std::string* value);
-  static bool ParseKV(const std::string& string,
+  static bool ParseKV(const base::StringPiece string,
                       std::string* key,
                       std::string* value,
                       size_t* end);
-  static bool ParseQuoted(const std::string& string,
+  static bool ParseQuoted(const base::StringPiece string,
                           std::string* value,
                           size_t* end);
 
@@ -116,54 +125,60 @@ class TorControl {
   void StopOnTaskRunner();
   void Connected(std::vector<uint8_t> cookie, int rv);
   void Authenticated(bool error,
-                     const std::string& status,
-                     const std::string& reply);
+                     base::StringPiece status,
+                     base::StringPiece reply);
 
   void DoCmd(std::string cmd, PerLineCallback perline, CmdCallback callback);
 
   void GetVersionLine(std::string* version,
-                      const std::string& status,
-                      const std::string& line);
+                      base::StringPiece status,
+                      base::StringPiece line);
   void GetVersionDone(
       std::unique_ptr<std::string> version,
       base::OnceCallback<void(bool error, const std::string& version)> callback,
       bool error,
-      const std::string& status,
-      const std::string& reply);
+      base::StringPiece status,
+      base::StringPiece reply);
   void GetSOCKSListenersLine(std::vector<std::string>* listeners,
-                             const std::string& status,
-                             const std::string& reply);
+                             base::StringPiece status,
+                             base::StringPiece reply);
   void GetSOCKSListenersDone(
       std::unique_ptr<std::vector<std::string>> listeners,
       base::OnceCallback<
           void(bool error, const std::vector<std::string>& listeners)> callback,
       bool error,
-      const std::string& status,
-      const std::string& reply);
+      base::StringPiece status,
+      base::StringPiece reply);
   void GetCircuitEstablishedLine(std::string* established,
-                                 const std::string& status,
-                                 const std::string& reply);
+                                 base::StringPiece status,
+                                 base::StringPiece reply);
   void GetCircuitEstablishedDone(
       std::unique_ptr<std::string> established,
       base::OnceCallback<void(bool error, bool established)> callback,
       bool error,
-      const std::string& status,
-      const std::string& reply);
+      base::StringPiece status,
+      base::StringPiece reply);
+  void ExtendCircuitDone(
+      base::OnceCallback<void(bool error, const std::string& circuit_id)>
+          callback,
+      bool error,
+      base::StringPiece status,
+      base::StringPiece reply);
 
   void DoSubscribe(TorControlEvent event,
                    base::OnceCallback<void(bool error)> callback);
   void Subscribed(TorControlEvent event,
                   base::OnceCallback<void(bool error)> callback,
                   bool error,
-                  const std::string& status,
-                  const std::string& reply);
+                  base::StringPiece status,
+                  base::StringPiece reply);
   void DoUnsubscribe(TorControlEvent event,
                      base::OnceCallback<void(bool error)> callback);
   void Unsubscribed(TorControlEvent event,
                     base::OnceCallback<void(bool error)> callback,
                     bool error,
-                    const std::string& status,
-                    const std::string& reply);
+                    base::StringPiece status,
+                    base::StringPiece reply);
   std::string SetEventsCmd();
 
   // Notify delegate on UI thread
@@ -174,9 +189,9 @@ class TorControl {
                       const std::string& initial,
                       const std::map<std::string, std::string>& extra);
   void NotifyTorRawCmd(const std::string& cmd);
-  void NotifyTorRawAsync(const std::string& status, const std::string& line);
-  void NotifyTorRawMid(const std::string& status, const std::string& line);
-  void NotifyTorRawEnd(const std::string& status, const std::string& line);
+  void NotifyTorRawAsync(base::StringPiece status, base::StringPiece line);
+  void NotifyTorRawMid(base::StringPiece status, base::StringPiece line);
+  void NotifyTorRawEnd(base::StringPiece status, base::StringPiece line);
 
   void StartWrite();
   void DoWrites();
@@ -187,7 +202,7 @@ class TorControl {
   void DoReads();
   void ReadDoneAsync(int rv);
   void ReadDone(int rv);
-  bool ReadLine(const std::string& line);
+  bool ReadLine(base::StringPiece line);
 
   void Error();
 
@@ -203,8 +218,10 @@ class TorControl {
 
   std::unique_ptr<net::TCPClientSocket> socket_;
 
-  // Write state machine.
-  std::queue<std::string> writeq_;
+  // Write state machine.  Commands are pipelined: every command issued
+  // while a write is in flight is appended to writeq_ and they all go
+  // out together in the next write, without waiting for replies.
+  std::string writeq_;
   bool writing_;
   scoped_refptr<net::DrainableIOBuffer> writeiobuf_;
 
@@ -5,16 +5,104 @@
 
 #include "brave/components/tor/tor_control.h"
 
+#include <algorithm>
+#include <memory>
+#include <string>
+
 #include "base/callback_helpers.h"
 #include "base/run_loop.h"
+#include "base/test/bind.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/test/browser_task_environment.h"
+#include "net/base/io_buffer.h"
+#include "net/base/ip_endpoint.h"
+#include "net/base/net_errors.h"
+#include "net/base/test_completion_callback.h"
+#include "net/socket/stream_socket.h"
+#include "net/socket/tcp_server_socket.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace tor {
 namespace {
+
+// Local stand-in for the Tor control port.
+class FakeTorControlServer {
+ public:
+  static constexpr int kBufferSize = 64 * 1024;
+
+  FakeTorControlServer() : server_socket_(nullptr, net::NetLogSource()) {}
+
+  int Listen() {
+    EXPECT_EQ(net::OK, server_socket_.Listen(
+                           net::IPEndPoint(net::IPAddress::IPv4Localhost(), 0),
+                           1));
+    net::IPEndPoint address;
+    EXPECT_EQ(net::OK, server_socket_.GetLocalAddress(&address));
+    return address.port();
+  }
+
+  void Accept() {
+    net::TestCompletionCallback callback;
+    EXPECT_EQ(net::OK, callback.GetResult(server_socket_.Accept(
+                           &socket_, callback.callback())));
+  }
+
+  // Accepts the connection and answers the commands TorControl sends when
+  // it starts with cookie BEEF.
+  void AcceptAndAuthenticate() {
+    Accept();
+    EXPECT_EQ("AUTHENTICATE BEEF\r\n", ReadLines(1));
+    Write("250 OK\r\n");
+    EXPECT_EQ("TAKEOWNERSHIP\r\nRESETCONF __OwningControllerProcess\r\n",
+              ReadLines(2));
+    Write("250 OK\r\n250 OK\r\n");
+  }
+
+  // Reads until |count| complete lines have arrived and returns them.
+  std::string ReadLines(size_t count) {
+    std::string data;
+    size_t lines = 0;
+    while (lines < count) {
+      auto buf = base::MakeRefCounted<net::IOBuffer>(kBufferSize);
+      net::TestCompletionCallback callback;
+      const int rv = callback.GetResult(
+          socket_->Read(buf.get(), kBufferSize, callback.callback()));
+      if (rv <= 0) {
+        ADD_FAILURE() << "read failed: " << rv;
+        break;
+      }
+      lines += std::count(buf->data(), buf->data() + rv, '\n');
+      data.append(buf->data(), rv);
+    }
+    return data;
+  }
+
+  void SetReceiveBufferSize(int32_t size) {
+    EXPECT_EQ(net::OK, socket_->SetReceiveBufferSize(size));
+  }
+
+  void Write(const std::string& data) {
+    auto buf = base::MakeRefCounted<net::DrainableIOBuffer>(
+        base::MakeRefCounted<net::StringIOBuffer>(data), data.size());
+    while (buf->BytesRemaining()) {
+      net::TestCompletionCallback callback;
+      const int rv = callback.GetResult(
+          socket_->Write(buf.get(), buf->BytesRemaining(), callback.callback(),
+                         TRAFFIC_ANNOTATION_FOR_TESTS));
+      ASSERT_GT(rv, 0);
+      buf->DidConsume(rv);
+    }
+  }
+
+ private:
+  net::TCPServerSocket server_socket_;
+  std::unique_ptr<net::StreamSocket> socket_;
+};
+
 class MockTorControlDelegate : public TorControl::Delegate {
  public:
   MOCK_METHOD0(OnTorControlReady, void());
@@ -300,4 +388,196 @@ TEST(TorControlTest, GetCircuitEstablishedDone) {
   base::RunLoop().RunUntilIdle();
 }
 
+TEST(TorControlTest, ExtendCircuitDone) {
+  content::BrowserTaskEnvironment task_environment;
+  scoped_refptr<base::SequencedTaskRunner> io_task_runner =
+      content::GetIOThreadTaskRunner({});
+
+  MockTorControlDelegate delegate;
+  std::unique_ptr<TorControl> control =
+      std::make_unique<TorControl>(delegate.AsWeakPtr(), io_task_runner);
+
+  io_task_runner->PostTask(
+      FROM_HERE,
+      base::BindOnce(
+          [](std::unique_ptr<TorControl> control) {
+            const struct {
+              bool error;
+              const char* status;
+              const char* reply;
+              const char* circuit_id;
+            } cases[] = {
+                {false, "250", "EXTENDED 12", "12"},
+                {false, "250", "EXTENDED ", nullptr},
+                {false, "250", "OK", nullptr},
+                {false, "551", "Couldn't start circuit", nullptr},
+                {true, "250", "EXTENDED 12", nullptr},
+            };
+            for (const auto& test_case : cases) {
+              bool is_called = false;
+              control->ExtendCircuitDone(
+                  base::BindLambdaForTesting(
+                      [&](bool error, const std::string& circuit_id) {
+                        is_called = true;
+                        EXPECT_EQ(error, !test_case.circuit_id);
+                        EXPECT_EQ(circuit_id, test_case.circuit_id
+                                                  ? test_case.circuit_id
+                                                  : "");
+                      }),
+                  test_case.error, test_case.status, test_case.reply);
+              EXPECT_TRUE(is_called) << test_case.reply;
+            }
+          },
+          std::move(control)));
+  base::RunLoop().RunUntilIdle();
+}
+
+TEST(TorControlTest, PipelinesCommandsOverControlPort) {
+  content::BrowserTaskEnvironment task_environment(
+      content::BrowserTaskEnvironment::IO_MAINLOOP);
+  scoped_refptr<base::SequencedTaskRunner> io_task_runner =
+      content::GetIOThreadTaskRunner({});
+
+  FakeTorControlServer server;
+  const int port = server.Listen();
+
+  testing::NiceMock<MockTorControlDelegate> delegate;
+  std::unique_ptr<TorControl> control =
+      std::make_unique<TorControl>(delegate.AsWeakPtr(), io_task_runner);
+  EXPECT_CALL(delegate, OnTorControlReady()).Times(1);
+  control->Start({0xbe, 0xef}, port);
+
+  server.AcceptAndAuthenticate();
+
+  // Stall the connection with a command that doesn't fit in the socket
+  // buffers, so that the commands below are issued while it is being written.
+  server.SetReceiveBufferSize(4096);
+  EXPECT_EQ(net::OK, control->socket_->SetSendBufferSize(4096));
+  const std::string filler_cmd = "GETINFO " + std::string(1024 * 1024, 'x');
+  bool filler_done = false;
+  control->DoCmd(filler_cmd, base::DoNothing(),
+                 base::BindLambdaForTesting([&](bool error,
+                                                base::StringPiece status,
+                                                base::StringPiece reply) {
+                   EXPECT_FALSE(error);
+                   EXPECT_EQ("552", status);
+                   filler_done = true;
+                 }));
+  ASSERT_TRUE(control->writing_);
+  ASSERT_TRUE(control->writeq_.empty());
+
+  base::RunLoop run_loop;
+  std::string version;
+  absl::optional<bool> established;
+  control->GetVersion(base::BindLambdaForTesting(
+      [&](bool error, const std::string& result) {
+        EXPECT_FALSE(error);
+        version = result;
+      }));
+  control->GetCircuitEstablished(
+      base::BindLambdaForTesting([&](bool error, bool result) {
+        EXPECT_FALSE(error);
+        EXPECT_FALSE(version.empty());
+        established = result;
+        run_loop.Quit();
+      }));
+
+  base::RunLoop().RunUntilIdle();
+  // Both commands are queued together for the next write.
+  EXPECT_EQ("GETINFO version\r\nGETINFO status/circuit-established\r\n",
+            control->writeq_);
+
+  // And both go out before any of the commands is answered.
+  EXPECT_EQ(filler_cmd +
+                "\r\nGETINFO version\r\nGETINFO status/circuit-established"
+                "\r\n",
+            server.ReadLines(3));
+
+  // Replies split mid-line and interleaved with an event that nobody
+  // subscribed to are matched up in order.
+  server.Write("552 Unrecognized key\r\n");
+  server.Write("250-version=0.4.6.7\r\n250 OK\r\n650 CIRC 1 BUI");
+  server.Write("LT\r\n250-status/circuit-established=1\r\n25");
+  server.Write("0 OK\r\n");
+  run_loop.Run();
+
+  EXPECT_TRUE(filler_done);
+  EXPECT_EQ("0.4.6.7", version);
+  EXPECT_TRUE(*established);
+
+  control->Stop();
+  base::RunLoop().RunUntilIdle();
+}
+
+TEST(TorControlTest, ReadsLinesLongerThanInitialBuffer) {
+  content::BrowserTaskEnvironment task_environment(
+      content::BrowserTaskEnvironment::IO_MAINLOOP);
+  scoped_refptr<base::SequencedTaskRunner> io_task_runner =
+      content::GetIOThreadTaskRunner({});
+
+  FakeTorControlServer server;
+  const int port = server.Listen();
+
+  testing::NiceMock<MockTorControlDelegate> delegate;
+  std::unique_ptr<TorControl> control =
+      std::make_unique<TorControl>(delegate.AsWeakPtr(), io_task_runner);
+  control->Start({0xbe, 0xef}, port);
+  server.AcceptAndAuthenticate();
+
+  base::RunLoop run_loop;
+  std::string version;
+  control->GetVersion(base::BindLambdaForTesting(
+      [&](bool error, const std::string& result) {
+        EXPECT_FALSE(error);
+        version = result;
+        run_loop.Quit();
+      }));
+  EXPECT_EQ("GETINFO version\r\n", server.ReadLines(1));
+
+  // Past the 4 KiB the read buffer starts with, preceded by a short line so
+  // that the long one doesn't start at the beginning of the buffer.
+  const std::string long_version(10 * 1024, '7');
+  server.Write("650 CIRC 1 BUILT\r\n250-version=" + long_version +
+               "\r\n250 OK\r\n");
+  run_loop.Run();
+  EXPECT_EQ(long_version, version);
+
+  control->Stop();
+  base::RunLoop().RunUntilIdle();
+}
+
+TEST(TorControlTest, ClosesOnLineLongerThanMaxBuffer) {
+  content::BrowserTaskEnvironment task_environment(
+      content::BrowserTaskEnvironment::IO_MAINLOOP);
+  scoped_refptr<base::SequencedTaskRunner> io_task_runner =
+      content::GetIOThreadTaskRunner({});
+
+  FakeTorControlServer server;
+  const int port = server.Listen();
+
+  testing::NiceMock<MockTorControlDelegate> delegate;
+  std::unique_ptr<TorControl> control =
+      std::make_unique<TorControl>(delegate.AsWeakPtr(), io_task_runner);
+  control->Start({0xbe, 0xef}, port);
+  server.AcceptAndAuthenticate();
+
+  base::RunLoop run_loop;
+  EXPECT_CALL(delegate, OnTorControlClosed(true)).Times(1);
+  control->GetVersion(base::BindLambdaForTesting(
+      [&](bool error, const std::string& result) {
+        EXPECT_TRUE(error);
+        run_loop.Quit();
+      }));
+  EXPECT_EQ("GETINFO version\r\n", server.ReadLines(1));
+
+  // A single line that doesn't fit in 64 KiB.
+  server.Write("250-version=" + std::string(64 * 1024, '7') + "\r\n");
+  run_loop.Run();
+  base::RunLoop().RunUntilIdle();
+  testing::Mock::VerifyAndClearExpectations(&delegate);
+
+  control->Stop();
+  base::RunLoop().RunUntilIdle();
+}
+
 }  // namespace tor
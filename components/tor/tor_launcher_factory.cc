@@ -40,6 +40,7 @@ TorLauncherFactory::TorLauncherFactory()
       control_(new tor::TorControl(this->AsWeakPtr(),
                                    content::GetIOThreadTaskRunner({})),
                base::OnTaskRunnerDeleter(content::GetIOThreadTaskRunner({}))),
+      circuit_pool_(this),
       weak_ptr_factory_(this) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 }
@@ -112,6 +113,7 @@ void TorLauncherFactory::KillTorProcess() {
   if (tor_launcher_.is_bound())
     tor_launcher_->Shutdown();
   control_->Stop();
+  circuit_pool_.Stop();
   tor_launcher_.reset();
   tor_pid_ = -1;
   is_starting_ = false;
@@ -216,6 +218,7 @@ void TorLauncherFactory::OnTorControlReady() {
   control_->Subscribe(tor::TorControlEvent::STATUS_CLIENT, base::DoNothing());
   control_->Subscribe(tor::TorControlEvent::STATUS_GENERAL, base::DoNothing());
   control_->Subscribe(tor::TorControlEvent::STREAM, base::DoNothing());
+  control_->Subscribe(tor::TorControlEvent::CIRC, base::DoNothing());
   control_->Subscribe(tor::TorControlEvent::NOTICE, base::DoNothing());
   control_->Subscribe(tor::TorControlEvent::WARN, base::DoNothing());
   control_->Subscribe(tor::TorControlEvent::ERR, base::DoNothing());
@@ -261,14 +264,30 @@ void TorLauncherFactory::GotCircuitEstablished(bool error, bool established) {
     VLOG(1) << "Failed to get circuit established!";
     return;
   }
+  SetCircuitEstablished(established);
+}
+
+void TorLauncherFactory::SetCircuitEstablished(bool established) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   is_connected_ = established;
   for (auto& observer : observers_)
     observer.OnTorCircuitEstablished(established);
+  // Circuits can only be built ahead once Tor has managed to build one.
+  if (established)
+    circuit_pool_.Start();
+}
+
+void TorLauncherFactory::BuildCircuit(
+    tor::TorCircuitPool::BuildCircuitCallback callback) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  control_->ExtendCircuit(base::BindPostTask(
+      base::SequencedTaskRunnerHandle::Get(), std::move(callback)));
 }
 
 void TorLauncherFactory::OnTorControlClosed(bool was_running) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   VLOG(2) << "TOR CONTROL: Closed!";
+  circuit_pool_.Stop();
   // We only try to reestablish tor control connection when tor control was
   // closed unexpectedly and Tor process is still running
   if (was_running && tor_launcher_.is_bound()) {
@@ -344,14 +363,16 @@ void TorLauncherFactory::OnTorEvent(
         observer.OnTorInitializing(percentage);
     } else if (initial.find(kStatusClientCircuitEstablished) !=
                std::string::npos) {
-      for (auto& observer : observers_)
-        observer.OnTorCircuitEstablished(true);
-      is_connected_ = true;
+      SetCircuitEstablished(true);
     } else if (initial.find(kStatusClientCircuitNotEstablished) !=
                std::string::npos) {
       for (auto& observer : observers_)
         observer.OnTorCircuitEstablished(false);
     }
+  } else if (event == tor::TorControlEvent::CIRC) {
+    circuit_pool_.OnCircuitEvent(initial);
+  } else if (event == tor::TorControlEvent::STREAM) {
+    circuit_pool_.OnStreamEvent(initial);
   } else if (event == tor::TorControlEvent::NOTICE ||
              event == tor::TorControlEvent::WARN ||
              event == tor::TorControlEvent::ERR) {
@@ -18,6 +18,7 @@
 #include "base/observer_list.h"
 #include "base/sequence_checker.h"
 #include "brave/components/services/tor/public/interfaces/tor.mojom.h"
+#include "brave/components/tor/tor_circuit_pool.h"
 #include "brave/components/tor/tor_control.h"
 #include "mojo/public/cpp/bindings/remote.h"
 
@@ -29,7 +30,8 @@ struct OnTaskRunnerDeleter;
 class MockTorLauncherFactory;
 class TorLauncherObserver;
 
-class TorLauncherFactory : public tor::TorControl::Delegate {
+class TorLauncherFactory : public tor::TorControl::Delegate,
+                           public tor::TorCircuitPool::Delegate {
  public:
   using GetLogCallback = base::OnceCallback<void(bool, const std::string&)>;
   static TorLauncherFactory* GetInstance();
@@ -58,6 +60,10 @@ class TorLauncherFactory : public tor::TorControl::Delegate {
   void OnTorRawMid(const std::string& status, const std::string& line) override;
   void OnTorRawEnd(const std::string& status, const std::string& line) override;
 
+  // tor::TorCircuitPool::Delegate
+  void BuildCircuit(
+      tor::TorCircuitPool::BuildCircuitCallback callback) override;
+
  private:
   friend struct base::DefaultSingletonTraits<TorLauncherFactory>;
   friend class MockTorLauncherFactory;
@@ -77,6 +83,7 @@ class TorLauncherFactory : public tor::TorControl::Delegate {
   void GotVersion(bool error, const std::string& version);
   void GotSOCKSListeners(bool error, const std::vector<std::string>& listeners);
   void GotCircuitEstablished(bool error, bool established);
+  void SetCircuitEstablished(bool established);
 
   void LaunchTorInternal();
   void RelaunchTor();
@@ -99,6 +106,7 @@ class TorLauncherFactory : public tor::TorControl::Delegate {
   base::ObserverList<TorLauncherObserver> observers_;
 
   std::unique_ptr<tor::TorControl, base::OnTaskRunnerDeleter> control_;
+  tor::TorCircuitPool circuit_pool_;
 
   SEQUENCE_CHECKER(sequence_checker_);
 
@@ -5,7 +5,6 @@
 
 #include "brave/components/weekly_storage/daily_storage.h"
 
-#include <numeric>
 #include <utility>
 
 #include "base/logging.h"
@@ -39,24 +38,22 @@ DailyStorage::~DailyStorage() = default;
 
 void DailyStorage::RecordValueNow(uint64_t delta) {
   daily_values_.push_front({clock_->Now(), delta});
+  sum_ += delta;
   Save();
 }
 
 uint64_t DailyStorage::GetLast24HourSum() const {
-  // We record only value for last N days.
-  return std::accumulate(daily_values_.begin(), daily_values_.end(), 0ull,
-                         [](const uint64_t acc, const DailyValue& item) {
-                           return acc + item.value;
-                         });
+  return sum_;
 }
 
 void DailyStorage::FilterToDay() {
-  if (daily_values_.empty()) {
-    return;
-  }
-  // Remove all values that aren't within the last 24 hours
+  // Remove all values that aren't within the last 24 hours. They are ordered,
+  // so the outdated ones are all at the back.
   base::Time min = clock_->Now() - base::TimeDelta::FromDays(1);
-  daily_values_.remove_if([min](DailyValue val) { return (val.time <= min); });
+  while (!daily_values_.empty() && daily_values_.back().time <= min) {
+    sum_ -= daily_values_.back().value;
+    daily_values_.pop_back();
+  }
 }
 
 void DailyStorage::Load() {
@@ -79,6 +76,7 @@ void DailyStorage::Load() {
       continue;
     }
     daily_values_.push_back({time, static_cast<uint64_t>(value->GetDouble())});
+    sum_ += daily_values_.back().value;
   }
 }
 
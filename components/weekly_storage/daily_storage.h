@@ -6,9 +6,9 @@
 #ifndef BRAVE_COMPONENTS_WEEKLY_STORAGE_DAILY_STORAGE_H_
 #define BRAVE_COMPONENTS_WEEKLY_STORAGE_DAILY_STORAGE_H_
 
-#include <list>
 #include <memory>
 
+#include "base/containers/circular_deque.h"
 #include "base/time/time.h"
 
 namespace base {
@@ -49,7 +49,10 @@ class DailyStorage {
   const char* pref_name_ = nullptr;
   std::unique_ptr<base::Clock> clock_;
 
-  std::list<DailyValue> daily_values_;
+  // Newest values first.
+  base::circular_deque<DailyValue> daily_values_;
+  // Sum of all values in |daily_values_|.
+  uint64_t sum_ = 0;
 };
 
 #endif  // BRAVE_COMPONENTS_WEEKLY_STORAGE_DAILY_STORAGE_H_
@@ -5,7 +5,7 @@
 
 #include "brave/components/weekly_storage/weekly_storage.h"
 
-#include <numeric>
+#include <algorithm>
 #include <utility>
 
 #include "base/time/clock.h"
@@ -14,10 +14,6 @@
 #include "components/prefs/pref_service.h"
 #include "components/prefs/scoped_user_pref_update.h"
 
-namespace {
-constexpr size_t kDaysInWeek = 7;
-}
-
 WeeklyStorage::WeeklyStorage(PrefService* prefs, const char* pref_name)
     : prefs_(prefs),
       pref_name_(pref_name),
@@ -37,20 +33,31 @@ WeeklyStorage::WeeklyStorage(PrefService* prefs,
   Load();
 }
 
-WeeklyStorage::~WeeklyStorage() = default;
+WeeklyStorage::~WeeklyStorage() {
+  Flush();
+}
 
 void WeeklyStorage::AddDelta(uint64_t delta) {
-  FilterToWeek();
-  daily_values_.front().value += delta;
+  const bool day_added = FilterToWeek();
+  if (!delta && !day_added) {
+    return;
+  }
+  GetDay(0).value += delta;
+  sum_ += delta;
   Save();
 }
 
 void WeeklyStorage::ReplaceTodaysValueIfGreater(uint64_t value) {
-  FilterToWeek();
-  DailyValue& today = daily_values_.front();
-  if (today.value < value) {
-    today.value = value;
+  const bool day_added = FilterToWeek();
+  DailyValue& today = GetDay(0);
+  if (today.value >= value) {
+    if (day_added) {
+      Save();
+    }
+    return;
   }
+  sum_ += value - today.value;
+  today.value = value;
   Save();
 }
 
@@ -58,93 +65,128 @@ uint64_t WeeklyStorage::GetWeeklySum() const {
   // We record only value for last N days.
   const base::Time n_days_ago =
       clock_->Now() - base::TimeDelta::FromDays(kDaysInWeek);
-  return std::accumulate(daily_values_.begin(), daily_values_.end(), 0ull,
-                         [n_days_ago](const uint64_t acc, const auto& u2) {
-                           uint64_t add = 0;
-                           // Check only last continious days.
-                           if (u2.day > n_days_ago) {
-                             add = u2.value;
-                           }
-                           return acc + add;
-                         });
+  // Days are ordered, so only the oldest ones may have to be left out.
+  uint64_t sum = sum_;
+  for (size_t i = days_count_; i > 0; --i) {
+    const DailyValue& day = GetDay(i - 1);
+    if (day.day > n_days_ago) {
+      break;
+    }
+    sum -= day.value;
+  }
+  return sum;
 }
 
 uint64_t WeeklyStorage::GetHighestValueInWeek() const {
   // We record only value for last N days.
   const base::Time n_days_ago =
       clock_->Now() - base::TimeDelta::FromDays(kDaysInWeek);
-  std::list<DailyValue> last_weeks_daily_values(daily_values_.size());
-  auto copied_it =
-      std::copy_if(daily_values_.begin(), daily_values_.end(),
-                   last_weeks_daily_values.begin(),
-                   [n_days_ago](auto i) { return i.day > n_days_ago; });
-  last_weeks_daily_values.resize(
-      std::distance(last_weeks_daily_values.begin(), copied_it));
-
-  auto highest_it = std::max_element(last_weeks_daily_values.begin(),
-                                     last_weeks_daily_values.end(),
-                                     [](const auto& left, const auto& right) {
-                                       return left.value < right.value;
-                                     });
-  if (highest_it == last_weeks_daily_values.end()) {
-    return 0;
+  uint64_t highest = 0;
+  for (size_t i = 0; i < days_count_; ++i) {
+    const DailyValue& day = GetDay(i);
+    if (day.day <= n_days_ago) {
+      break;
+    }
+    highest = std::max(highest, day.value);
   }
-  return highest_it->value;
+  return highest;
 }
 
 bool WeeklyStorage::IsOneWeekPassed() const {
   // TODO(iefremov): This is not true 100% (if the browser was launched once
   // per week just after installation, for example).
-  return daily_values_.size() == kDaysInWeek;
+  return days_count_ == kDaysInWeek;
+}
+
+void WeeklyStorage::Flush() {
+  if (save_pending_) {
+    WriteToPrefs();
+  }
+}
+
+WeeklyStorage::DailyValue& WeeklyStorage::GetDay(size_t days_ago) {
+  DCHECK_LT(days_ago, days_count_);
+  return daily_values_[(latest_day_ + kDaysInWeek - days_ago) % kDaysInWeek];
 }
 
-void WeeklyStorage::FilterToWeek() {
+const WeeklyStorage::DailyValue& WeeklyStorage::GetDay(size_t days_ago) const {
+  DCHECK_LT(days_ago, days_count_);
+  return daily_values_[(latest_day_ + kDaysInWeek - days_ago) % kDaysInWeek];
+}
+
+bool WeeklyStorage::FilterToWeek() {
   base::Time now_midnight = clock_->Now().LocalMidnight();
   base::Time last_saved_midnight;
 
-  if (!daily_values_.empty()) {
-    last_saved_midnight = daily_values_.front().day;
+  if (days_count_) {
+    last_saved_midnight = GetDay(0).day;
   }
 
-  if (now_midnight - last_saved_midnight > base::TimeDelta()) {
-    // Day changed. Since we consider only small incoming intervals, lets just
-    // save it with a new timestamp.
-    daily_values_.push_front({now_midnight, 0});
-    if (daily_values_.size() > kDaysInWeek) {
-      daily_values_.pop_back();
-    }
+  if (now_midnight - last_saved_midnight <= base::TimeDelta()) {
+    return false;
   }
+  // Day changed. Since we consider only small incoming intervals, lets just
+  // save it with a new timestamp. The oldest day gets overwritten once the
+  // week is full.
+  latest_day_ = (latest_day_ + 1) % kDaysInWeek;
+  if (days_count_ == kDaysInWeek) {
+    sum_ -= daily_values_[latest_day_].value;
+  } else {
+    days_count_++;
+  }
+  daily_values_[latest_day_] = {now_midnight, 0};
+  return true;
 }
 
 void WeeklyStorage::Load() {
-  DCHECK(daily_values_.empty());
+  DCHECK_EQ(days_count_, 0u);
   const base::ListValue* list = prefs_->GetList(pref_name_);
   if (!list) {
     return;
   }
+  // The list is stored newest first.
+  std::array<DailyValue, kDaysInWeek> loaded;
+  size_t loaded_count = 0;
   for (auto& it : list->GetList()) {
     const base::Value* day = it.FindKey("day");
     const base::Value* value = it.FindKey("value");
     if (!day || !value || !day->is_double() || !value->is_double()) {
       continue;
     }
-    if (daily_values_.size() == kDaysInWeek) {
+    if (loaded_count == kDaysInWeek) {
       break;
     }
-    daily_values_.push_back({base::Time::FromDoubleT(day->GetDouble()),
-                             static_cast<uint64_t>(value->GetDouble())});
+    loaded[loaded_count++] = {base::Time::FromDoubleT(day->GetDouble()),
+                              static_cast<uint64_t>(value->GetDouble())};
+  }
+  for (size_t i = loaded_count; i > 0; --i) {
+    daily_values_[i - 1] = loaded[loaded_count - i];
+    sum_ += daily_values_[i - 1].value;
   }
+  days_count_ = loaded_count;
+  latest_day_ = loaded_count ? loaded_count - 1 : kDaysInWeek - 1;
 }
 
 void WeeklyStorage::Save() {
-  DCHECK(!daily_values_.empty());
-  DCHECK_LE(daily_values_.size(), kDaysInWeek);
+  DCHECK_GT(days_count_, 0u);
+  DCHECK_LE(days_count_, kDaysInWeek);
+
+  save_pending_ = true;
+  if (!save_timer_.IsRunning()) {
+    save_timer_.Start(FROM_HERE, kSaveDelay, this,
+                      &WeeklyStorage::WriteToPrefs);
+  }
+}
+
+void WeeklyStorage::WriteToPrefs() {
+  save_timer_.Stop();
+  save_pending_ = false;
 
   ListPrefUpdate update(prefs_, pref_name_);
   base::ListValue* list = update.Get();
-  // TODO(iefremov): Optimize if needed.
   list->ClearList();
-  for (const auto& u : daily_values_) {
+  for (size_t i = 0; i < days_count_; ++i) {
+    const DailyValue& u = GetDay(i);
     base::DictionaryValue value;
     value.SetKey("day", base::Value(u.day.ToDoubleT()));
     value.SetDoubleKey("value", u.value);
@@ -6,10 +6,11 @@
 #ifndef BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
 #define BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
 
-#include <list>
+#include <array>
 #include <memory>
 
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 
 namespace base {
 class Clock;
@@ -22,8 +23,15 @@ class PrefService;
 // Requires |pref_name| to be already registered.
 // Feel free to improve and refactor it - templatize a stored value type,
 // change weekly interval or make a keyed service from it.
+// Updates are written to prefs at most every |kSaveDelay|, on |Flush|, and
+// when the storage is destroyed. Instances sharing a pref should not be alive
+// at the same time.
 class WeeklyStorage {
  public:
+  static constexpr size_t kDaysInWeek = 7;
+  static constexpr base::TimeDelta kSaveDelay =
+      base::TimeDelta::FromSeconds(10);
+
   WeeklyStorage(PrefService* prefs, const char* pref_name);
 
   // For tests.
@@ -40,21 +48,37 @@ class WeeklyStorage {
   uint64_t GetWeeklySum() const;
   uint64_t GetHighestValueInWeek() const;
   bool IsOneWeekPassed() const;
+  // Writes pending updates to prefs right away, e.g. on shutdown.
+  void Flush();
 
  private:
   struct DailyValue {
     base::Time day;
     uint64_t value = 0ull;
   };
-  void FilterToWeek();
+  // Returns the day |days_ago| active days before the latest one.
+  DailyValue& GetDay(size_t days_ago);
+  const DailyValue& GetDay(size_t days_ago) const;
+  // Starts a new day if needed, returns true if it did.
+  bool FilterToWeek();
   void Load();
   void Save();
+  void WriteToPrefs();
 
   PrefService* prefs_ = nullptr;
   const char* pref_name_ = nullptr;
   std::unique_ptr<base::Clock> clock_;
 
-  std::list<DailyValue> daily_values_;
+  // Ring buffer of the last |kDaysInWeek| days with values, newest at
+  // |latest_day_|.
+  std::array<DailyValue, kDaysInWeek> daily_values_;
+  size_t latest_day_ = kDaysInWeek - 1;
+  size_t days_count_ = 0;
+  // Sum of all values in |daily_values_|.
+  uint64_t sum_ = 0;
+
+  bool save_pending_ = false;
+  base::OneShotTimer save_timer_;
 };
 
 #endif  // BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
@@ -9,15 +9,19 @@
 #include <utility>
 
 #include "base/test/simple_test_clock.h"
+#include "base/test/task_environment.h"
 #include "base/time/time.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/testing_pref_service.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
+namespace {
+constexpr char kPrefName[] = "brave.weekly_test";
+}  // namespace
+
 class WeeklyStorageTest : public ::testing::Test {
  public:
   WeeklyStorageTest() : clock_(new base::SimpleTestClock) {
-    constexpr char kPrefName[] = "brave.weekly_test";
     pref_service_.registry()->RegisterListPref(kPrefName);
 
     state_ = std::make_unique<WeeklyStorage>(
@@ -26,6 +30,7 @@ class WeeklyStorageTest : public ::testing::Test {
   }
 
  protected:
+  base::test::TaskEnvironment task_environment_;
   base::SimpleTestClock* clock_;
   TestingPrefServiceSimple pref_service_;
   std::unique_ptr<WeeklyStorage> state_;
@@ -138,3 +143,48 @@ TEST_F(WeeklyStorageTest, GetsHighestValueInWeekFromReplacement) {
   // Sanity check disparate days were not replaced
   EXPECT_EQ(state_->GetWeeklySum(), high_value + low_value);
 }
+
+TEST_F(WeeklyStorageTest, ReloadsWrappedWeek) {
+  // Go around the week more than once.
+  for (uint64_t day = 1; day <= 10; day++) {
+    state_->AddDelta(day);
+    clock_->Advance(base::TimeDelta::FromDays(1));
+  }
+  clock_->Advance(-base::TimeDelta::FromDays(1));
+  EXPECT_TRUE(state_->IsOneWeekPassed());
+  EXPECT_EQ(state_->GetWeeklySum(), 4u + 5 + 6 + 7 + 8 + 9 + 10);
+  EXPECT_EQ(state_->GetHighestValueInWeek(), 10u);
+
+  auto clock = std::make_unique<base::SimpleTestClock>();
+  clock->SetNow(clock_->Now());
+  state_.reset();
+  WeeklyStorage reloaded(&pref_service_, kPrefName, std::move(clock));
+  EXPECT_TRUE(reloaded.IsOneWeekPassed());
+  EXPECT_EQ(reloaded.GetWeeklySum(), 4u + 5 + 6 + 7 + 8 + 9 + 10);
+  EXPECT_EQ(reloaded.GetHighestValueInWeek(), 10u);
+}
+
+TEST(WeeklyStorageDeferredSaveTest, BatchesWrites) {
+  base::test::TaskEnvironment task_environment(
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME);
+  TestingPrefServiceSimple pref_service;
+  pref_service.registry()->RegisterListPref(kPrefName);
+
+  auto storage = std::make_unique<WeeklyStorage>(&pref_service, kPrefName);
+  storage->AddDelta(10);
+  storage->AddDelta(20);
+  EXPECT_EQ(storage->GetWeeklySum(), 30u);
+  EXPECT_TRUE(pref_service.GetList(kPrefName)->GetList().empty());
+
+  task_environment.FastForwardBy(WeeklyStorage::kSaveDelay);
+  EXPECT_EQ(pref_service.GetList(kPrefName)->GetList().size(), 1u);
+  EXPECT_EQ(WeeklyStorage(&pref_service, kPrefName).GetWeeklySum(), 30u);
+
+  // Pending updates are written on Flush() and when the storage goes away.
+  storage->AddDelta(5);
+  storage->Flush();
+  EXPECT_EQ(WeeklyStorage(&pref_service, kPrefName).GetWeeklySum(), 35u);
+  storage->AddDelta(5);
+  storage.reset();
+  EXPECT_EQ(WeeklyStorage(&pref_service, kPrefName).GetWeeklySum(), 40u);
+}